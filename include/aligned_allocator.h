@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "export_def.h"
+
+namespace fcpp {
+	// Counters of the allocations made by all aligned_allocator instances
+	struct allocation_statistics
+	{
+		// How many buffers have been allocated in total
+		size_t allocations;
+
+		// How many of them have been advised to be backed by huge pages, as they were above the threshold
+		size_t huge_page_allocations;
+
+		// The bytes currently allocated
+		size_t live_bytes;
+
+		// The bytes currently allocated in buffers advised to be backed by huge pages
+		size_t huge_page_live_bytes;
+	};
+
+	// Returns the counters of the allocations made by all aligned_allocator instances
+	FunctionalCppExport allocation_statistics aligned_allocation_statistics();
+
+	// Returns how many bytes of the memory mappings overlapping [address, address + size) are currently
+	// backed by transparent huge pages, according to /proc/self/smaps. Always 0 on other platforms than Linux.
+	FunctionalCppExport size_t huge_page_backed_bytes(const void* address, size_t size);
+
+	namespace detail {
+		// The size of a transparent huge page on x86-64 and most ARM64 Linux configurations
+		inline size_t huge_page_size()
+		{
+			return size_t(2) << 20;
+		}
+
+		// Allocates `size` bytes aligned to `alignment` (a power of two), and advises the kernel to back
+		// buffers of at least `huge_page_threshold` bytes with huge pages (in which case they are aligned to
+		// the huge page size). Throws std::bad_alloc on failure.
+		FunctionalCppExport void* aligned_allocate(size_t size, size_t alignment, size_t huge_page_threshold);
+
+		FunctionalCppExport void aligned_deallocate(void* pointer, size_t size, size_t huge_page_threshold);
+	}
+
+	// An allocator whose buffers are aligned to `Alignment` bytes (a power of two, by default a cache line),
+	// e.g. for vectorized loops over the elements. Buffers of at least `HugePageThreshold` bytes are aligned
+	// to the huge page size and advised to be backed by transparent huge pages (madvise(MADV_HUGEPAGE) on
+	// Linux), which reduces the TLB misses of full scans over large vectors.
+	// Use it as the allocator of an fcpp::vector to select this policy per container.
+	//
+	// example:
+	//      fcpp::vector<float, fcpp::aligned_allocator<float>> samples(100000000, 0.0f);
+	//      const auto statistics = fcpp::aligned_allocation_statistics();
+	//      const auto backed = fcpp::huge_page_backed_bytes(&samples[0], samples.size() * sizeof(float));
+	//
+	// outcome:
+	//      &samples[0] -> aligned to 2MB
+	//      statistics.huge_page_allocations -> 1
+	//      backed -> up to 400MB, depending on the availability of huge pages
+	template <typename T, size_t Alignment = 64, size_t HugePageThreshold = (size_t(2) << 20)>
+	class aligned_allocator
+	{
+		static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "the alignment must be a power of two");
+
+	public:
+		typedef T value_type;
+		typedef size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef aligned_allocator<U, Alignment, HugePageThreshold> other;
+		};
+
+		aligned_allocator()
+		{
+		}
+
+		template <typename U>
+		aligned_allocator(const aligned_allocator<U, Alignment, HugePageThreshold>&)
+		{
+		}
+
+		T* allocate(size_t count)
+		{
+			if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+				throw std::bad_alloc();
+			}
+			const auto alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+			return static_cast<T*>(detail::aligned_allocate(count * sizeof(T), alignment, HugePageThreshold));
+		}
+
+		void deallocate(T* pointer, size_t count)
+		{
+			detail::aligned_deallocate(pointer, count * sizeof(T), HugePageThreshold);
+		}
+
+		template <typename U>
+		bool operator ==(const aligned_allocator<U, Alignment, HugePageThreshold>&) const
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator !=(const aligned_allocator<U, Alignment, HugePageThreshold>&) const
+		{
+			return false;
+		}
+	};
+}
@@ -0,0 +1,373 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "export_def.h"
+#include "vector.h"
+#include "set.h"
+
+namespace fcpp {
+	// Runs a task on some thread(s), e.g. a thread pool or the worker threads of an event loop.
+	// The `_async` algorithms of this header submit their work to an executor.
+	typedef std::function<void(std::function<void()>)> executor;
+
+	// Thrown (through the future) by an `_async` operation whose cancellation_token has been cancelled
+	class FunctionalCppExport operation_cancelled : public std::runtime_error
+	{
+	public:
+		operation_cancelled();
+	};
+
+	// A handle for requesting the cancellation of `_async` operations. Copies share the same state,
+	// so the caller keeps one copy and passes another one to the operation.
+	//
+	// The operations check the token before they start and periodically while they run
+	// (e.g. every few thousand elements), and finish with operation_cancelled when it is cancelled.
+	//
+	// example:
+	//      fcpp::cancellation_token token;
+	//      auto future = fcpp::sorted_async(numbers, std::less<int>(), token);
+	//      token.cancel();
+	//
+	// outcome:
+	//      future.get() -> throws fcpp::operation_cancelled, unless sorting finished before the cancellation
+	class FunctionalCppExport cancellation_token
+	{
+	public:
+		// Creates a token which is not cancelled
+		cancellation_token();
+
+		// Requests the cancellation of all operations using this token (or a copy of it)
+		void cancel() const;
+
+		// Returns true if cancel has been called on this token or a copy of it
+		bool is_cancelled() const;
+
+		// Throws operation_cancelled if the token is cancelled
+		void throw_if_cancelled() const;
+
+	private:
+		std::shared_ptr<std::atomic<bool>> m_cancelled;
+	};
+
+	// A fixed number of worker threads executing submitted tasks in submission order.
+	// The destructor waits for the submitted tasks to finish.
+	class FunctionalCppExport thread_pool
+	{
+	public:
+		// Creates a pool with the given number of threads, by default one per hardware thread
+		explicit thread_pool(size_t thread_count = 0);
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator =(const thread_pool&) = delete;
+
+		~thread_pool();
+
+		// Queues the task for execution on one of the worker threads, the task must not throw
+		void submit(std::function<void()> task);
+
+		// Returns an executor submitting its tasks to this pool, the pool must outlive it
+		executor as_executor();
+
+		// Returns the number of worker threads
+		size_t thread_count() const;
+
+	private:
+		std::vector<std::thread> m_threads;
+		std::deque<std::function<void()>> m_tasks;
+		std::mutex m_mutex;
+		std::condition_variable m_task_available;
+		bool m_stopping;
+
+		void work();
+	};
+
+	// The executor used by the `_async` operations when none is given: a thread pool owned by the library,
+	// with one thread per hardware thread, created on first use
+	FunctionalCppExport executor default_executor();
+
+	namespace detail {
+		// How many elements an `_async` operation processes between two cancellation checks
+		inline size_t cancellation_check_interval()
+		{
+			return 4096;
+		}
+
+		// Runs the operation through the executor and returns a future for its result.
+		// The operation receives the token, so that it can check it while it runs.
+		template <typename Result, typename Operation>
+		std::future<Result> run_async(const executor& run_on, const cancellation_token& token, Operation operation)
+		{
+			const auto promise = std::make_shared<std::promise<Result>>();
+			auto future = promise->get_future();
+			run_on([promise, token, operation]() {
+				try {
+					token.throw_if_cancelled();
+					promise->set_value(operation(token));
+				} catch (...) {
+					promise->set_exception(std::current_exception());
+				}
+			});
+			return future;
+		}
+	}
+
+	// Performs the functional `map` algorithm asynchronously on the executor (by default the library's
+	// thread pool) and returns a future for the result, so that the calling thread is not blocked.
+	// The token is checked every few thousand elements. The operation keeps its own copy of the elements
+	// (moved in when the source is an rvalue), so the source does not need to outlive the future.
+	// See also fcpp::vector::map for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<int> input_vector({ 1, 3, -5 });
+	//      auto future = fcpp::map_async<std::string>(input_vector, [](const auto& element) {
+	//      	return std::to_string(element);
+	//      });
+	//      // ... the calling thread continues
+	//      const auto output_vector = future.get();
+	//
+	// outcome:
+	//      output_vector -> fcpp::vector<std::string>({ "1", "3", "-5" })
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename T, typename TAllocator, typename Transform>
+#endif
+	std::future<vector<U>> map_async(vector<T, TAllocator> source,
+	                                 Transform transform,
+	                                 const cancellation_token& token = cancellation_token(),
+	                                 const executor& run_on = default_executor())
+	{
+		const auto elements = std::make_shared<const vector<T, TAllocator>>(std::move(source));
+		return detail::run_async<vector<U>>(run_on, token, [elements, transform](const cancellation_token& t) {
+			std::vector<U> transformed_vector;
+			transformed_vector.reserve(elements->size());
+			for (size_t i = 0; i < elements->size(); ++i) {
+				if (i % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				transformed_vector.push_back(transform((*elements)[i]));
+			}
+			return vector<U>(std::move(transformed_vector));
+		});
+	}
+
+	// Performs the functional `map` algorithm on the keys of a set asynchronously, see map_async for vectors.
+	// See also fcpp::set::map for more documentation.
+#ifdef CPP17_AVAILABLE
+	template <typename UKey, typename UCompare = std::less<UKey>, typename TKey, typename TCompare, typename Transform, typename = std::enable_if_t<
+		          std::is_invocable_r_v<UKey, Transform, TKey>>>
+#else
+	template <typename UKey, typename UCompare = std::less<UKey>, typename TKey, typename TCompare, typename Transform>
+#endif
+	std::future<set<UKey, UCompare>> map_async(set<TKey, TCompare> source,
+	                                           Transform transform,
+	                                           const cancellation_token& token = cancellation_token(),
+	                                           const executor& run_on = default_executor())
+	{
+		const auto keys = std::make_shared<const set<TKey, TCompare>>(std::move(source));
+		return detail::run_async<set<UKey, UCompare>>(run_on, token, [keys, transform](const cancellation_token& t) {
+			std::set<UKey, UCompare> transformed_set;
+			size_t index = 0;
+			for (const auto& key : *keys) {
+				if (index++ % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				transformed_set.insert(transform(key));
+			}
+			return set<UKey, UCompare>(std::move(transformed_set));
+		});
+	}
+
+	// Performs the functional `reduce` algorithm asynchronously on the executor and returns a future for the result.
+	// The token is checked every few thousand elements, and the source does not need to outlive the future.
+	// See also fcpp::vector::reduce for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<int> numbers({ 1, 2, 3, 4 });
+	//      auto future = fcpp::reduce_async(numbers, 0, [](const int& partial_sum, const int& number) {
+	//          return partial_sum + number;
+	//      });
+	//
+	// outcome:
+	//      future.get() -> 10
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename TAllocator, typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, T>>>
+#else
+	template <typename T, typename TAllocator, typename U, typename Reduce>
+#endif
+	std::future<U> reduce_async(vector<T, TAllocator> source,
+	                            const U& initial,
+	                            Reduce reduction,
+	                            const cancellation_token& token = cancellation_token(),
+	                            const executor& run_on = default_executor())
+	{
+		const auto elements = std::make_shared<const vector<T, TAllocator>>(std::move(source));
+		return detail::run_async<U>(run_on, token, [elements, initial, reduction](const cancellation_token& t) {
+			auto result = initial;
+			for (size_t i = 0; i < elements->size(); ++i) {
+				if (i % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				result = reduction(result, (*elements)[i]);
+			}
+			return result;
+		});
+	}
+
+	// Performs the functional `reduce` algorithm on the keys of a set asynchronously, see reduce_async for vectors.
+	// See also fcpp::set::reduce for more documentation.
+#ifdef CPP17_AVAILABLE
+	template <typename TKey, typename TCompare, typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TKey>>>
+#else
+	template <typename TKey, typename TCompare, typename U, typename Reduce>
+#endif
+	std::future<U> reduce_async(set<TKey, TCompare> source,
+	                            const U& initial,
+	                            Reduce reduction,
+	                            const cancellation_token& token = cancellation_token(),
+	                            const executor& run_on = default_executor())
+	{
+		const auto keys = std::make_shared<const set<TKey, TCompare>>(std::move(source));
+		return detail::run_async<U>(run_on, token, [keys, initial, reduction](const cancellation_token& t) {
+			auto result = initial;
+			size_t index = 0;
+			for (const auto& key : *keys) {
+				if (index++ % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				result = reduction(result, key);
+			}
+			return result;
+		});
+	}
+
+	// Performs the `filtered` algorithm asynchronously on the executor and returns a future for the result.
+	// The token is checked every few thousand elements, and the source does not need to outlive the future.
+	// See also fcpp::vector::filtered for more documentation.
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename TAllocator, typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+#else
+	template <typename T, typename TAllocator, typename Callable>
+#endif
+	std::future<vector<T, TAllocator>> filtered_async(vector<T, TAllocator> source,
+	                                                  Callable predicate_to_keep,
+	                                                  const cancellation_token& token = cancellation_token(),
+	                                                  const executor& run_on = default_executor())
+	{
+		const auto elements = std::make_shared<const vector<T, TAllocator>>(std::move(source));
+		return detail::run_async<vector<T, TAllocator>>(run_on, token, [elements, predicate_to_keep](const cancellation_token& t) {
+			std::vector<T, TAllocator> filtered_vector;
+			for (size_t i = 0; i < elements->size(); ++i) {
+				if (i % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				if (predicate_to_keep((*elements)[i])) {
+					filtered_vector.push_back((*elements)[i]);
+				}
+			}
+			return vector<T, TAllocator>(std::move(filtered_vector));
+		});
+	}
+
+	// Performs the `filtered` algorithm on the keys of a set asynchronously, see filtered_async for vectors.
+	// See also fcpp::set::filtered for more documentation.
+#ifdef CPP17_AVAILABLE
+	template <typename TKey, typename TCompare, typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+	template <typename TKey, typename TCompare, typename Filter>
+#endif
+	std::future<set<TKey, TCompare>> filtered_async(set<TKey, TCompare> source,
+	                                                Filter predicate_to_keep,
+	                                                const cancellation_token& token = cancellation_token(),
+	                                                const executor& run_on = default_executor())
+	{
+		const auto keys = std::make_shared<const set<TKey, TCompare>>(std::move(source));
+		return detail::run_async<set<TKey, TCompare>>(run_on, token, [keys, predicate_to_keep](const cancellation_token& t) {
+			std::set<TKey, TCompare> filtered_set(keys->key_comp());
+			size_t index = 0;
+			for (const auto& key : *keys) {
+				if (index++ % detail::cancellation_check_interval() == 0) {
+					t.throw_if_cancelled();
+				}
+				if (predicate_to_keep(key)) {
+					filtered_set.insert(filtered_set.end(), key);
+				}
+			}
+			return set<TKey, TCompare>(std::move(filtered_set));
+		});
+	}
+
+	// Performs the `sorted` algorithm asynchronously on the executor and returns a future for the result.
+	// The token is checked every few thousand comparisons, so that even a long sort stops soon
+	// after a cancellation. The operation sorts its own copy of the elements (moved in when the source
+	// is an rvalue), so the source does not need to outlive the future.
+	// See also fcpp::vector::sorted for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<int> numbers({ 3, 1, 9, -4 });
+	//      fcpp::cancellation_token token;
+	//      auto future = fcpp::sorted_async(numbers, std::less<int>(), token);
+	//
+	// outcome:
+	//      future.get() -> fcpp::vector<int>({ -4, 1, 3, 9 })
+	//      or, if token.cancel() was called before the sort finished, throws fcpp::operation_cancelled
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename TAllocator, typename Sortable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Sortable, T, T>>>
+#else
+	template <typename T, typename TAllocator, typename Sortable>
+#endif
+	std::future<vector<T, TAllocator>> sorted_async(vector<T, TAllocator> source,
+	                                                Sortable comparison_predicate,
+	                                                const cancellation_token& token = cancellation_token(),
+	                                                const executor& run_on = default_executor())
+	{
+		const auto elements = std::make_shared<vector<T, TAllocator>>(std::move(source));
+		return detail::run_async<vector<T, TAllocator>>(run_on, token, [elements, comparison_predicate](const cancellation_token& t) {
+			size_t comparisons = 0;
+			std::sort(elements->begin(),
+			          elements->end(),
+			          [&comparisons, &t, &comparison_predicate](const T& a, const T& b) {
+				          if (++comparisons % detail::cancellation_check_interval() == 0) {
+					          t.throw_if_cancelled();
+				          }
+				          return comparison_predicate(a, b);
+			          });
+			return std::move(*elements);
+		});
+	}
+}
@@ -0,0 +1,380 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "hashing.h"
+#include "set.h"
+
+namespace fcpp {
+	// A blocked Bloom filter, answering approximate membership queries without false negatives.
+	// All bits of a key lie in the same 512-bit block (one cache line), so that each query
+	// touches a single cache line, regardless of the number of hash functions.
+	//
+	// example:
+	//      fcpp::bloom_filter<std::string> filter(1000, 0.01);
+	//      filter.insert("Jake");
+	//
+	// outcome:
+	//      filter.might_contain("Jake") -> true
+	//      filter.might_contain("Bob") -> false (with a probability of 99%)
+	template <class TKey, class THash = std::hash<TKey>>
+	class bloom_filter
+	{
+	public:
+		// Creates a filter sized for `expected_count` keys, so that the false positive rate
+		// stays close to `false_positive_rate` until that many keys have been inserted
+		bloom_filter(size_t expected_count, double false_positive_rate, THash hash = THash())
+			: m_hash(std::move(hash)),
+			  m_expected_count(std::max<size_t>(expected_count, 1)),
+			  m_false_positive_rate(false_positive_rate),
+			  m_hash_count(0),
+			  m_block_count(0),
+			  m_count(0)
+		{
+			assert(false_positive_rate > 0.0 && false_positive_rate < 1.0);
+			const auto ln2 = std::log(2.0);
+			// blocking concentrates bits in a cache line, which costs ~10% more bits for the same rate
+			const auto bits_per_key = 1.1 * -std::log(false_positive_rate) / (ln2 * ln2);
+			const auto hash_count = static_cast<int>(std::lround(bits_per_key * ln2));
+			m_hash_count = static_cast<size_t>(std::min(16, std::max(1, hash_count)));
+			const auto total_bits = static_cast<size_t>(std::ceil(bits_per_key * static_cast<double>(m_expected_count)));
+			m_block_count = std::max<size_t>(1, (total_bits + block_bits - 1) / block_bits);
+			m_words.assign(m_block_count * words_per_block, 0);
+		}
+
+		// Adds a key to the filter (mutating)
+		bloom_filter& insert(const TKey& key)
+		{
+			const auto h = detail::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+			auto* block = &m_words[block_index(h) * words_per_block];
+			auto bit = static_cast<std::uint32_t>(h);
+			const auto delta = static_cast<std::uint32_t>(detail::mix_hash(h)) | 1u;
+			for (size_t i = 0; i < m_hash_count; ++i, bit += delta) {
+				const auto position = bit & (block_bits - 1);
+				block[position / 64] |= std::uint64_t(1) << (position % 64);
+			}
+			++m_count;
+			return *this;
+		}
+
+		// Returns false if the key has certainly not been inserted, and true if it may have been inserted
+		[[nodiscard]] bool might_contain(const TKey& key) const
+		{
+			const auto h = detail::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+			const auto* block = &m_words[block_index(h) * words_per_block];
+			auto bit = static_cast<std::uint32_t>(h);
+			const auto delta = static_cast<std::uint32_t>(detail::mix_hash(h)) | 1u;
+			for (size_t i = 0; i < m_hash_count; ++i, bit += delta) {
+				const auto position = bit & (block_bits - 1);
+				if ((block[position / 64] & (std::uint64_t(1) << (position % 64))) == 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Removes all keys from the filter (mutating)
+		bloom_filter& clear()
+		{
+			std::fill(m_words.begin(), m_words.end(), 0);
+			m_count = 0;
+			return *this;
+		}
+
+		// Returns how many keys have been inserted since the filter was created or cleared
+		[[nodiscard]] size_t size() const
+		{
+			return m_count;
+		}
+
+		// Returns the number of keys the filter has been sized for
+		[[nodiscard]] size_t expected_count() const
+		{
+			return m_expected_count;
+		}
+
+		// Returns the false positive rate the filter has been sized for
+		[[nodiscard]] double false_positive_rate() const
+		{
+			return m_false_positive_rate;
+		}
+
+		// Returns the number of bits set per key
+		[[nodiscard]] size_t hash_count() const
+		{
+			return m_hash_count;
+		}
+
+		// Returns the total number of bits of the filter
+		[[nodiscard]] size_t bit_count() const
+		{
+			return m_block_count * block_bits;
+		}
+
+		[[nodiscard]] const THash& hash_function() const
+		{
+			return m_hash;
+		}
+
+	private:
+		static const size_t block_bits = 512;
+		static const size_t words_per_block = block_bits / 64;
+
+		THash m_hash;
+		size_t m_expected_count;
+		double m_false_positive_rate;
+		size_t m_hash_count;
+		size_t m_block_count;
+		size_t m_count;
+		std::vector<std::uint64_t> m_words;
+
+		size_t block_index(std::uint64_t h) const
+		{
+			return detail::reduce_range(static_cast<std::uint32_t>(h >> 32), m_block_count);
+		}
+	};
+
+	// Statistics about the queries answered by a fcpp::bloom_set
+	struct bloom_filter_stats
+	{
+		// Total number of `contains` queries
+		size_t queries;
+
+		// Queries answered negatively by the filter alone, without touching the set
+		size_t filtered_out;
+
+		// Queries which passed the filter, but whose key was not in the set
+		size_t false_positives;
+
+		// The observed false positive rate, i.e. the fraction of absent keys which passed the filter
+		[[nodiscard]] double observed_false_positive_rate() const
+		{
+			const auto negatives = filtered_out + false_positives;
+			return negatives == 0
+				       ? 0.0
+				       : static_cast<double>(false_positives) / static_cast<double>(negatives);
+		}
+	};
+
+	// A fcpp::set with an attached blocked Bloom filter, which answers most negative `contains`
+	// queries without descending the tree. The filter is maintained on insert, grows together with
+	// the set, and is rebuilt after many removals (removed keys cannot be cleared from a Bloom filter,
+	// so they would otherwise keep raising the false positive rate).
+	//
+	// example:
+	//      fcpp::bloom_set<int> numbers(0.01);
+	//      numbers.insert(1).insert(4).insert(2);
+	//
+	//      // answered by the filter alone (most of the time)
+	//      numbers.contains(15);
+	//
+	//      // the keys as a regular fcpp::set, for the functional API
+	//      numbers.as_set().map<std::string>(...)
+	template <class TKey, class TCompare = std::less<TKey>, class THash = std::hash<TKey>>
+	class bloom_set
+	{
+	public:
+		explicit bloom_set(double false_positive_rate = 0.01, size_t expected_count = 1024)
+			: m_set(),
+			  m_filter(expected_count, false_positive_rate),
+			  m_minimum_expected_count(expected_count),
+			  m_removed_since_rebuild(0),
+			  m_stats()
+		{
+		}
+
+		explicit bloom_set(const set<TKey, TCompare>& keys, double false_positive_rate = 0.01)
+			: m_set(keys),
+			  m_filter(std::max<size_t>(keys.size(), 1024), false_positive_rate),
+			  m_minimum_expected_count(1024),
+			  m_removed_since_rebuild(0),
+			  m_stats()
+		{
+			fill_filter();
+		}
+
+		// Inserts a key in the set and in the filter (mutating).
+		// When the set outgrows the size the filter was created for, the filter is rebuilt with double capacity.
+		bloom_set& insert(const TKey& key)
+		{
+			const auto previous_size = m_set.size();
+			m_set.insert(key);
+			if (m_set.size() == previous_size) {
+				return *this;
+			}
+			if (m_set.size() > m_filter.expected_count()) {
+				return rebuild_filter();
+			}
+			m_filter.insert(key);
+			return *this;
+		}
+
+		// Removes a key from the set, if it exists (mutating).
+		// Once more keys have been removed than half the set's size, the filter is rebuilt.
+		bloom_set& remove(const TKey& key)
+		{
+			const auto previous_size = m_set.size();
+			m_set.remove(key);
+			if (m_set.size() == previous_size) {
+				return *this;
+			}
+			++m_removed_since_rebuild;
+			if (m_removed_since_rebuild > m_set.size() / 2 && m_removed_since_rebuild >= minimum_removals_for_rebuild) {
+				return rebuild_filter();
+			}
+			return *this;
+		}
+
+		// Returns true if the key is present in the set, otherwise false.
+		// Keys rejected by the filter are answered without touching the set.
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			m_stats.queries.fetch_add(1, std::memory_order_relaxed);
+			if (!m_filter.might_contain(key)) {
+				m_stats.filtered_out.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			const auto found = m_set.contains(key);
+			if (!found) {
+				m_stats.false_positives.fetch_add(1, std::memory_order_relaxed);
+			}
+			return found;
+		}
+
+		// Removes all keys from the set and the filter (mutating)
+		bloom_set& clear()
+		{
+			m_set.clear();
+			m_filter.clear();
+			m_removed_since_rebuild = 0;
+			return *this;
+		}
+
+		// Rebuilds the filter from the current keys, dropping bits of previously removed keys (mutating)
+		bloom_set& rebuild_filter()
+		{
+			const auto expected_count = std::max(m_minimum_expected_count, 2 * m_set.size());
+			m_filter = bloom_filter<TKey, THash>(expected_count, m_filter.false_positive_rate(), m_filter.hash_function());
+			fill_filter();
+			return *this;
+		}
+
+		// Returns the query statistics gathered since creation or the last call to reset_stats
+		[[nodiscard]] bloom_filter_stats stats() const
+		{
+			bloom_filter_stats stats;
+			stats.queries = m_stats.queries.load(std::memory_order_relaxed);
+			stats.filtered_out = m_stats.filtered_out.load(std::memory_order_relaxed);
+			stats.false_positives = m_stats.false_positives.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		bloom_set& reset_stats()
+		{
+			m_stats.reset();
+			return *this;
+		}
+
+		// Returns the keys as a regular fcpp::set, enabling its functional API
+		[[nodiscard]] const set<TKey, TCompare>& as_set() const
+		{
+			return m_set;
+		}
+
+		// Returns the attached filter
+		[[nodiscard]] const bloom_filter<TKey, THash>& filter() const
+		{
+			return m_filter;
+		}
+
+		// Returns the size of the set (how many keys it contains)
+		[[nodiscard]] size_t size() const
+		{
+			return m_set.size();
+		}
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_set.is_empty();
+		}
+
+	private:
+		static const size_t minimum_removals_for_rebuild = 64;
+
+		struct stats_counters
+		{
+			stats_counters()
+				: queries(0), filtered_out(0), false_positives(0)
+			{
+			}
+
+			stats_counters(const stats_counters& other)
+				: queries(other.queries.load()),
+				  filtered_out(other.filtered_out.load()),
+				  false_positives(other.false_positives.load())
+			{
+			}
+
+			stats_counters& operator=(const stats_counters& other)
+			{
+				queries.store(other.queries.load());
+				filtered_out.store(other.filtered_out.load());
+				false_positives.store(other.false_positives.load());
+				return *this;
+			}
+
+			void reset()
+			{
+				queries.store(0);
+				filtered_out.store(0);
+				false_positives.store(0);
+			}
+
+			std::atomic<size_t> queries;
+			std::atomic<size_t> filtered_out;
+			std::atomic<size_t> false_positives;
+		};
+
+		set<TKey, TCompare> m_set;
+		bloom_filter<TKey, THash> m_filter;
+		size_t m_minimum_expected_count;
+		size_t m_removed_since_rebuild;
+		mutable stats_counters m_stats;
+
+		void fill_filter()
+		{
+			m_set.for_each([this](const TKey& key) {
+				m_filter.insert(key);
+			});
+			m_removed_since_rebuild = 0;
+		}
+	};
+}
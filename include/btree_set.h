@@ -0,0 +1,1199 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <set>
+#include <utility>
+#include <vector>
+#include "optional.h"
+#include "set.h"
+#include "vector.h"
+
+namespace fcpp {
+	// An ordered set backed by a B-tree, for large sets with heavy insert/remove traffic.
+	// Each node stores its keys contiguously in a block of a few cache lines (up to 63 keys of type int),
+	// so a lookup touches O(log n) blocks instead of one heap node per key as std::set does, and an
+	// ordered traversal reads the keys sequentially. The memory overhead is one parent pointer and
+	// a key count per node, plus the child pointers of the internal nodes.
+	//
+	// The API matches fcpp::set (ordered iteration, set algebra, min/max and the functional algorithms).
+	// Inserting or removing a key invalidates all iterators, since keys move between nodes.
+	//
+	// example:
+	//      fcpp::btree_set<int> numbers({1, 4, 2});
+	//      numbers.insert(18).remove(4);
+	//
+	// outcome:
+	//      numbers -> fcpp::btree_set<int>({1, 2, 18})
+	template <class TKey, class TCompare = std::less<TKey>>
+	class btree_set
+	{
+		// the keys of a node should fill roughly four cache lines
+		static const size_t node_bytes = 256;
+		// minimum degree t of the B-tree: every node except the root has between t - 1 and 2t - 1 keys
+		static const size_t min_degree = sizeof(TKey) * 6 <= node_bytes ? node_bytes / sizeof(TKey) / 2 : 3;
+		static const size_t max_keys = 2 * min_degree - 1;
+
+		struct internal_node;
+
+		struct node
+		{
+			internal_node* parent;
+			std::uint16_t count;
+			bool is_leaf;
+			alignas(TKey) unsigned char storage[sizeof(TKey) * max_keys];
+
+			explicit node(bool leaf)
+				: parent(nullptr), count(0), is_leaf(leaf)
+			{
+			}
+
+			TKey* keys()
+			{
+				return reinterpret_cast<TKey*>(storage);
+			}
+
+			const TKey* keys() const
+			{
+				return reinterpret_cast<const TKey*>(storage);
+			}
+
+			TKey& key(size_t index)
+			{
+				return keys()[index];
+			}
+
+			const TKey& key(size_t index) const
+			{
+				return keys()[index];
+			}
+		};
+
+		struct internal_node : node
+		{
+			node* children[max_keys + 1];
+
+			internal_node()
+				: node(false)
+			{
+			}
+		};
+
+	public:
+		// A bidirectional iterator over the keys of the set, in ascending order
+		class const_iterator
+		{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef TKey value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TKey* pointer;
+			typedef const TKey& reference;
+
+			const_iterator()
+				: m_tree(nullptr), m_node(nullptr), m_index(0)
+			{
+			}
+
+			reference operator*() const
+			{
+				return m_node->key(m_index);
+			}
+
+			pointer operator->() const
+			{
+				return &m_node->key(m_index);
+			}
+
+			const_iterator& operator++()
+			{
+				if (!m_node->is_leaf) {
+					// the successor is the leftmost key of the right subtree
+					m_node = leftmost_leaf(static_cast<const internal_node*>(m_node)->children[m_index + 1]);
+					m_index = 0;
+					return *this;
+				}
+				++m_index;
+				while (m_node != nullptr && m_index == m_node->count) {
+					// climb until the subtree we come from has a key on its right
+					const auto child = m_node;
+					m_node = m_node->parent;
+					m_index = m_node != nullptr ? child_position(m_node, child) : 0;
+				}
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator copy(*this);
+				++(*this);
+				return copy;
+			}
+
+			const_iterator& operator--()
+			{
+				if (m_node == nullptr) {
+					m_node = rightmost_leaf(m_tree->m_root);
+					m_index = m_node->count - 1;
+					return *this;
+				}
+				if (!m_node->is_leaf) {
+					// the predecessor is the rightmost key of the left subtree
+					m_node = rightmost_leaf(static_cast<const internal_node*>(m_node)->children[m_index]);
+					m_index = m_node->count - 1;
+					return *this;
+				}
+				while (m_index == 0) {
+					const auto child = m_node;
+					m_node = m_node->parent;
+					m_index = child_position(m_node, child);
+				}
+				--m_index;
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator copy(*this);
+				--(*this);
+				return copy;
+			}
+
+			bool operator ==(const const_iterator& rhs) const
+			{
+				return m_node == rhs.m_node && m_index == rhs.m_index;
+			}
+
+			bool operator !=(const const_iterator& rhs) const
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+			friend class btree_set;
+
+			const btree_set* m_tree;
+			const node* m_node;
+			size_t m_index;
+
+			const_iterator(const btree_set* tree, const node* n, size_t index)
+				: m_tree(tree), m_node(n), m_index(index)
+			{
+			}
+		};
+
+		btree_set()
+			: m_root(nullptr), m_size(0), m_compare()
+		{
+		}
+
+		explicit btree_set(const std::set<TKey, TCompare>& set)
+			: m_root(nullptr), m_size(0), m_compare(set.key_comp())
+		{
+			build_sorted(set.begin(), set.end());
+		}
+
+		explicit btree_set(const fcpp::set<TKey, TCompare>& set)
+			: m_root(nullptr), m_size(0), m_compare(set.key_comp())
+		{
+			build_sorted(set.begin(), set.end());
+		}
+
+		explicit btree_set(const std::vector<TKey>& vector)
+			: m_root(nullptr), m_size(0), m_compare()
+		{
+			build_unsorted(std::vector<TKey>(vector));
+		}
+
+		explicit btree_set(const vector<TKey>& vector)
+			: m_root(nullptr), m_size(0), m_compare()
+		{
+			build_unsorted(std::vector<TKey>(vector.begin(), vector.end()));
+		}
+
+		explicit btree_set(const std::initializer_list<TKey>& list)
+			: m_root(nullptr), m_size(0), m_compare()
+		{
+			build_unsorted(std::vector<TKey>(list.begin(), list.end()));
+		}
+
+		btree_set(const btree_set& other)
+			: m_root(nullptr), m_size(0), m_compare(other.m_compare)
+		{
+			build_sorted(other.begin(), other.end());
+		}
+
+		btree_set(btree_set&& other) noexcept
+			: m_root(other.m_root), m_size(other.m_size), m_compare(std::move(other.m_compare))
+		{
+			other.m_root = nullptr;
+			other.m_size = 0;
+		}
+
+		btree_set& operator=(btree_set other)
+		{
+			std::swap(m_root, other.m_root);
+			std::swap(m_size, other.m_size);
+			std::swap(m_compare, other.m_compare);
+			return *this;
+		}
+
+		~btree_set()
+		{
+			destroy_subtree(m_root);
+		}
+
+		// Returns the set of elements which belong to the current set but not in the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the difference is the operation A – B = {x : x ∈ A and x ∉ B}
+		//
+		// example:
+		//      const fcpp::btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::btree_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& diff = set1.difference_with(set2);
+		//
+		// outcome:
+		//      diff -> fcpp::btree_set<int>({1, 3, 8})
+		[[nodiscard]] btree_set difference_with(const btree_set& other) const
+		{
+			return difference_with_range(other.begin(), other.end());
+		}
+
+		[[nodiscard]] btree_set difference_with(const std::set<TKey, TCompare>& other) const
+		{
+			return difference_with_range(other.begin(), other.end());
+		}
+
+		// Returns the set of elements which belong either to the current or the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the union is the operation A ∪ B = {x : x ∈ A or x ∈ B}
+		//
+		// example:
+		//      const fcpp::btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::btree_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& combined = set1.union_with(set2);
+		//
+		// outcome:
+		//      combined -> fcpp::btree_set<int>({1, 2, 3, 5, 7, 8, 10, 15, 17})
+		[[nodiscard]] btree_set union_with(const btree_set& other) const
+		{
+			return union_with_range(other.begin(), other.end());
+		}
+
+		[[nodiscard]] btree_set union_with(const std::set<TKey, TCompare>& other) const
+		{
+			return union_with_range(other.begin(), other.end());
+		}
+
+		// Returns the set of elements which belong to both the current and the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the intersection is the operation A ∩ B = {x : x ∈ A and x ∈ B}
+		//
+		// example:
+		//      const fcpp::btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::btree_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& intersection = set1.intersect_with(set2);
+		//
+		// outcome:
+		//      intersection -> fcpp::btree_set<int>({2, 5, 7, 10})
+		[[nodiscard]] btree_set intersect_with(const btree_set& other) const
+		{
+			return intersect_with_range(other.begin(), other.end());
+		}
+
+		[[nodiscard]] btree_set intersect_with(const std::set<TKey, TCompare>& other) const
+		{
+			return intersect_with_range(other.begin(), other.end());
+		}
+
+		// Returns the minimum key in the set, if it's not empty. Performance is O(log n).
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+		//      auto minimum = numbers.min();
+		//
+		// outcome:
+		//      minimum.has_value() -> true
+		//      minimum.value() -> 1
+		[[nodiscard]] fcpp::optional_t<TKey> min() const
+		{
+			if (m_root == nullptr) {
+				return fcpp::optional_t<TKey>();
+			}
+			return leftmost_leaf(m_root)->key(0);
+		}
+
+		// Returns the maximum key in the set, if it's not empty. Performance is O(log n).
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+		//      auto maximum = numbers.max();
+		//
+		// outcome:
+		//      maximum.has_value() -> true
+		//      maximum.value() -> 8
+		[[nodiscard]] fcpp::optional_t<TKey> max() const
+		{
+			if (m_root == nullptr) {
+				return fcpp::optional_t<TKey>();
+			}
+			const auto leaf = rightmost_leaf(m_root);
+			return leaf->key(leaf->count - 1);
+		}
+
+		// Performs the functional `map` algorithm, in which every element of the resulting set is the
+		// output of applying the transform function on every element of this instance.
+		//
+		// example:
+		//      const fcpp::btree_set<int> input_set({ 1, 3, -5 });
+		//      const auto output_set = input_set.map<std::string>([](const int& element) {
+		//          return std::to_string(element);
+		//      });
+		//
+		// outcome:
+		//      output_set -> fcpp::btree_set<std::string>({ "-5", "1", "3" })
+#ifdef CPP17_AVAILABLE
+		template <class UKey, class UCompare = std::less<UKey>, typename Transform, typename = std::enable_if_t<
+			          std::is_invocable_r_v<UKey, Transform, TKey>>>
+#else
+		template <typename UKey, class UCompare = std::less<UKey>, typename Transform>
+#endif
+		btree_set<UKey, UCompare> map(Transform&& transform) const
+		{
+			std::vector<UKey> transformed;
+			transformed.reserve(m_size);
+			for (const auto& key : *this) {
+				transformed.push_back(transform(key));
+			}
+			return btree_set<UKey, UCompare>(transformed);
+		}
+
+		// Returns true if all keys match the predicate (return true)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.all_of([](const int &number) {
+		//          return number < 10;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool all_of(Callable&& unary_predicate) const
+		{
+			return std::all_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if at least one key match the predicate (returns true)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.any_of([](const int &number) {
+		//          return number < 5;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool any_of(Callable&& unary_predicate) const
+		{
+			return std::any_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if none of the keys match the predicate (all return false)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.none_of([](const int &number) {
+		//          return number > 10;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool none_of(Callable&& unary_predicate) const
+		{
+			return std::none_of(begin(),
+			                    end(),
+			                    std::forward<Callable>(unary_predicate));
+		}
+
+		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
+		// accumulating all the keys of the set to an initial value, in ascending order. (non-mutating)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2});
+		//      const auto sum = numbers.reduce(0, [](const int& partial, const int& number) {
+		//          return partial + number;
+		//      });
+		//
+		// outcome:
+		//      sum -> 7
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TKey>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (const auto& key : *this) {
+				result = reduction(result, key);
+			}
+			return result;
+		}
+
+		// Performs the functional `filter` algorithm, in which all keys of this instance
+		// which match the given predicate are kept (mutating)
+		//
+		// example:
+		//      fcpp::btree_set<int> numbers({ 1, 3, -5, 2, -1, 9, -4 });
+		//      numbers.filter([](const int& element) {
+		//          return element >= 1.5;
+		//      });
+		//
+		// outcome:
+		//      numbers -> fcpp::btree_set<int>({ 2, 3, 9 });
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		btree_set& filter(Filter&& predicate_to_keep)
+		{
+			*this = filtered(std::forward<Filter>(predicate_to_keep));
+			return *this;
+		}
+
+		// Performs the functional `filter` algorithm in a copy of this instance, in which all keys
+		// of the copy which match the given predicate are kept (non-mutating)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({ 1, 3, -5, 2, -1, 9, -4 });
+		//      auto filtered_numbers = numbers.filtered([](const int& element) {
+		//          return element >= 1.5;
+		//      });
+		//
+		// outcome:
+		//      filtered_numbers -> fcpp::btree_set<int>({ 2, 3, 9 });
+		//      numbers -> fcpp::btree_set<int>({ 1, 3, -5, 2, -1, 9, -4 });
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		btree_set filtered(Filter&& predicate_to_keep) const
+		{
+			std::vector<TKey> kept;
+			for (const auto& key : *this) {
+				if (predicate_to_keep(key)) {
+					kept.push_back(key);
+				}
+			}
+			return from_sorted(kept, m_compare);
+		}
+
+		// Performs the functional `zip` algorithm, in which every key of the resulting set is a
+		// tuple of this instance's key (first) and the second set's key (second).
+		// The sizes of the two sets must be equal.
+		//
+		// example:
+		//      const fcpp::btree_set<int> ages({ 25, 45, 30, 63 });
+		//      const fcpp::btree_set<std::string> persons({ "Jake", "Bob", "Michael", "Philipp" });
+		//      const auto zipped = ages.zip(persons);
+		//
+		// outcome:
+		//      zipped -> fcpp::btree_set<std::pair<int, std::string>>({
+		//                          std::pair<int, std::string>(25, "Bob"),
+		//                          std::pair<int, std::string>(30, "Jake"),
+		//                          std::pair<int, std::string>(45, "Michael"),
+		//                          std::pair<int, std::string>(63, "Philipp"),
+		//                       })
+		template <typename UKey, typename UCompare>
+		[[nodiscard]] btree_set<std::pair<TKey, UKey>> zip(const btree_set<UKey, UCompare>& set) const
+		{
+			assert(size() == set.size());
+			std::vector<std::pair<TKey, UKey>> combined;
+			combined.reserve(m_size);
+			auto it1 = begin();
+			auto it2 = set.begin();
+			for (; it1 != end() && it2 != set.end(); ++it1, ++it2) {
+				combined.push_back(std::pair<TKey, UKey>(*it1, *it2));
+			}
+			return btree_set<std::pair<TKey, UKey>>(combined);
+		}
+
+		// Performs the functional `zip` algorithm by using the unique values of the vector.
+		// The number of uniques vector values must match the set's size.
+		// For more details, see the zip function which accepts a fcpp::btree_set as input.
+		template <typename UKey>
+		[[nodiscard]] btree_set<std::pair<TKey, UKey>> zip(const vector<UKey>& vector) const
+		{
+			return zip(btree_set<UKey>(vector));
+		}
+
+		// Executes the given operation for each key of the set, in ascending order.
+		// The operation must not change the set's contents during execution.
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, TKey const&>>>
+#else
+		template <typename Callable>
+#endif
+		const btree_set& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(),
+			              end(),
+			              std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns all keys of the set in a vector, in ascending order
+		vector<TKey> keys() const
+		{
+			return vector<TKey>(std::vector<TKey>(begin(), end()));
+		}
+
+		// Returns an immutable copy of the set with O(1) lookups through a perfect hash function.
+		// Requires including "frozen_set.h". See fcpp::set::freeze for more details.
+		template <class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey>>
+		[[nodiscard]] frozen_set<TKey, THash, TEqual> freeze(THash hash = THash(), TEqual equal = TEqual()) const
+		{
+			return frozen_set<TKey, THash, TEqual>(begin(), end(), std::move(hash), std::move(equal));
+		}
+
+		// Removes an element from the set, if it exists, potentially changing the set's contents (mutating)
+		//
+		// example:
+		//      fcpp::btree_set<int> numbers({1, 4, 2});
+		//      numbers.remove(4);
+		//
+		// outcome:
+		//      numbers -> fcpp::btree_set<int>({1, 2})
+		btree_set& remove(const TKey& element)
+		{
+			if (m_root == nullptr || !erase_from(m_root, element)) {
+				return *this;
+			}
+			--m_size;
+			if (m_root->count == 0) {
+				// the root lost its last key, so the tree becomes one level shorter
+				node* old_root = m_root;
+				if (old_root->is_leaf) {
+					m_root = nullptr;
+					delete old_root;
+				} else {
+					m_root = as_internal(old_root)->children[0];
+					m_root->parent = nullptr;
+					delete as_internal(old_root);
+				}
+			}
+			return *this;
+		}
+
+		// Returns a copy by removing an element from the set, if it exists (non-mutating)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2});
+		//      auto less_numbers = numbers.removing(4);
+		//
+		// outcome:
+		//      less_numbers -> fcpp::btree_set<int>({1, 2})
+		//      numbers -> fcpp::btree_set<int>({1, 2, 4})
+		[[nodiscard]] btree_set removing(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.remove(element);
+			return copy;
+		}
+
+		// Inserts an element in the set, if it does not already exist, potentially changing the set's contents (mutating)
+		//
+		// example:
+		//      fcpp::btree_set<int> numbers({1, 4, 2});
+		//      numbers.insert(18);
+		//
+		// outcome:
+		//      numbers -> fcpp::btree_set<int>({1, 2, 4, 18})
+		btree_set& insert(const TKey& element)
+		{
+			insert_key(element);
+			return *this;
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// The batch is sorted first, so that consecutive insertions descend along the same path.
+		//
+		// example:
+		//      fcpp::btree_set<int> numbers({1, 4, 2});
+		//      const std::vector<int> batch({18, 3, 4, 7});
+		//      numbers.insert_range(batch.begin(), batch.end());
+		//
+		// outcome:
+		//      numbers -> fcpp::btree_set<int>({1, 2, 3, 4, 7, 18})
+		template <typename Iterator>
+		btree_set& insert_range(const Iterator& range_begin, const Iterator& range_end)
+		{
+			std::vector<TKey> batch(range_begin, range_end);
+			std::sort(batch.begin(), batch.end(), m_compare);
+			for (const auto& key : batch) {
+				insert_key(key);
+			}
+			return *this;
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		btree_set& insert(const vector<TKey>& batch)
+		{
+			return insert_range(batch.begin(), batch.end());
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		btree_set& insert(const std::vector<TKey>& batch)
+		{
+			return insert_range(batch.cbegin(), batch.cend());
+		}
+
+		// Returns a copy by inserting an element in the set, if it does not already exist (non-mutating)
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2});
+		//      auto augmented_numbers =  numbers.inserting(18);
+		//
+		// outcome:
+		//      augmented_numbers -> fcpp::btree_set<int>({1, 2, 4, 18})
+		//      numbers -> fcpp::btree_set<int>({1, 2, 4})
+		[[nodiscard]] btree_set inserting(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.insert_key(element);
+			return copy;
+		}
+
+		// Removes all keys from the set (mutating)
+		btree_set& clear()
+		{
+			destroy_subtree(m_root);
+			m_root = nullptr;
+			m_size = 0;
+			return *this;
+		}
+
+		// Returns a new set by clearing all keys from the current set (non-mutating)
+		[[nodiscard]] btree_set clearing() const
+		{
+			return btree_set();
+		}
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_size == 0;
+		}
+
+		// Returns true if the key is present in the set, otherwise false
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2});
+		//      numbers.contains(1); // true
+		//      numbers.contains(15); // false
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			const node* x = m_root;
+			while (x != nullptr) {
+				const auto i = lower_bound_index(x, key);
+				if (i < x->count && !m_compare(key, x->key(i))) {
+					return true;
+				}
+				x = x->is_leaf ? nullptr : static_cast<const internal_node*>(x)->children[i];
+			}
+			return false;
+		}
+
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		//
+		// example:
+		//      const fcpp::btree_set<int> numbers({1, 4, 2});
+		//      const auto found = numbers.contains_all(fcpp::vector<int>({4, 15, 1}));
+		//
+		// outcome:
+		//      found -> std::vector<bool>({true, false, true})
+		[[nodiscard]] std::vector<bool> contains_all(const vector<TKey>& batch) const
+		{
+			return contains_all(std::vector<TKey>(batch.begin(), batch.end()));
+		}
+
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		[[nodiscard]] std::vector<bool> contains_all(const std::vector<TKey>& batch) const
+		{
+			std::vector<bool> found(batch.size(), false);
+			for (size_t i = 0; i < batch.size(); ++i) {
+				found[i] = contains(batch[i]);
+			}
+			return found;
+		}
+
+		// Returns the size of the set (how many keys it contains)
+		[[nodiscard]] size_t size() const
+		{
+			return m_size;
+		}
+
+		// Returns the const begin iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator begin() const
+		{
+			return m_root != nullptr
+				? const_iterator(this, leftmost_leaf(m_root), 0)
+				: end();
+		}
+
+		// Returns the const end iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator end() const
+		{
+			return const_iterator(this, nullptr, 0);
+		}
+
+		// Returns the given key in the current set, allowing subscripting.
+		// Bounds checking (assert) is enabled for debug builds.
+		// Performance is O(n), so be careful for performance critical code sections.
+		TKey operator[](size_t index) const
+		{
+			assert(index < size());
+			auto it = begin();
+			std::advance(it, index);
+			return *it;
+		}
+
+		// Returns true if both instances have equal sizes and the corresponding elements (keys) are equal
+		bool operator ==(const btree_set& rhs) const
+		{
+			if (size() != rhs.size()) {
+				return false;
+			}
+			auto it1 = begin();
+			auto it2 = rhs.begin();
+			for (; it1 != end(); ++it1, ++it2) {
+				if (!(*it1 == *it2)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Returns false if either the sizes are not equal or at least one corresponding element (key) is not equal
+		bool operator !=(const btree_set& rhs) const
+		{
+			return !((*this) == rhs);
+		}
+
+	private:
+		node* m_root;
+		size_t m_size;
+		TCompare m_compare;
+
+		static internal_node* as_internal(node* n)
+		{
+			return static_cast<internal_node*>(n);
+		}
+
+		static const node* leftmost_leaf(const node* n)
+		{
+			while (!n->is_leaf) {
+				n = static_cast<const internal_node*>(n)->children[0];
+			}
+			return n;
+		}
+
+		static const node* rightmost_leaf(const node* n)
+		{
+			while (!n->is_leaf) {
+				n = static_cast<const internal_node*>(n)->children[n->count];
+			}
+			return n;
+		}
+
+		static size_t child_position(const node* parent, const node* child)
+		{
+			const auto children = static_cast<const internal_node*>(parent)->children;
+			return static_cast<size_t>(std::find(children, children + parent->count + 1, child) - children);
+		}
+
+		static void destroy_subtree(node* n)
+		{
+			if (n == nullptr) {
+				return;
+			}
+			for (size_t i = 0; i < n->count; ++i) {
+				n->key(i).~TKey();
+			}
+			if (n->is_leaf) {
+				delete n;
+				return;
+			}
+			const auto x = as_internal(n);
+			for (size_t i = 0; i <= x->count; ++i) {
+				destroy_subtree(x->children[i]);
+			}
+			delete x;
+		}
+
+		static void set_child(internal_node* x, size_t index, node* child)
+		{
+			x->children[index] = child;
+			child->parent = x;
+		}
+
+		// Inserts the key at the given position of a node which is not full, shifting the keys on its right
+		static void insert_at(node* n, size_t position, TKey value)
+		{
+			const auto keys = n->keys();
+			if (position == n->count) {
+				new (keys + position) TKey(std::move(value));
+			} else {
+				new (keys + n->count) TKey(std::move(keys[n->count - 1]));
+				std::move_backward(keys + position, keys + n->count - 1, keys + n->count);
+				keys[position] = std::move(value);
+			}
+			++n->count;
+		}
+
+		// Removes the key at the given position of a node, shifting the keys on its right
+		static void erase_at(node* n, size_t position)
+		{
+			const auto keys = n->keys();
+			std::move(keys + position + 1, keys + n->count, keys + position);
+			keys[n->count - 1].~TKey();
+			--n->count;
+		}
+
+		size_t lower_bound_index(const node* n, const TKey& key) const
+		{
+			return static_cast<size_t>(std::lower_bound(n->keys(), n->keys() + n->count, key, m_compare) - n->keys());
+		}
+
+		// Splits the full child at the given index of x into two nodes of t - 1 keys, moving the median key up to x
+		static void split_child(internal_node* x, size_t index)
+		{
+			node* y = x->children[index];
+			node* z = y->is_leaf ? new node(true) : new internal_node();
+			for (size_t j = 0; j + 1 < min_degree; ++j) {
+				new (z->keys() + j) TKey(std::move(y->key(min_degree + j)));
+			}
+			z->count = static_cast<std::uint16_t>(min_degree - 1);
+			if (!y->is_leaf) {
+				for (size_t j = 0; j < min_degree; ++j) {
+					set_child(as_internal(z), j, as_internal(y)->children[min_degree + j]);
+				}
+			}
+			TKey median(std::move(y->key(min_degree - 1)));
+			for (size_t j = min_degree - 1; j < max_keys; ++j) {
+				y->key(j).~TKey();
+			}
+			y->count = static_cast<std::uint16_t>(min_degree - 1);
+
+			for (size_t j = x->count + 1; j > index + 1; --j) {
+				x->children[j] = x->children[j - 1];
+			}
+			set_child(x, index + 1, z);
+			insert_at(x, index, std::move(median));
+		}
+
+		// Merges the children at index and index + 1 of x, together with the key between them, into the left child
+		static void merge_children(internal_node* x, size_t index)
+		{
+			node* left = x->children[index];
+			node* right = x->children[index + 1];
+			const size_t left_count = left->count;
+			new (left->keys() + left_count) TKey(std::move(x->key(index)));
+			for (size_t j = 0; j < right->count; ++j) {
+				new (left->keys() + left_count + 1 + j) TKey(std::move(right->key(j)));
+				right->key(j).~TKey();
+			}
+			if (!left->is_leaf) {
+				for (size_t j = 0; j <= right->count; ++j) {
+					set_child(as_internal(left), left_count + 1 + j, as_internal(right)->children[j]);
+				}
+			}
+			left->count = static_cast<std::uint16_t>(left_count + 1 + right->count);
+			if (right->is_leaf) {
+				delete right;
+			} else {
+				delete as_internal(right);
+			}
+
+			for (size_t j = index + 1; j < x->count; ++j) {
+				x->children[j] = x->children[j + 1];
+			}
+			erase_at(x, index);
+		}
+
+		// Moves a key from the left sibling of the child at index, through x, into the child
+		static void rotate_from_left(internal_node* x, size_t index)
+		{
+			node* child = x->children[index];
+			node* left = x->children[index - 1];
+			insert_at(child, 0, std::move(x->key(index - 1)));
+			x->key(index - 1) = std::move(left->key(left->count - 1));
+			if (!child->is_leaf) {
+				const auto c = as_internal(child);
+				for (size_t j = c->count; j > 0; --j) {
+					c->children[j] = c->children[j - 1];
+				}
+				set_child(c, 0, as_internal(left)->children[left->count]);
+			}
+			erase_at(left, left->count - 1);
+		}
+
+		// Moves a key from the right sibling of the child at index, through x, into the child
+		static void rotate_from_right(internal_node* x, size_t index)
+		{
+			node* child = x->children[index];
+			node* right = x->children[index + 1];
+			insert_at(child, child->count, std::move(x->key(index)));
+			x->key(index) = std::move(right->key(0));
+			if (!child->is_leaf) {
+				const auto r = as_internal(right);
+				set_child(as_internal(child), child->count, r->children[0]);
+				for (size_t j = 0; j < r->count; ++j) {
+					r->children[j] = r->children[j + 1];
+				}
+			}
+			erase_at(right, 0);
+		}
+
+		// Single pass top-down insertion: full nodes are split on the way down,
+		// so that the leaf always has room for the new key
+		bool insert_key(const TKey& key)
+		{
+			if (m_root == nullptr) {
+				m_root = new node(true);
+			}
+			if (m_root->count == max_keys) {
+				const auto root = new internal_node();
+				set_child(root, 0, m_root);
+				m_root = root;
+				split_child(root, 0);
+			}
+			node* x = m_root;
+			while (true) {
+				auto i = lower_bound_index(x, key);
+				if (i < x->count && !m_compare(key, x->key(i))) {
+					return false;
+				}
+				if (x->is_leaf) {
+					insert_at(x, i, key);
+					++m_size;
+					return true;
+				}
+				const auto xi = as_internal(x);
+				if (xi->children[i]->count == max_keys) {
+					split_child(xi, i);
+					if (m_compare(x->key(i), key)) {
+						++i;
+					} else if (!m_compare(key, x->key(i))) {
+						return false;
+					}
+				}
+				x = xi->children[i];
+			}
+		}
+
+		// Single pass top-down removal: every node we descend into is first given at least t keys,
+		// so that removing a key from it never leaves it with less than t - 1 keys
+		bool erase_from(node* x, const TKey& key)
+		{
+			auto i = lower_bound_index(x, key);
+			const auto found = i < x->count && !m_compare(key, x->key(i));
+			if (x->is_leaf) {
+				if (found) {
+					erase_at(x, i);
+				}
+				return found;
+			}
+
+			const auto xi = as_internal(x);
+			if (found) {
+				node* left = xi->children[i];
+				node* right = xi->children[i + 1];
+				if (left->count >= min_degree) {
+					// replace the key by its predecessor, and remove the predecessor from the left subtree
+					const auto leaf = rightmost_leaf(left);
+					TKey predecessor(leaf->key(leaf->count - 1));
+					x->key(i) = predecessor;
+					return erase_from(left, predecessor);
+				}
+				if (right->count >= min_degree) {
+					const auto leaf = leftmost_leaf(right);
+					TKey successor(leaf->key(0));
+					x->key(i) = successor;
+					return erase_from(right, successor);
+				}
+				merge_children(xi, i);
+				return erase_from(left, key);
+			}
+
+			if (xi->children[i]->count < min_degree) {
+				if (i > 0 && xi->children[i - 1]->count >= min_degree) {
+					rotate_from_left(xi, i);
+				} else if (i < x->count && xi->children[i + 1]->count >= min_degree) {
+					rotate_from_right(xi, i);
+				} else if (i < x->count) {
+					merge_children(xi, i);
+				} else {
+					merge_children(xi, i - 1);
+					--i;
+				}
+			}
+			return erase_from(xi->children[i], key);
+		}
+
+		// Attaches a new rightmost sibling to the given rightmost node, separated by the given key
+		void push_right(node* left, TKey separator, node* right)
+		{
+			internal_node* parent = left->parent;
+			if (parent == nullptr) {
+				parent = new internal_node();
+				set_child(parent, 0, left);
+				m_root = parent;
+			}
+			if (parent->count < max_keys) {
+				new (parent->keys() + parent->count) TKey(std::move(separator));
+				++parent->count;
+				set_child(parent, parent->count, right);
+				return;
+			}
+			// the parent is full: its last key moves up, and its last child moves to a new sibling
+			const auto sibling = new internal_node();
+			TKey up(std::move(parent->key(parent->count - 1)));
+			parent->key(parent->count - 1).~TKey();
+			set_child(sibling, 0, parent->children[parent->count]);
+			--parent->count;
+			new (sibling->keys()) TKey(std::move(separator));
+			sibling->count = 1;
+			set_child(sibling, 1, right);
+			push_right(parent, std::move(up), sibling);
+		}
+
+		// Builds the tree from sorted unique keys in O(n), filling the nodes from left to right
+		template <typename Iterator>
+		void build_sorted(Iterator range_begin, const Iterator& range_end)
+		{
+			node* leaf = nullptr;
+			for (; range_begin != range_end; ++range_begin) {
+				if (leaf == nullptr) {
+					leaf = m_root = new node(true);
+				}
+				if (leaf->count < max_keys) {
+					new (leaf->keys() + leaf->count) TKey(*range_begin);
+					++leaf->count;
+				} else {
+					TKey separator(std::move(leaf->key(leaf->count - 1)));
+					leaf->key(leaf->count - 1).~TKey();
+					--leaf->count;
+					const auto fresh = new node(true);
+					new (fresh->keys()) TKey(*range_begin);
+					fresh->count = 1;
+					push_right(leaf, std::move(separator), fresh);
+					leaf = fresh;
+				}
+				++m_size;
+			}
+
+			// only the nodes of the right spine may have less than t - 1 keys,
+			// their left siblings have at least 2t - 2 keys to share with them
+			node* x = m_root;
+			while (x != nullptr && !x->is_leaf) {
+				const auto xi = as_internal(x);
+				while (xi->children[x->count]->count + 1 < min_degree) {
+					rotate_from_left(xi, x->count);
+				}
+				x = xi->children[x->count];
+			}
+		}
+
+		void build_unsorted(std::vector<TKey> keys)
+		{
+			std::sort(keys.begin(), keys.end(), m_compare);
+			const auto compare = m_compare;
+			keys.erase(std::unique(keys.begin(),
+			                       keys.end(),
+			                       [&compare](const TKey& a, const TKey& b) {
+				                       return !compare(a, b) && !compare(b, a);
+			                       }), keys.end());
+			build_sorted(keys.begin(), keys.end());
+		}
+
+		static btree_set from_sorted(const std::vector<TKey>& keys, const TCompare& compare)
+		{
+			btree_set result;
+			result.m_compare = compare;
+			result.build_sorted(keys.begin(), keys.end());
+			return result;
+		}
+
+		template <typename Iterator>
+		btree_set difference_with_range(const Iterator& other_begin, const Iterator& other_end) const
+		{
+			std::vector<TKey> diff;
+			std::set_difference(begin(), end(), other_begin, other_end, std::back_inserter(diff), m_compare);
+			return from_sorted(diff, m_compare);
+		}
+
+		template <typename Iterator>
+		btree_set union_with_range(const Iterator& other_begin, const Iterator& other_end) const
+		{
+			std::vector<TKey> combined;
+			std::set_union(begin(), end(), other_begin, other_end, std::back_inserter(combined), m_compare);
+			return from_sorted(combined, m_compare);
+		}
+
+		template <typename Iterator>
+		btree_set intersect_with_range(const Iterator& other_begin, const Iterator& other_end) const
+		{
+			std::vector<TKey> intersection;
+			std::set_intersection(begin(), end(), other_begin, other_end, std::back_inserter(intersection), m_compare);
+			return from_sorted(intersection, m_compare);
+		}
+	};
+}
@@ -29,3 +29,13 @@
 #if defined(CPP17_AVAILABLE) && !defined(__clang__)
 #define PARALLEL_ALGORITHM_AVAILABLE
 #endif
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define CPP20_COROUTINES_AVAILABLE
+#endif
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+#define MULTIPROCESS_AVAILABLE
+#endif
@@ -0,0 +1,238 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include "hashing.h"
+#include "set.h"
+
+namespace fcpp {
+
+	// A hash set which can be used from many threads at the same time, e.g. for deduplicating streams.
+	//
+	// The keys are distributed over shards by their hash, and every shard is an std::unordered_set
+	// protected by its own mutex. Operations on keys of different shards do not contend, so the
+	// throughput scales with the number of threads instead of being serialized by a single lock.
+	//
+	// All operations are safe to call concurrently. Operations which visit all shards (size, snapshot,
+	// for_each) lock one shard at a time, so they are not an atomic picture of the whole set while
+	// other threads keep modifying it.
+	//
+	// example:
+	//      fcpp::concurrent_set<std::string> seen;
+	//      // in every thread
+	//      if (seen.insert_if_absent(message_id)) {
+	//          process(message);
+	//      }
+	//      // after the threads are done
+	//      const fcpp::set<std::string> processed = seen.snapshot();
+	template <class TKey, class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey>>
+	class concurrent_set
+	{
+	public:
+		// Creates an empty set with the given number of shards. By default there are four shards per
+		// hardware thread, so that threads rarely wait for the same shard.
+		explicit concurrent_set(size_t shard_count = default_shard_count())
+			: m_shard_count(shard_count > 0 ? shard_count : 1),
+			m_shards(new shard[m_shard_count]),
+			m_hash()
+		{
+		}
+
+		concurrent_set(const concurrent_set&) = delete;
+		concurrent_set& operator =(const concurrent_set&) = delete;
+
+		// Inserts the key and returns true if it was not already contained (i.e. this call inserted it).
+		// When many threads insert the same key concurrently, exactly one of them gets true.
+		//
+		// example:
+		//      fcpp::concurrent_set<int> numbers;
+		//      const auto first = numbers.insert_if_absent(5);
+		//      const auto second = numbers.insert_if_absent(5);
+		//
+		// outcome:
+		//      first -> true
+		//      second -> false
+		bool insert_if_absent(const TKey& key)
+		{
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return s.keys.insert(key).second;
+		}
+
+		// Inserts the key by moving it, and returns true if it was not already contained
+		bool insert_if_absent(TKey&& key)
+		{
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return s.keys.insert(std::move(key)).second;
+		}
+
+		// Inserts the key in place (mutating), if it is not already contained
+		//
+		// example:
+		//      fcpp::concurrent_set<int> numbers;
+		//      numbers.insert(18).insert(7).insert(18);
+		//
+		// outcome:
+		//      numbers.size() -> 2
+		concurrent_set& insert(const TKey& key)
+		{
+			insert_if_absent(key);
+			return *this;
+		}
+
+		// Removes the key in place (mutating), if it is contained
+		//
+		// example:
+		//      fcpp::concurrent_set<int> numbers;
+		//      numbers.insert(18).insert(7).remove(18);
+		//
+		// outcome:
+		//      numbers.contains(18) -> false
+		concurrent_set& remove(const TKey& key)
+		{
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			s.keys.erase(key);
+			return *this;
+		}
+
+		// Returns true if the key is contained, only its shard is locked
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return s.keys.find(key) != s.keys.end();
+		}
+
+		// Returns the number of keys. While other threads are modifying the set, the result is approximate.
+		[[nodiscard]] size_t size() const
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				count += m_shards[i].keys.size();
+			}
+			return count;
+		}
+
+		// Returns true if there are no keys
+		[[nodiscard]] bool is_empty() const
+		{
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				if (!m_shards[i].keys.empty()) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Removes all keys (mutating)
+		concurrent_set& clear()
+		{
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				m_shards[i].keys.clear();
+			}
+			return *this;
+		}
+
+		// Returns the number of shards
+		[[nodiscard]] size_t shard_count() const
+		{
+			return m_shard_count;
+		}
+
+		// Executes the given operation for each key, in no particular order. The shard of the key is
+		// locked during the call, so the operation must not access this set.
+		template <typename Callable>
+		const concurrent_set& for_each(Callable&& operation) const
+		{
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				for (const auto& key : m_shards[i].keys) {
+					operation(key);
+				}
+			}
+			return *this;
+		}
+
+		// Copies the keys into an fcpp::set, to continue with its functional API
+		//
+		// example:
+		//      fcpp::concurrent_set<int> numbers;
+		//      numbers.insert(18).insert(7).insert(3);
+		//      const auto odd_numbers = numbers.snapshot().filtered([](const int& number) {
+		//          return number % 2 == 1;
+		//      });
+		//
+		// outcome:
+		//      odd_numbers -> fcpp::set<int>({3, 7})
+		template <class TCompare = std::less<TKey>>
+		[[nodiscard]] set<TKey, TCompare> snapshot() const
+		{
+			std::set<TKey, TCompare> keys;
+			for_each([&keys](const TKey& key) {
+				keys.insert(key);
+			});
+			return set<TKey, TCompare>(std::move(keys));
+		}
+
+	private:
+		struct shard
+		{
+			mutable std::mutex mutex;
+			std::unordered_set<TKey, THash, TEqual> keys;
+			// keeps the mutexes of neighbouring shards in different cache lines
+			char padding[64];
+		};
+
+		size_t m_shard_count;
+		std::unique_ptr<shard[]> m_shards;
+		THash m_hash;
+
+		static size_t default_shard_count()
+		{
+			const size_t hardware_threads = std::thread::hardware_concurrency();
+			return 4 * (hardware_threads > 0 ? hardware_threads : 1);
+		}
+
+		// The unordered_set of the shard uses the low bits of the hash for its buckets,
+		// so the shard is chosen from the high bits of the mixed hash.
+		shard& shard_of(const TKey& key) const
+		{
+			const auto h = detail::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+			return m_shards[detail::reduce_range(static_cast<std::uint32_t>(h >> 32), m_shard_count)];
+		}
+	};
+}
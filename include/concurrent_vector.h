@@ -0,0 +1,300 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include "index_range.h"
+#include "vector.h"
+
+namespace fcpp {
+
+	// An append-only vector which can be filled from many threads at the same time.
+	//
+	// The elements are stored in segments of doubling capacity (16, 32, 64, ...), so a segment is never
+	// reallocated and the elements never move: references to elements remain valid while other threads
+	// keep appending. Appending only reserves slots with an atomic counter, and a missing segment is
+	// installed with a compare-and-swap, so producers never block each other.
+	//
+	// Appending (push_back, grow_by) is safe from any number of threads. Reading an element is safe once
+	// the thread which appended it has finished constructing it (e.g. after the producers are joined).
+	// clear and freeze must not run concurrently with other operations.
+	// Element constructors are not expected to throw.
+	//
+	// example:
+	//      fcpp::concurrent_vector<int> numbers;
+	//      std::thread producer([&]() {
+	//          numbers.push_back(1);
+	//      });
+	//      numbers.push_back(2);
+	//      producer.join();
+	//      const auto frozen = numbers.freeze();
+	//
+	// outcome:
+	//      frozen -> fcpp::vector<int>({1, 2}) or fcpp::vector<int>({2, 1})
+	template <typename T>
+	class concurrent_vector
+	{
+	public:
+		concurrent_vector()
+			: m_size(0)
+		{
+			for (auto& segment : m_segments) {
+				segment.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		concurrent_vector(const concurrent_vector&) = delete;
+		concurrent_vector& operator =(const concurrent_vector&) = delete;
+
+		~concurrent_vector()
+		{
+			clear();
+		}
+
+		// Appends a copy of the element and returns its index, safe to call from multiple threads
+		//
+		// example:
+		//      fcpp::concurrent_vector<int> numbers;
+		//      const auto index = numbers.push_back(5);
+		//
+		// outcome:
+		//      index -> 0
+		//      numbers[0] -> 5
+		size_t push_back(const T& element)
+		{
+			const auto index = reserve_slots(1);
+			new (slot(index)) T(element);
+			return index;
+		}
+
+		// Appends the element by moving it and returns its index, safe to call from multiple threads
+		size_t push_back(T&& element)
+		{
+			const auto index = reserve_slots(1);
+			new (slot(index)) T(std::move(element));
+			return index;
+		}
+
+		// Appends `count` default constructed elements with consecutive indices, safe to call from multiple threads.
+		// Returns the index range of the new elements, which the calling thread can fill without synchronization
+		// (index_range::invalid when count is zero). index_range holds int indices, so the new elements
+		// must end at most at INT_MAX (assert).
+		//
+		// example:
+		//      fcpp::concurrent_vector<int> numbers;
+		//      numbers.push_back(7);
+		//      const auto range = numbers.grow_by(3);
+		//      for (auto i = range.start; i <= range.end; ++i) {
+		//          numbers[i] = i * 10;
+		//      }
+		//
+		// outcome:
+		//      range -> index_range::start_count(1, 3)
+		//      numbers.freeze() -> fcpp::vector<int>({7, 10, 20, 30})
+		index_range grow_by(size_t count)
+		{
+			const auto start = reserve_slots(count);
+			assert(start + count <= static_cast<size_t>(INT_MAX));
+			for (auto i = start; i < start + count; ++i) {
+				new (slot(i)) T();
+			}
+			return index_range::start_count(static_cast<int>(start), static_cast<int>(count));
+		}
+
+		// Appends `count` copies of the element with consecutive indices, safe to call from multiple threads.
+		// Returns the index range of the new elements.
+		index_range grow_by(size_t count, const T& element)
+		{
+			const auto start = reserve_slots(count);
+			assert(start + count <= static_cast<size_t>(INT_MAX));
+			for (auto i = start; i < start + count; ++i) {
+				new (slot(i)) T(element);
+			}
+			return index_range::start_count(static_cast<int>(start), static_cast<int>(count));
+		}
+
+		// Returns a reference to the element in the given index, which remains valid while other threads append.
+		// Bounds checking (assert) is enabled for debug builds.
+		T& operator[](size_t index)
+		{
+			assert(index < size());
+			return *slot(index);
+		}
+
+		// Returns a constant reference to the element in the given index.
+		// Bounds checking (assert) is enabled for debug builds.
+		const T& operator[](size_t index) const
+		{
+			assert(index < size());
+			return *slot(index);
+		}
+
+		// Returns the number of appended elements. While producers are running, this includes
+		// slots whose elements are still being constructed.
+		[[nodiscard]] size_t size() const
+		{
+			return m_size.load(std::memory_order_acquire);
+		}
+
+		// Returns true if no elements have been appended
+		[[nodiscard]] bool is_empty() const
+		{
+			return size() == 0;
+		}
+
+		// Executes the given operation for each element in index order, one segment at a time.
+		// Must not run while producers are appending.
+		template <typename Callable>
+		const concurrent_vector& for_each(Callable&& operation) const
+		{
+			for_each_segment_range([&operation](T* begin, T* end) {
+				for (auto it = begin; it != end; ++it) {
+					operation(*it);
+				}
+			});
+			return *this;
+		}
+
+		// Moves all elements (in index order) into an fcpp::vector and leaves this instance empty.
+		// The elements are moved, not copied, since the segments are not contiguous.
+		// Must not run while producers are appending.
+		//
+		// example:
+		//      fcpp::concurrent_vector<std::string> names;
+		//      names.push_back("Jake");
+		//      names.push_back("Mary");
+		//      const auto frozen = names.freeze();
+		//
+		// outcome:
+		//      frozen -> fcpp::vector<std::string>({"Jake", "Mary"})
+		//      names.is_empty() -> true
+		[[nodiscard]] vector<T> freeze()
+		{
+			std::vector<T> elements;
+			elements.reserve(size());
+			for_each_segment_range([&elements](T* begin, T* end) {
+				for (auto it = begin; it != end; ++it) {
+					elements.push_back(std::move(*it));
+				}
+			});
+			clear();
+			return vector<T>(std::move(elements));
+		}
+
+		// Destroys all elements and releases the segments. Must not run while producers are appending.
+		void clear()
+		{
+			for_each_segment_range([](T* begin, T* end) {
+				for (auto it = begin; it != end; ++it) {
+					it->~T();
+				}
+			});
+			for (auto& segment : m_segments) {
+				::operator delete(segment.exchange(nullptr, std::memory_order_acq_rel));
+			}
+			m_size.store(0, std::memory_order_release);
+		}
+
+	private:
+		static const size_t first_segment_bits = 4;
+		static const size_t max_segments = sizeof(size_t) * 8 - first_segment_bits;
+
+		std::atomic<size_t> m_size;
+		std::atomic<T*> m_segments[max_segments];
+
+		static size_t highest_bit(size_t value)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(value));
+#else
+			size_t bit = 0;
+			while (value >>= 1) {
+				++bit;
+			}
+			return bit;
+#endif
+		}
+
+		static size_t segment_capacity(size_t segment)
+		{
+			return static_cast<size_t>(1) << (segment + first_segment_bits);
+		}
+
+		// The index of the first element of the segment, segment k starts at 16 * (2^k - 1)
+		static size_t segment_start(size_t segment)
+		{
+			return segment_capacity(segment) - segment_capacity(0);
+		}
+
+		static size_t segment_of(size_t index)
+		{
+			return highest_bit(index + segment_capacity(0)) - first_segment_bits;
+		}
+
+		T* slot(size_t index) const
+		{
+			const auto segment = segment_of(index);
+			return m_segments[segment].load(std::memory_order_acquire) + (index - segment_start(segment));
+		}
+
+		// Claims `count` consecutive indices and makes sure that the segments holding them exist
+		size_t reserve_slots(size_t count)
+		{
+			const auto start = m_size.fetch_add(count, std::memory_order_acq_rel);
+			if (count == 0) {
+				return start;
+			}
+			const auto last_segment = segment_of(start + count - 1);
+			for (auto segment = segment_of(start); segment <= last_segment; ++segment) {
+				if (m_segments[segment].load(std::memory_order_acquire) != nullptr) {
+					continue;
+				}
+				auto storage = static_cast<T*>(::operator new(sizeof(T) * segment_capacity(segment)));
+				T* expected = nullptr;
+				if (!m_segments[segment].compare_exchange_strong(expected, storage, std::memory_order_acq_rel)) {
+					// another thread installed the segment first
+					::operator delete(storage);
+				}
+			}
+			return start;
+		}
+
+		template <typename Callable>
+		void for_each_segment_range(Callable&& operation) const
+		{
+			const auto element_count = size();
+			for (size_t segment = 0; segment < max_segments && segment_start(segment) < element_count; ++segment) {
+				const auto begin = m_segments[segment].load(std::memory_order_acquire);
+				const auto count = std::min(segment_capacity(segment), element_count - segment_start(segment));
+				operation(begin, begin + count);
+			}
+		}
+	};
+}
@@ -0,0 +1,488 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "hashing.h"
+#include "vector.h"
+
+namespace fcpp {
+	// An immutable set for read-only lookup tables, built once and queried many times.
+	// The keys are stored contiguously, and placed with a perfect hash function
+	// (CHD, "compress, hash and displace"), so that `contains` is O(1) and touches at most
+	// two memory locations: the displacement of the key's bucket and the key's slot.
+	//
+	// The slot table is slightly larger than the number of keys, which keeps the construction
+	// fast. Unused slots hold a copy of a stored key, so that a lookup never checks for emptiness.
+	//
+	// Keys whose hash values collide exactly cannot be separated by any perfect hash function.
+	// Such keys are kept in a small overflow region sorted by hash value, which is only searched
+	// when it is not empty and the slot lookup fails.
+	//
+	// The iteration order is unspecified (it follows the hash slots and not the keys' order).
+	//
+	// example:
+	//      const fcpp::set<int> codes({200, 301, 404, 500});
+	//      const auto frozen_codes = codes.freeze();
+	//
+	// outcome:
+	//      frozen_codes.contains(404) -> true
+	//      frozen_codes.contains(403) -> false
+	template <class TKey, class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey>>
+	class frozen_set
+	{
+	public:
+		// Forward iterator over the stored keys, skipping the unused slots
+		class const_iterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef TKey value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TKey* pointer;
+			typedef const TKey& reference;
+
+			const_iterator()
+				: m_set(nullptr), m_index(0)
+			{
+			}
+
+			reference operator*() const
+			{
+				return m_set->m_keys[m_index];
+			}
+
+			pointer operator->() const
+			{
+				return &m_set->m_keys[m_index];
+			}
+
+			const_iterator& operator++()
+			{
+				++m_index;
+				skip_unused();
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				auto previous = *this;
+				++(*this);
+				return previous;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return m_set == other.m_set && m_index == other.m_index;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+		private:
+			friend class frozen_set;
+
+			const frozen_set* m_set;
+			size_t m_index;
+
+			const_iterator(const frozen_set* set, size_t index)
+				: m_set(set), m_index(index)
+			{
+				skip_unused();
+			}
+
+			void skip_unused()
+			{
+				while (m_index < m_set->m_slot_count && !m_set->m_used[m_index]) {
+					++m_index;
+				}
+			}
+		};
+
+		frozen_set()
+			: m_hash(), m_equal(), m_seed(0), m_slot_count(0), m_size(0)
+		{
+		}
+
+		explicit frozen_set(const std::vector<TKey>& keys, THash hash = THash(), TEqual equal = TEqual())
+			: m_hash(std::move(hash)), m_equal(std::move(equal)), m_seed(0), m_slot_count(0), m_size(0)
+		{
+			build(keys.cbegin(), keys.cend());
+		}
+
+		explicit frozen_set(const vector<TKey>& keys, THash hash = THash(), TEqual equal = TEqual())
+			: m_hash(std::move(hash)), m_equal(std::move(equal)), m_seed(0), m_slot_count(0), m_size(0)
+		{
+			build(keys.begin(), keys.end());
+		}
+
+		explicit frozen_set(const std::initializer_list<TKey>& list)
+			: m_hash(), m_equal(), m_seed(0), m_slot_count(0), m_size(0)
+		{
+			build(list.begin(), list.end());
+		}
+
+		// Creates the set from a range of keys. Duplicate keys are stored once.
+		template <typename Iterator>
+		frozen_set(const Iterator& range_begin, const Iterator& range_end, THash hash = THash(), TEqual equal = TEqual())
+			: m_hash(std::move(hash)), m_equal(std::move(equal)), m_seed(0), m_slot_count(0), m_size(0)
+		{
+			build(range_begin, range_end);
+		}
+
+		// Returns true if the key is present in the set, otherwise false
+		//
+		// example:
+		//      const fcpp::frozen_set<int> numbers({1, 4, 2});
+		//      numbers.contains(1); // true
+		//      numbers.contains(15); // false
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			const auto user_hash = static_cast<std::uint64_t>(m_hash(key));
+			if (m_slot_count != 0) {
+				const auto h = detail::mix_hash(user_hash ^ m_seed);
+				const auto& displacement = m_displacements[bucket_of(h)];
+				if (m_equal(m_keys[slot_of(h, displacement)], key)) {
+					return true;
+				}
+			}
+			return !m_overflow_hashes.empty() && overflow_contains(user_hash, key);
+		}
+
+		// Returns true if all keys match the predicate (return true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool all_of(Callable&& unary_predicate) const
+		{
+			return std::all_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if at least one key matches the predicate (returns true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool any_of(Callable&& unary_predicate) const
+		{
+			return std::any_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if none of the keys match the predicate (all return false)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool none_of(Callable&& unary_predicate) const
+		{
+			return std::none_of(begin(),
+			                    end(),
+			                    std::forward<Callable>(unary_predicate));
+		}
+
+		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
+		// accumulating all the keys of the set to an initial value. The order of the keys is unspecified.
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TKey>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (auto it = begin(); it != end(); ++it) {
+				result = reduction(result, *it);
+			}
+			return result;
+		}
+
+		// Executes the given operation for each key of the set, in an unspecified order
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, TKey const&>>>
+#else
+		template <typename Callable>
+#endif
+		const frozen_set& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(),
+			              end(),
+			              std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns all keys of the set in a vector, in an unspecified order
+		vector<TKey> keys() const
+		{
+			return vector<TKey>(std::vector<TKey>(begin(), end()));
+		}
+
+		// Returns the size of the set (how many keys it contains)
+		[[nodiscard]] size_t size() const
+		{
+			return m_size;
+		}
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_size == 0;
+		}
+
+		// Returns the const begin iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator begin() const
+		{
+			return const_iterator(this, 0);
+		}
+
+		// Returns the const end iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator end() const
+		{
+			return const_iterator(this, m_keys.size());
+		}
+
+	private:
+		// average number of keys per bucket, lower values make the construction faster but use more memory
+		static const size_t keys_per_bucket = 3;
+		// one extra slot per this many keys, more free slots make the construction faster
+		static const size_t keys_per_spare_slot = 10;
+
+		struct displacement
+		{
+			std::uint32_t d0;
+			std::uint32_t d1;
+		};
+
+		THash m_hash;
+		TEqual m_equal;
+		std::uint64_t m_seed;
+		size_t m_slot_count;
+		size_t m_size;
+		std::vector<displacement> m_displacements;
+		// keys placed by the perfect hash function, followed by the overflow keys sorted by hash value
+		std::vector<TKey> m_keys;
+		// false for the unused slots, which hold a copy of a stored key
+		std::vector<bool> m_used;
+		std::vector<std::uint64_t> m_overflow_hashes;
+
+		size_t bucket_of(std::uint64_t h) const
+		{
+			return detail::reduce_range(static_cast<std::uint32_t>(h >> 32), m_displacements.size());
+		}
+
+		size_t slot_of(std::uint64_t h, const displacement& d) const
+		{
+			const auto f1 = static_cast<std::uint32_t>(h);
+			const auto f2 = static_cast<std::uint32_t>(detail::mix_hash(h));
+			return detail::reduce_range(f1 + d.d0 * f2 + d.d1, m_slot_count);
+		}
+
+		bool overflow_contains(std::uint64_t user_hash, const TKey& key) const
+		{
+			auto it = std::lower_bound(m_overflow_hashes.begin(), m_overflow_hashes.end(), user_hash);
+			for (; it != m_overflow_hashes.end() && *it == user_hash; ++it) {
+				const auto index = m_slot_count + static_cast<size_t>(it - m_overflow_hashes.begin());
+				if (m_equal(m_keys[index], key)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template <typename Iterator>
+		void build(const Iterator& range_begin, const Iterator& range_end)
+		{
+			std::vector<TKey> keys(range_begin, range_end);
+			std::vector<std::uint64_t> hashes;
+			hashes.reserve(keys.size());
+			for (const auto& key : keys) {
+				hashes.push_back(static_cast<std::uint64_t>(m_hash(key)));
+			}
+
+			// group the keys by hash value: the first distinct key of each group is placed by the
+			// perfect hash function, the remaining distinct keys of the group go to the overflow region
+			std::vector<size_t> order(keys.size());
+			for (size_t i = 0; i < order.size(); ++i) {
+				order[i] = i;
+			}
+			std::sort(order.begin(), order.end(), [&hashes](size_t a, size_t b) {
+				return hashes[a] < hashes[b];
+			});
+			std::vector<size_t> placed;
+			std::vector<size_t> overflow;
+			for (size_t group_begin = 0; group_begin < order.size();) {
+				auto group_end = group_begin + 1;
+				while (group_end < order.size() && hashes[order[group_end]] == hashes[order[group_begin]]) {
+					++group_end;
+				}
+				placed.push_back(order[group_begin]);
+				for (auto i = group_begin + 1; i < group_end; ++i) {
+					auto is_duplicate = false;
+					for (auto j = group_begin; j < i && !is_duplicate; ++j) {
+						is_duplicate = m_equal(keys[order[j]], keys[order[i]]);
+					}
+					if (!is_duplicate) {
+						overflow.push_back(order[i]);
+					}
+				}
+				group_begin = group_end;
+			}
+
+			m_size = placed.size() + overflow.size();
+			if (placed.empty()) {
+				return;
+			}
+			m_slot_count = placed.size() + placed.size() / keys_per_spare_slot;
+			const auto slots = place_keys(placed, hashes);
+
+			m_keys.reserve(m_slot_count + overflow.size());
+			m_used.assign(m_slot_count + overflow.size(), true);
+			for (size_t slot = 0; slot < m_slot_count; ++slot) {
+				if (slots[slot] == unused_slot()) {
+					m_keys.push_back(keys[placed.front()]);
+					m_used[slot] = false;
+				} else {
+					m_keys.push_back(std::move(keys[slots[slot]]));
+				}
+			}
+			m_overflow_hashes.reserve(overflow.size());
+			for (const auto index : overflow) {
+				m_keys.push_back(std::move(keys[index]));
+				m_overflow_hashes.push_back(hashes[index]);
+			}
+		}
+
+		static size_t unused_slot()
+		{
+			return static_cast<size_t>(-1);
+		}
+
+		// Finds a seed and a displacement per bucket, so that all keys land in distinct slots.
+		// Returns the index of the key stored in each slot, or `unused_slot()`.
+		std::vector<size_t> place_keys(const std::vector<size_t>& placed, const std::vector<std::uint64_t>& hashes)
+		{
+			std::vector<size_t> slots;
+			auto average_bucket_size = keys_per_bucket;
+			for (std::uint64_t attempt = 0;; ++attempt) {
+				m_seed = detail::mix_hash(attempt);
+				if (attempt != 0 && attempt % 4 == 0 && average_bucket_size > 1) {
+					// smaller buckets are easier to place
+					--average_bucket_size;
+				}
+				const auto bucket_count = (placed.size() + average_bucket_size - 1) / average_bucket_size;
+				m_displacements.assign(bucket_count, displacement());
+				slots.assign(m_slot_count, unused_slot());
+				if (try_place_keys(placed, hashes, slots)) {
+					return slots;
+				}
+			}
+		}
+
+		bool try_place_keys(const std::vector<size_t>& placed,
+		                    const std::vector<std::uint64_t>& hashes,
+		                    std::vector<size_t>& slots)
+		{
+			// group the keys by bucket, with the members of bucket b at [bucket_begin[b], bucket_begin[b + 1])
+			const auto bucket_count = m_displacements.size();
+			std::vector<std::uint64_t> mixed(placed.size());
+			std::vector<size_t> bucket_begin(bucket_count + 1, 0);
+			for (size_t i = 0; i < placed.size(); ++i) {
+				mixed[i] = detail::mix_hash(hashes[placed[i]] ^ m_seed);
+				++bucket_begin[bucket_of(mixed[i]) + 1];
+			}
+			for (size_t b = 0; b < bucket_count; ++b) {
+				bucket_begin[b + 1] += bucket_begin[b];
+			}
+			std::vector<size_t> members(placed.size());
+			std::vector<size_t> next_member(bucket_begin.begin(), bucket_begin.end() - 1);
+			for (size_t i = 0; i < placed.size(); ++i) {
+				members[next_member[bucket_of(mixed[i])]++] = i;
+			}
+
+			// place the largest buckets first, while most slots are still free
+			std::vector<size_t> bucket_order(bucket_count);
+			for (size_t i = 0; i < bucket_order.size(); ++i) {
+				bucket_order[i] = i;
+			}
+			std::sort(bucket_order.begin(), bucket_order.end(), [&bucket_begin](size_t a, size_t b) {
+				const auto size_a = bucket_begin[a + 1] - bucket_begin[a];
+				const auto size_b = bucket_begin[b + 1] - bucket_begin[b];
+				return size_a != size_b ? size_a > size_b : a < b;
+			});
+
+			std::vector<char> occupied(m_slot_count, 0);
+			std::vector<size_t> candidate_slots;
+			const std::uint64_t max_trials = 1 << 20;
+			for (const auto bucket : bucket_order) {
+				const auto first = bucket_begin[bucket];
+				const auto last = bucket_begin[bucket + 1];
+				if (first == last) {
+					break;
+				}
+				auto is_placed = false;
+				for (std::uint64_t trial = 0; trial < max_trials && !is_placed; ++trial) {
+					const auto random = detail::mix_hash(trial);
+					displacement d;
+					d.d0 = static_cast<std::uint32_t>(random >> 32);
+					d.d1 = static_cast<std::uint32_t>(random);
+					candidate_slots.clear();
+					is_placed = true;
+					for (auto m = first; m < last; ++m) {
+						const auto slot = slot_of(mixed[members[m]], d);
+						if (occupied[slot] || std::find(candidate_slots.begin(), candidate_slots.end(), slot) != candidate_slots.end()) {
+							is_placed = false;
+							break;
+						}
+						candidate_slots.push_back(slot);
+					}
+					if (is_placed) {
+						m_displacements[bucket] = d;
+						for (size_t i = 0; i < candidate_slots.size(); ++i) {
+							occupied[candidate_slots[i]] = 1;
+							slots[candidate_slots[i]] = placed[members[first + i]];
+						}
+					}
+				}
+				if (!is_placed) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+}
@@ -0,0 +1,311 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include "compatibility.h"
+
+#ifdef CPP20_COROUTINES_AVAILABLE
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+#include "set.h"
+
+namespace fcpp {
+
+	// A lazy sequence of values produced by a coroutine, one value at a time.
+	//
+	// The coroutine runs only when the consumer asks for the next value, and it is suspended right after
+	// yielding it. Nothing is materialized: the yielded value is referenced (not copied) until the consumer
+	// advances, so the memory stays constant, and values which are never pulled are never computed.
+	// A generator can be iterated once. Exceptions thrown by the coroutine are rethrown to the consumer.
+	//
+	// example:
+	//      fcpp::generator<int> count_to(int last)
+	//      {
+	//          for (auto i = 1; i <= last; ++i) {
+	//              co_yield i;
+	//          }
+	//      }
+	//
+	//      for (const auto& number : count_to(3)) {
+	//          std::cout << number << std::endl;
+	//      }
+	//
+	// outcome:
+	//      1 2 3
+	template <typename T>
+	class generator
+	{
+	public:
+		typedef std::remove_cvref_t<T> value_type;
+		typedef const value_type& reference;
+
+		struct promise_type
+		{
+			const value_type* current = nullptr;
+			std::exception_ptr exception;
+
+			generator get_return_object()
+			{
+				return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() const noexcept
+			{
+				return {};
+			}
+
+			std::suspend_always final_suspend() const noexcept
+			{
+				return {};
+			}
+
+			// The yielded value lives until the coroutine resumes, since temporaries of a co_yield
+			// expression are destroyed only after the suspension
+			std::suspend_always yield_value(const value_type& value) noexcept
+			{
+				current = std::addressof(value);
+				return {};
+			}
+
+			void return_void() const noexcept
+			{
+			}
+
+			void unhandled_exception()
+			{
+				exception = std::current_exception();
+			}
+
+			// co_await is not supported inside generators
+			template <typename U>
+			std::suspend_never await_transform(U&& value) = delete;
+		};
+
+		class iterator
+		{
+		public:
+			typedef std::input_iterator_tag iterator_category;
+			typedef std::ptrdiff_t difference_type;
+			typedef generator::value_type value_type;
+			typedef const value_type& reference;
+			typedef const value_type* pointer;
+
+			iterator() noexcept = default;
+
+			reference operator*() const
+			{
+				return *m_coroutine.promise().current;
+			}
+
+			pointer operator->() const
+			{
+				return m_coroutine.promise().current;
+			}
+
+			iterator& operator++()
+			{
+				resume(m_coroutine);
+				return *this;
+			}
+
+			void operator++(int)
+			{
+				++*this;
+			}
+
+			friend bool operator ==(const iterator& it, std::default_sentinel_t) noexcept
+			{
+				return !it.m_coroutine || it.m_coroutine.done();
+			}
+
+		private:
+			friend class generator;
+
+			explicit iterator(std::coroutine_handle<promise_type> coroutine) noexcept
+				: m_coroutine(coroutine)
+			{
+			}
+
+			std::coroutine_handle<promise_type> m_coroutine;
+		};
+
+		generator(generator&& other) noexcept
+			: m_coroutine(std::exchange(other.m_coroutine, {})), m_started(std::exchange(other.m_started, false))
+		{
+		}
+
+		generator& operator =(generator&& other) noexcept
+		{
+			if (this != &other) {
+				destroy();
+				m_coroutine = std::exchange(other.m_coroutine, {});
+				m_started = std::exchange(other.m_started, false);
+			}
+			return *this;
+		}
+
+		generator(const generator&) = delete;
+		generator& operator =(const generator&) = delete;
+
+		~generator()
+		{
+			destroy();
+		}
+
+		// Runs the coroutine until its first value, the generator can only be iterated once
+		[[nodiscard]] iterator begin()
+		{
+			if (m_coroutine && !m_started) {
+				m_started = true;
+				resume(m_coroutine);
+			}
+			return iterator(m_coroutine);
+		}
+
+		[[nodiscard]] std::default_sentinel_t end() const noexcept
+		{
+			return std::default_sentinel;
+		}
+
+	private:
+		std::coroutine_handle<promise_type> m_coroutine;
+		bool m_started = false;
+
+		explicit generator(std::coroutine_handle<promise_type> coroutine) noexcept
+			: m_coroutine(coroutine)
+		{
+		}
+
+		static void resume(std::coroutine_handle<promise_type> coroutine)
+		{
+			coroutine.resume();
+			if (coroutine.promise().exception) {
+				std::rethrow_exception(std::exchange(coroutine.promise().exception, nullptr));
+			}
+		}
+
+		void destroy() noexcept
+		{
+			if (m_coroutine) {
+				m_coroutine.destroy();
+			}
+		}
+	};
+
+	// Performs the functional `map` algorithm lazily: returns a generator which transforms the elements
+	// one by one, only as the consumer iterates, without materializing the output. A consumer which
+	// stops early skips the transformation of the remaining elements. The source vector must outlive
+	// the generator, unless it is an rvalue, which is moved into the generator.
+	// See also fcpp::vector::map for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<int> input_vector({ 1, 3, -5 });
+	//      for (const auto& text : fcpp::map_gen<std::string>(input_vector, [](const auto& element) {
+	//          return std::to_string(element);
+	//      })) {
+	//          if (text == "3") {
+	//              break;
+	//          }
+	//      }
+	//
+	// outcome:
+	//      the transform is called for 1 and 3, but not for -5
+	template <typename U, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+	generator<U> map_gen(const vector<T, TAllocator>& source, Transform transform)
+	{
+		for (const auto& element : source) {
+			co_yield static_cast<U>(transform(element));
+		}
+	}
+
+	namespace detail {
+		// The coroutines behind the rvalue overloads: a by-value parameter lives in the coroutine frame
+		template <typename U, typename T, typename TAllocator, typename Transform>
+		generator<U> map_gen_owning(vector<T, TAllocator> source, Transform transform)
+		{
+			for (const auto& element : source) {
+				co_yield static_cast<U>(transform(element));
+			}
+		}
+
+		template <typename TContainer, typename TElement, typename Filter>
+		generator<TElement> filter_gen_owning(TContainer source, Filter predicate_to_keep)
+		{
+			for (const auto& element : source) {
+				if (predicate_to_keep(element)) {
+					co_yield element;
+				}
+			}
+		}
+	}
+
+	template <typename U, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+	generator<U> map_gen(vector<T, TAllocator>&& source, Transform transform)
+	{
+		return detail::map_gen_owning<U>(std::move(source), std::move(transform));
+	}
+
+	// Performs the `filtered` algorithm lazily: returns a generator which yields the matching elements
+	// one by one, only as the consumer iterates, without copying them. The source vector must outlive
+	// the generator, unless it is an rvalue, which is moved into the generator.
+	// See also fcpp::vector::filtered for more documentation.
+	template <typename T, typename TAllocator, typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+	generator<T> filter_gen(const vector<T, TAllocator>& source, Callable predicate_to_keep)
+	{
+		for (const auto& element : source) {
+			if (predicate_to_keep(element)) {
+				co_yield element;
+			}
+		}
+	}
+
+	template <typename T, typename TAllocator, typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+	generator<T> filter_gen(vector<T, TAllocator>&& source, Callable predicate_to_keep)
+	{
+		return detail::filter_gen_owning<vector<T, TAllocator>, T>(std::move(source), std::move(predicate_to_keep));
+	}
+
+	// Performs the `filtered` algorithm lazily on the keys of a set, which are yielded in order,
+	// see filter_gen for vectors. See also fcpp::set::filtered for more documentation.
+	template <typename TKey, typename TCompare, typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+	generator<TKey> filter_gen(const set<TKey, TCompare>& source, Filter predicate_to_keep)
+	{
+		for (const auto& key : source) {
+			if (predicate_to_keep(key)) {
+				co_yield key;
+			}
+		}
+	}
+
+	template <typename TKey, typename TCompare, typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+	generator<TKey> filter_gen(set<TKey, TCompare>&& source, Filter predicate_to_keep)
+	{
+		return detail::filter_gen_owning<set<TKey, TCompare>, TKey>(std::move(source), std::move(predicate_to_keep));
+	}
+}
+#endif
@@ -0,0 +1,645 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "vector.h"
+#include "set.h"
+
+namespace fcpp {
+	// The amount of work one step of an incremental algorithm may do: a number of elements,
+	// a time duration, or both (whichever is used up first). A step always processes at least one element.
+	//
+	// example:
+	//      // at most 1000 elements per step
+	//      const auto by_count = fcpp::incremental_budget::elements(1000);
+	//      // about 2 milliseconds per step
+	//      const auto by_time = fcpp::incremental_budget::time(std::chrono::milliseconds(2));
+	class incremental_budget
+	{
+	public:
+		incremental_budget(size_t max_elements, std::chrono::nanoseconds max_duration)
+			: m_max_elements(max_elements), m_max_duration(max_duration)
+		{
+		}
+
+		static incremental_budget elements(size_t count)
+		{
+			return incremental_budget(count, std::chrono::nanoseconds::max());
+		}
+
+		static incremental_budget time(std::chrono::nanoseconds duration)
+		{
+			return incremental_budget(std::numeric_limits<size_t>::max(), duration);
+		}
+
+		// No limit, the algorithm completes in one step
+		static incremental_budget unlimited()
+		{
+			return incremental_budget(std::numeric_limits<size_t>::max(), std::chrono::nanoseconds::max());
+		}
+
+		size_t max_elements() const
+		{
+			return m_max_elements;
+		}
+
+		std::chrono::nanoseconds max_duration() const
+		{
+			return m_max_duration;
+		}
+
+	private:
+		size_t m_max_elements;
+		std::chrono::nanoseconds m_max_duration;
+	};
+
+	// How far an incremental algorithm has come, in units of work (e.g. elements transformed or moved)
+	struct incremental_progress
+	{
+		size_t processed;
+		size_t total;
+
+		bool is_done() const
+		{
+			return processed >= total;
+		}
+
+		// The completed fraction, between 0 and 1
+		double fraction() const
+		{
+			return total == 0 ? 1.0 : static_cast<double>(processed) / static_cast<double>(total);
+		}
+	};
+
+	namespace detail {
+		// Tracks the budget during one step. The clock is read only every few elements, since reading it
+		// can cost more than processing an element.
+		class budget_meter
+		{
+		public:
+			explicit budget_meter(const incremental_budget& budget)
+				: m_remaining_elements(std::max<size_t>(budget.max_elements(), 1)),
+				m_has_deadline(budget.max_duration() != std::chrono::nanoseconds::max()),
+				m_deadline(),
+				m_until_clock_check(clock_check_interval()),
+				m_expired(false)
+			{
+				if (m_has_deadline) {
+					m_deadline = std::chrono::steady_clock::now() + budget.max_duration();
+				}
+			}
+
+			bool has_budget() const
+			{
+				return m_remaining_elements > 0 && !m_expired;
+			}
+
+			void consume()
+			{
+				--m_remaining_elements;
+				if (m_has_deadline && --m_until_clock_check == 0) {
+					m_until_clock_check = clock_check_interval();
+					m_expired = std::chrono::steady_clock::now() >= m_deadline;
+				}
+			}
+
+		private:
+			size_t m_remaining_elements;
+			bool m_has_deadline;
+			std::chrono::steady_clock::time_point m_deadline;
+			size_t m_until_clock_check;
+			bool m_expired;
+
+			static size_t clock_check_interval()
+			{
+				return 64;
+			}
+		};
+
+		// The source vector of an incremental algorithm: an lvalue is referenced, and an rvalue is
+		// moved into shared storage, so that it lives as long as the algorithm (and its copies)
+		template <typename T, typename TAllocator>
+		class incremental_source
+		{
+		public:
+			incremental_source(const vector<T, TAllocator>& source)
+				: m_owned(), m_source(&source)
+			{
+			}
+
+			incremental_source(vector<T, TAllocator>&& source)
+				: m_owned(std::make_shared<const vector<T, TAllocator>>(std::move(source))), m_source(m_owned.get())
+			{
+			}
+
+			size_t size() const
+			{
+				return m_source->size();
+			}
+
+			const T& operator[](size_t index) const
+			{
+				return (*m_source)[index];
+			}
+
+		private:
+			std::shared_ptr<const vector<T, TAllocator>> m_owned;
+			const vector<T, TAllocator>* m_source;
+		};
+	}
+
+	// The common interface of the incremental algorithms: `step` does a bounded amount of work and
+	// returns the progress, and `result` returns the final result once `is_done` is true.
+	// A source vector passed as an lvalue must outlive the algorithm and must not change while it runs,
+	// while an rvalue source is moved into the algorithm.
+	template <typename Derived, typename Result>
+	class incremental_algorithm
+	{
+	public:
+		// Processes elements until the budget is used up or the algorithm is done
+		incremental_progress step(const incremental_budget& budget)
+		{
+			detail::budget_meter meter(budget);
+			static_cast<Derived*>(this)->step_impl(meter);
+			return progress();
+		}
+
+		[[nodiscard]] incremental_progress progress() const
+		{
+			const incremental_progress current = {m_processed, static_cast<const Derived*>(this)->total_work()};
+			return current;
+		}
+
+		[[nodiscard]] bool is_done() const
+		{
+			return progress().is_done();
+		}
+
+		// Completes the remaining work in one step and returns the result
+		[[nodiscard]] Result run_to_completion()
+		{
+			step(incremental_budget::unlimited());
+			return result();
+		}
+
+		// Returns the result, equal to the result of the one-shot algorithm.
+		// The result is moved out, so it can be retrieved once, after the algorithm is done.
+		[[nodiscard]] Result result()
+		{
+			assert(is_done());
+			return static_cast<Derived*>(this)->take_result();
+		}
+
+	protected:
+		incremental_algorithm()
+			: m_processed(0)
+		{
+		}
+
+		size_t m_processed;
+	};
+
+	// The incremental version of vector::map, see map_incremental
+	template <typename T, typename U, typename Transform, typename TAllocator = std::allocator<T>>
+	class incremental_map : public incremental_algorithm<incremental_map<T, U, Transform, TAllocator>, vector<U>>
+	{
+		friend class incremental_algorithm<incremental_map<T, U, Transform, TAllocator>, vector<U>>;
+
+	public:
+		incremental_map(detail::incremental_source<T, TAllocator> source, Transform transform)
+			: m_source(std::move(source)), m_transform(std::move(transform)), m_output()
+		{
+			m_output.reserve(m_source.size());
+		}
+
+	private:
+		detail::incremental_source<T, TAllocator> m_source;
+		Transform m_transform;
+		std::vector<U> m_output;
+
+		size_t total_work() const
+		{
+			return m_source.size();
+		}
+
+		void step_impl(detail::budget_meter& meter)
+		{
+			while (this->m_processed < m_source.size() && meter.has_budget()) {
+				m_output.push_back(m_transform(m_source[this->m_processed]));
+				++this->m_processed;
+				meter.consume();
+			}
+		}
+
+		vector<U> take_result()
+		{
+			return vector<U>(std::move(m_output));
+		}
+	};
+
+	// The incremental version of vector::filtered, see filtered_incremental
+	template <typename T, typename Filter, typename TAllocator = std::allocator<T>>
+	class incremental_filter : public incremental_algorithm<incremental_filter<T, Filter, TAllocator>, vector<T, TAllocator>>
+	{
+		friend class incremental_algorithm<incremental_filter<T, Filter, TAllocator>, vector<T, TAllocator>>;
+
+	public:
+		incremental_filter(detail::incremental_source<T, TAllocator> source, Filter predicate_to_keep)
+			: m_source(std::move(source)), m_predicate(std::move(predicate_to_keep)), m_output()
+		{
+		}
+
+	private:
+		detail::incremental_source<T, TAllocator> m_source;
+		Filter m_predicate;
+		std::vector<T, TAllocator> m_output;
+
+		size_t total_work() const
+		{
+			return m_source.size();
+		}
+
+		void step_impl(detail::budget_meter& meter)
+		{
+			while (this->m_processed < m_source.size() && meter.has_budget()) {
+				const auto& element = m_source[this->m_processed];
+				if (m_predicate(element)) {
+					m_output.push_back(element);
+				}
+				++this->m_processed;
+				meter.consume();
+			}
+		}
+
+		vector<T, TAllocator> take_result()
+		{
+			return vector<T, TAllocator>(std::move(m_output));
+		}
+	};
+
+	// The incremental version of vector::reduce, see reduce_incremental
+	template <typename T, typename U, typename Reduce, typename TAllocator = std::allocator<T>>
+	class incremental_reduce : public incremental_algorithm<incremental_reduce<T, U, Reduce, TAllocator>, U>
+	{
+		friend class incremental_algorithm<incremental_reduce<T, U, Reduce, TAllocator>, U>;
+
+	public:
+		incremental_reduce(detail::incremental_source<T, TAllocator> source, const U& initial, Reduce reduction)
+			: m_source(std::move(source)), m_reduction(std::move(reduction)), m_result(initial)
+		{
+		}
+
+	private:
+		detail::incremental_source<T, TAllocator> m_source;
+		Reduce m_reduction;
+		U m_result;
+
+		size_t total_work() const
+		{
+			return m_source.size();
+		}
+
+		void step_impl(detail::budget_meter& meter)
+		{
+			while (this->m_processed < m_source.size() && meter.has_budget()) {
+				m_result = m_reduction(m_result, m_source[this->m_processed]);
+				++this->m_processed;
+				meter.consume();
+			}
+		}
+
+		U take_result()
+		{
+			return std::move(m_result);
+		}
+	};
+
+	// The incremental version of vector::distinct, see distinct_incremental
+	template <typename T, typename TCompare, typename TAllocator = std::allocator<T>>
+	class incremental_distinct : public incremental_algorithm<incremental_distinct<T, TCompare, TAllocator>, set<T, TCompare>>
+	{
+		friend class incremental_algorithm<incremental_distinct<T, TCompare, TAllocator>, set<T, TCompare>>;
+
+	public:
+		explicit incremental_distinct(detail::incremental_source<T, TAllocator> source)
+			: m_source(std::move(source)), m_keys()
+		{
+		}
+
+	private:
+		detail::incremental_source<T, TAllocator> m_source;
+		std::set<T, TCompare> m_keys;
+
+		size_t total_work() const
+		{
+			return m_source.size();
+		}
+
+		void step_impl(detail::budget_meter& meter)
+		{
+			while (this->m_processed < m_source.size() && meter.has_budget()) {
+				m_keys.insert(m_source[this->m_processed]);
+				++this->m_processed;
+				meter.consume();
+			}
+		}
+
+		set<T, TCompare> take_result()
+		{
+			return set<T, TCompare>(std::move(m_keys));
+		}
+	};
+
+	// The incremental version of vector::sorted, see sorted_incremental.
+	//
+	// A bottom-up merge sort whose state can be suspended after any element: first the elements are
+	// copied in short runs which are sorted with insertion sort, then the runs are merged pairwise in
+	// passes of doubling width, alternating between two buffers. Each copied or merged element is one
+	// unit of work, so the total work is n * (1 + number of merge passes). The sort is stable.
+	template <typename T, typename Sortable, typename TAllocator = std::allocator<T>>
+	class incremental_sort : public incremental_algorithm<incremental_sort<T, Sortable, TAllocator>, vector<T, TAllocator>>
+	{
+		friend class incremental_algorithm<incremental_sort<T, Sortable, TAllocator>, vector<T, TAllocator>>;
+
+	public:
+		incremental_sort(detail::incremental_source<T, TAllocator> source, Sortable comparison)
+			: m_source(std::move(source)),
+			m_comparison(std::move(comparison)),
+			m_sorted_runs(),
+			m_merged(),
+			m_width(run_length()),
+			m_left(0),
+			m_mid(0),
+			m_right(0),
+			m_next_left(0),
+			m_next_right(0),
+			m_merging_pair(false)
+		{
+			m_sorted_runs.reserve(m_source.size());
+		}
+
+	private:
+		detail::incremental_source<T, TAllocator> m_source;
+		Sortable m_comparison;
+		// the runs of the current pass, and the output of the current pass
+		std::vector<T, TAllocator> m_sorted_runs;
+		std::vector<T, TAllocator> m_merged;
+		// the merge of the pair [m_left, m_mid) and [m_mid, m_right), which continues at m_next_left and m_next_right
+		size_t m_width;
+		size_t m_left;
+		size_t m_mid;
+		size_t m_right;
+		size_t m_next_left;
+		size_t m_next_right;
+		bool m_merging_pair;
+
+		static size_t run_length()
+		{
+			return 32;
+		}
+
+		size_t total_work() const
+		{
+			const auto n = m_source.size();
+			size_t passes = 0;
+			for (auto width = run_length(); width < n; width *= 2) {
+				++passes;
+			}
+			return n * (1 + passes);
+		}
+
+		void step_impl(detail::budget_meter& meter)
+		{
+			const auto n = m_source.size();
+			while (m_sorted_runs.size() < n && meter.has_budget()) {
+				copy_and_sort_next_run(meter);
+			}
+			while (m_width < n && meter.has_budget()) {
+				if (!m_merging_pair) {
+					start_next_pair();
+				}
+				merge_pair(meter);
+			}
+		}
+
+		// Copies up to `run_length` elements and sorts them with insertion sort (stable)
+		void copy_and_sort_next_run(detail::budget_meter& meter)
+		{
+			const auto run_start = m_sorted_runs.size() - m_sorted_runs.size() % run_length();
+			while (m_sorted_runs.size() < m_source.size() && meter.has_budget()) {
+				auto position = m_sorted_runs.size();
+				m_sorted_runs.push_back(m_source[position]);
+				for (; position > run_start && m_comparison(m_sorted_runs[position], m_sorted_runs[position - 1]); --position) {
+					std::swap(m_sorted_runs[position], m_sorted_runs[position - 1]);
+				}
+				++this->m_processed;
+				meter.consume();
+				if (m_sorted_runs.size() % run_length() == 0) {
+					return;
+				}
+			}
+		}
+
+		// Selects the next pair of runs of the current pass
+		void start_next_pair()
+		{
+			const auto n = m_sorted_runs.size();
+			if (m_merged.capacity() < n) {
+				m_merged.reserve(n);
+			}
+			m_mid = std::min(m_left + m_width, n);
+			m_right = std::min(m_left + 2 * m_width, n);
+			m_next_left = m_left;
+			m_next_right = m_mid;
+			m_merging_pair = true;
+		}
+
+		// The merged runs become the runs of the next pass, which have double width
+		void finish_pass()
+		{
+			m_sorted_runs.swap(m_merged);
+			m_merged.clear();
+			m_width *= 2;
+			m_left = 0;
+		}
+
+		void merge_pair(detail::budget_meter& meter)
+		{
+			while ((m_next_left < m_mid || m_next_right < m_right) && meter.has_budget()) {
+				// take from the right run only if strictly smaller, which keeps the sort stable
+				if (m_next_left < m_mid && (m_next_right >= m_right || !m_comparison(m_sorted_runs[m_next_right], m_sorted_runs[m_next_left]))) {
+					m_merged.push_back(std::move(m_sorted_runs[m_next_left++]));
+				} else {
+					m_merged.push_back(std::move(m_sorted_runs[m_next_right++]));
+				}
+				++this->m_processed;
+				meter.consume();
+			}
+			if (m_next_left == m_mid && m_next_right == m_right) {
+				m_merging_pair = false;
+				m_left = m_right;
+				if (m_left == m_sorted_runs.size()) {
+					finish_pass();
+				}
+			}
+		}
+
+		vector<T, TAllocator> take_result()
+		{
+			return vector<T, TAllocator>(std::move(m_sorted_runs));
+		}
+	};
+
+	// Returns a resumable version of the `map` algorithm for latency-sensitive loops: each call to
+	// `step(budget)` transforms elements until the budget (an element count or a time duration)
+	// is used up, and `result()` returns the same vector as `map` once the algorithm is done.
+	// A source passed as an lvalue must outlive the algorithm and must not change meanwhile,
+	// while an rvalue source is moved into the algorithm.
+	//
+	// example:
+	//      const fcpp::vector<int> input_vector({ 1, 3, -5 });
+	//      auto squares = fcpp::map_incremental<int>(input_vector, [](const auto& element) {
+	//          return element * element;
+	//      });
+	//      while (!squares.step(fcpp::incremental_budget::time(std::chrono::milliseconds(2))).is_done()) {
+	//          // render the next frame
+	//      }
+	//
+	// outcome:
+	//      squares.result() -> fcpp::vector<int>({ 1, 9, 25 })
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename T, typename Transform, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename T, typename Transform, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_map<T, U, typename std::decay<Transform>::type, TAllocator> map_incremental(const vector<T, TAllocator>& source, Transform&& transform)
+	{
+		return incremental_map<T, U, typename std::decay<Transform>::type, TAllocator>(source, std::forward<Transform>(transform));
+	}
+
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename T, typename Transform, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename T, typename Transform, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_map<T, U, typename std::decay<Transform>::type, TAllocator> map_incremental(vector<T, TAllocator>&& source, Transform&& transform)
+	{
+		return incremental_map<T, U, typename std::decay<Transform>::type, TAllocator>(std::move(source), std::forward<Transform>(transform));
+	}
+
+	// Returns a resumable version of the `filtered` algorithm, see map_incremental
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename Callable, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+#else
+	template <typename T, typename Callable, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_filter<T, typename std::decay<Callable>::type, TAllocator> filtered_incremental(const vector<T, TAllocator>& source, Callable&& predicate_to_keep)
+	{
+		return incremental_filter<T, typename std::decay<Callable>::type, TAllocator>(source, std::forward<Callable>(predicate_to_keep));
+	}
+
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename Callable, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+#else
+	template <typename T, typename Callable, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_filter<T, typename std::decay<Callable>::type, TAllocator> filtered_incremental(vector<T, TAllocator>&& source, Callable&& predicate_to_keep)
+	{
+		return incremental_filter<T, typename std::decay<Callable>::type, TAllocator>(std::move(source), std::forward<Callable>(predicate_to_keep));
+	}
+
+	// Returns a resumable version of the `reduce` algorithm, see map_incremental
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename U, typename Reduce, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, T>>>
+#else
+	template <typename T, typename U, typename Reduce, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_reduce<T, U, typename std::decay<Reduce>::type, TAllocator> reduce_incremental(const vector<T, TAllocator>& source, const U& initial, Reduce&& reduction)
+	{
+		return incremental_reduce<T, U, typename std::decay<Reduce>::type, TAllocator>(source, initial, std::forward<Reduce>(reduction));
+	}
+
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename U, typename Reduce, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, T>>>
+#else
+	template <typename T, typename U, typename Reduce, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_reduce<T, U, typename std::decay<Reduce>::type, TAllocator> reduce_incremental(vector<T, TAllocator>&& source, const U& initial, Reduce&& reduction)
+	{
+		return incremental_reduce<T, U, typename std::decay<Reduce>::type, TAllocator>(std::move(source), initial, std::forward<Reduce>(reduction));
+	}
+
+	// Returns a resumable version of the `sorted` algorithm, see map_incremental.
+	// It is a bottom-up merge sort which can pause after any element, and it is stable: elements which are
+	// equivalent according to the comparison keep their relative order.
+	//
+	// example:
+	//      const fcpp::vector<int> numbers({ 3, 1, 9, -4 });
+	//      auto sorting = fcpp::sorted_incremental(numbers, std::less<int>());
+	//      while (!sorting.step(fcpp::incremental_budget::elements(2)).is_done()) {
+	//      }
+	//
+	// outcome:
+	//      sorting.result() -> fcpp::vector<int>({ -4, 1, 3, 9 })
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename Sortable, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<bool, Sortable, T, T>>>
+#else
+	template <typename T, typename Sortable, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_sort<T, typename std::decay<Sortable>::type, TAllocator> sorted_incremental(const vector<T, TAllocator>& source, Sortable&& comparison_predicate)
+	{
+		return incremental_sort<T, typename std::decay<Sortable>::type, TAllocator>(source, std::forward<Sortable>(comparison_predicate));
+	}
+
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename Sortable, typename TAllocator, typename = std::enable_if_t<std::is_invocable_r_v<bool, Sortable, T, T>>>
+#else
+	template <typename T, typename Sortable, typename TAllocator>
+#endif
+	[[nodiscard]] incremental_sort<T, typename std::decay<Sortable>::type, TAllocator> sorted_incremental(vector<T, TAllocator>&& source, Sortable&& comparison_predicate)
+	{
+		return incremental_sort<T, typename std::decay<Sortable>::type, TAllocator>(std::move(source), std::forward<Sortable>(comparison_predicate));
+	}
+
+	// Returns a resumable version of the `distinct` algorithm, see map_incremental
+	template <typename T, typename UCompare = std::less<T>, typename TAllocator>
+	[[nodiscard]] incremental_distinct<T, UCompare, TAllocator> distinct_incremental(const vector<T, TAllocator>& source)
+	{
+		return incremental_distinct<T, UCompare, TAllocator>(source);
+	}
+
+	template <typename T, typename UCompare = std::less<T>, typename TAllocator>
+	[[nodiscard]] incremental_distinct<T, UCompare, TAllocator> distinct_incremental(vector<T, TAllocator>&& source)
+	{
+		return incremental_distinct<T, UCompare, TAllocator>(std::move(source));
+	}
+}
@@ -0,0 +1,565 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include "set.h"
+#include "vector.h"
+
+namespace fcpp {
+	// The type of the key projected by KeyFn from an element of type TKey
+	template <class TKey, class KeyFn>
+	using projected_key_t = typename std::decay<decltype(std::declval<const KeyFn&>()(std::declval<const TKey&>()))>::type;
+
+	// A set whose elements are ordered and deduplicated by a key projected from each element.
+	// The projection (KeyFn) is computed exactly once per element when it enters the set, and is
+	// cached next to the element, so that all subsequent comparisons only compare cached keys.
+	// This is useful when comparing two elements is expensive (eg. hashing a string member),
+	// since a regular fcpp::set would recompute the comparison O(log n) times per insert/lookup.
+	//
+	// Two elements with equal projected keys are considered equal; the first one inserted is kept.
+	//
+	// example:
+	//      struct person_hash {
+	//          std::size_t operator()(const person& p) const {
+	//              return p.hash();
+	//          }
+	//      };
+	//      fcpp::keyed_set<person, person_hash> persons({ person(15, "Jake"), person(18, "Jannet") });
+	//      persons.contains(person(15, "Jake")); // true, person_hash is called once for the query
+	template <class TKey, class KeyFn, class TKeyCompare = std::less<projected_key_t<TKey, KeyFn>>>
+	class keyed_set
+	{
+	public:
+		typedef projected_key_t<TKey, KeyFn> key_type;
+
+	private:
+		typedef std::map<key_type, TKey, TKeyCompare> storage_type;
+
+	public:
+		// A bidirectional iterator over the elements of the set, in the order of their projected keys
+		class const_iterator
+		{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef TKey value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TKey* pointer;
+			typedef const TKey& reference;
+
+			const_iterator()
+				: m_it()
+			{
+			}
+
+			explicit const_iterator(typename storage_type::const_iterator it)
+				: m_it(it)
+			{
+			}
+
+			reference operator*() const
+			{
+				return m_it->second;
+			}
+
+			pointer operator->() const
+			{
+				return &m_it->second;
+			}
+
+			// Returns the cached projected key of the current element
+			const key_type& key() const
+			{
+				return m_it->first;
+			}
+
+			const_iterator& operator++()
+			{
+				++m_it;
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator copy(*this);
+				++m_it;
+				return copy;
+			}
+
+			const_iterator& operator--()
+			{
+				--m_it;
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator copy(*this);
+				--m_it;
+				return copy;
+			}
+
+			bool operator ==(const const_iterator& rhs) const
+			{
+				return m_it == rhs.m_it;
+			}
+
+			bool operator !=(const const_iterator& rhs) const
+			{
+				return m_it != rhs.m_it;
+			}
+
+		private:
+			typename storage_type::const_iterator m_it;
+		};
+
+		keyed_set()
+			: m_key_fn(), m_map()
+		{
+		}
+
+		explicit keyed_set(KeyFn key_fn)
+			: m_key_fn(std::move(key_fn)), m_map()
+		{
+		}
+
+		explicit keyed_set(const std::vector<TKey>& vector)
+			: m_key_fn(), m_map()
+		{
+			insert_range_impl(vector.begin(), vector.end());
+		}
+
+		explicit keyed_set(const vector<TKey>& vector)
+			: m_key_fn(), m_map()
+		{
+			insert_range_impl(vector.begin(), vector.end());
+		}
+
+		explicit keyed_set(const std::initializer_list<TKey>& list)
+			: m_key_fn(), m_map()
+		{
+			insert_range_impl(list.begin(), list.end());
+		}
+
+		// Constructors projecting the elements with the given key function, for stateful
+		// projections which are not default constructible (eg. a capturing lambda)
+		keyed_set(const std::vector<TKey>& vector, KeyFn key_fn)
+			: m_key_fn(std::move(key_fn)), m_map()
+		{
+			insert_range_impl(vector.begin(), vector.end());
+		}
+
+		keyed_set(const vector<TKey>& vector, KeyFn key_fn)
+			: m_key_fn(std::move(key_fn)), m_map()
+		{
+			insert_range_impl(vector.begin(), vector.end());
+		}
+
+		keyed_set(const std::initializer_list<TKey>& list, KeyFn key_fn)
+			: m_key_fn(std::move(key_fn)), m_map()
+		{
+			insert_range_impl(list.begin(), list.end());
+		}
+
+		// Returns the set of elements which belong to the current set but not in the other set,
+		// comparing only the cached projected keys (see fcpp::set::difference_with)
+		//
+		// example:
+		//      const fcpp::keyed_set<person, person_hash> set1({person(51, "George"), person(15, "Jake")});
+		//      const fcpp::keyed_set<person, person_hash> set2({person(51, "George")});
+		//      const auto& diff = set1.difference_with(set2);
+		//
+		// outcome:
+		//      diff -> fcpp::keyed_set<person, person_hash>({person(15, "Jake")})
+		[[nodiscard]] keyed_set difference_with(const keyed_set& other) const
+		{
+			keyed_set diff(m_key_fn);
+			std::set_difference(m_map.begin(),
+			                    m_map.end(),
+			                    other.m_map.begin(),
+			                    other.m_map.end(),
+			                    std::inserter(diff.m_map, diff.m_map.end()),
+			                    cached_key_compare(m_map.key_comp()));
+			return diff;
+		}
+
+		// Returns the set of elements which belong either to the current or the other set,
+		// comparing only the cached projected keys (see fcpp::set::union_with)
+		[[nodiscard]] keyed_set union_with(const keyed_set& other) const
+		{
+			keyed_set combined(m_key_fn);
+			std::set_union(m_map.begin(),
+			               m_map.end(),
+			               other.m_map.begin(),
+			               other.m_map.end(),
+			               std::inserter(combined.m_map, combined.m_map.end()),
+			               cached_key_compare(m_map.key_comp()));
+			return combined;
+		}
+
+		// Returns the set of elements which belong to both the current and the other set,
+		// comparing only the cached projected keys (see fcpp::set::intersect_with)
+		[[nodiscard]] keyed_set intersect_with(const keyed_set& other) const
+		{
+			keyed_set intersection(m_key_fn);
+			std::set_intersection(m_map.begin(),
+			                      m_map.end(),
+			                      other.m_map.begin(),
+			                      other.m_map.end(),
+			                      std::inserter(intersection.m_map, intersection.m_map.end()),
+			                      cached_key_compare(m_map.key_comp()));
+			return intersection;
+		}
+
+		// Returns the element with the smallest projected key, if the set is not empty.
+		// Since the elements are ordered by their cached keys, this is O(1).
+		[[nodiscard]] fcpp::optional_t<TKey> min() const
+		{
+			if (m_map.empty()) {
+				return fcpp::optional_t<TKey>();
+			}
+			return m_map.begin()->second;
+		}
+
+		// Returns the element with the largest projected key, if the set is not empty.
+		// Since the elements are ordered by their cached keys, this is O(1).
+		[[nodiscard]] fcpp::optional_t<TKey> max() const
+		{
+			if (m_map.empty()) {
+				return fcpp::optional_t<TKey>();
+			}
+			return m_map.rbegin()->second;
+		}
+
+		// Performs the functional `map` algorithm, in which every element of the resulting set is the
+		// output of applying the transform function on every element of this instance.
+		//
+		// example:
+		//      const fcpp::keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+		//      const auto names = persons.map<std::string>([](const person& p) {
+		//          return p.name;
+		//      });
+		//
+		// outcome:
+		//      names -> fcpp::set<std::string>({ "Jake", "Jannet" })
+#ifdef CPP17_AVAILABLE
+		template <class UKey, class UCompare = std::less<UKey>, typename Transform, typename = std::enable_if_t<
+			          std::is_invocable_r_v<UKey, Transform, TKey>>>
+#else
+		template <typename UKey, class UCompare = std::less<UKey>, typename Transform>
+#endif
+		set<UKey, UCompare> map(Transform&& transform) const
+		{
+			std::set<UKey, UCompare> transformed_set;
+			for (const auto& entry : m_map) {
+				transformed_set.insert(transform(entry.second));
+			}
+			return set<UKey, UCompare>(std::move(transformed_set));
+		}
+
+		// Returns true if all elements match the predicate (return true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool all_of(Callable&& unary_predicate) const
+		{
+			return std::all_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if at least one element matches the predicate (returns true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool any_of(Callable&& unary_predicate) const
+		{
+			return std::any_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if none of the elements match the predicate (all return false)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool none_of(Callable&& unary_predicate) const
+		{
+			return std::none_of(begin(),
+			                    end(),
+			                    std::forward<Callable>(unary_predicate));
+		}
+
+		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
+		// accumulating all the elements of the set to an initial value, in the order of their keys (non-mutating)
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TKey>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (const auto& entry : m_map) {
+				result = reduction(result, entry.second);
+			}
+			return result;
+		}
+
+		// Performs the functional `filter` algorithm, in which all elements of this instance
+		// which match the given predicate are kept (mutating). The cached keys are not recomputed.
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		keyed_set& filter(Filter&& predicate_to_keep)
+		{
+			auto it = m_map.begin();
+			while (it != m_map.end()) {
+				if (predicate_to_keep(it->second)) {
+					++it;
+				} else {
+					it = m_map.erase(it);
+				}
+			}
+			return *this;
+		}
+
+		// Performs the functional `filter` algorithm in a copy of this instance, in which all elements
+		// of the copy which match the given predicate are kept (non-mutating)
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		keyed_set filtered(Filter&& predicate_to_keep) const
+		{
+			keyed_set copy(m_key_fn);
+			for (const auto& entry : m_map) {
+				if (predicate_to_keep(entry.second)) {
+					copy.m_map.emplace_hint(copy.m_map.end(), entry.first, entry.second);
+				}
+			}
+			return copy;
+		}
+
+		// Executes the given operation for each element of the set, in the order of their keys.
+		// The operation must not change the set's contents during execution.
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, TKey const&>>>
+#else
+		template <typename Callable>
+#endif
+		const keyed_set& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(),
+			              end(),
+			              std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns all elements of the set in a vector, in the order of their keys
+		vector<TKey> keys() const
+		{
+			vector<TKey> vec;
+			vec.reserve(size());
+			for (const auto& entry : m_map) {
+				vec.insert_back(entry.second);
+			}
+			return vec;
+		}
+
+		// Removes the element whose projected key equals the given element's key, if it exists (mutating)
+		//
+		// example:
+		//      fcpp::keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+		//      persons.remove(person(15, "Jake"));
+		//
+		// outcome:
+		//      persons -> fcpp::keyed_set<person, person_hash>({person(18, "Jannet")})
+		keyed_set& remove(const TKey& element)
+		{
+			m_map.erase(m_key_fn(element));
+			return *this;
+		}
+
+		// Returns a copy by removing the element whose projected key equals the given element's key (non-mutating)
+		[[nodiscard]] keyed_set removing(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.remove(element);
+			return copy;
+		}
+
+		// Inserts an element in the set, if no element with the same projected key exists (mutating).
+		// The projected key is computed once and cached for the lifetime of the element in the set.
+		//
+		// example:
+		//      fcpp::keyed_set<person, person_hash> persons({person(15, "Jake")});
+		//      persons.insert(person(18, "Jannet"));
+		//
+		// outcome:
+		//      persons -> fcpp::keyed_set<person, person_hash>({person(15, "Jake"), person(18, "Jannet")})
+		keyed_set& insert(const TKey& element)
+		{
+			m_map.emplace(m_key_fn(element), element);
+			return *this;
+		}
+
+		// Returns a copy by inserting an element in the set, if no element with the same projected key exists (non-mutating)
+		[[nodiscard]] keyed_set inserting(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.insert(element);
+			return copy;
+		}
+
+		// Removes all elements from the set (mutating)
+		keyed_set& clear()
+		{
+			m_map.clear();
+			return *this;
+		}
+
+		// Returns a new set by clearing all elements from the current set (non-mutating)
+		[[nodiscard]] keyed_set clearing() const
+		{
+			return keyed_set(m_key_fn);
+		}
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_map.empty();
+		}
+
+		// Returns true if an element with the same projected key as the given element is present.
+		// The projection is computed once for the query, and only cached keys are compared.
+		//
+		// example:
+		//      const fcpp::keyed_set<person, person_hash> persons({person(15, "Jake")});
+		//      persons.contains(person(15, "Jake")); // true
+		//      persons.contains(person(18, "Jannet")); // false
+		[[nodiscard]] bool contains(const TKey& element) const
+		{
+			return contains_key(m_key_fn(element));
+		}
+
+		// Returns true if an element with the given projected key is present, without computing any projection
+		[[nodiscard]] bool contains_key(const key_type& key) const
+		{
+			return m_map.count(key) != 0;
+		}
+
+		// Returns the size of the set (how many elements it contains)
+		[[nodiscard]] size_t size() const
+		{
+			return m_map.size();
+		}
+
+		// Returns the const begin iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator begin() const
+		{
+			return const_iterator(m_map.begin());
+		}
+
+		// Returns the const end iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator end() const
+		{
+			return const_iterator(m_map.end());
+		}
+
+		// Returns the element at the given position, in the order of their keys.
+		// Bounds checking (assert) is enabled for debug builds.
+		// Performance is O(n), so be careful for performance critical code sections.
+		TKey operator[](size_t index) const
+		{
+			assert(index < size());
+			auto it = begin();
+			std::advance(it, index);
+			return *it;
+		}
+
+		// Returns true if both instances have equal sizes and the corresponding cached keys are equal
+		bool operator ==(const keyed_set& rhs) const
+		{
+			if (size() != rhs.size()) {
+				return false;
+			}
+			const auto& compare = m_map.key_comp();
+			auto it1 = m_map.begin();
+			auto it2 = rhs.m_map.begin();
+			for (; it1 != m_map.end(); ++it1, ++it2) {
+				if (compare(it1->first, it2->first) || compare(it2->first, it1->first)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Returns false if either the sizes are not equal or at least one corresponding cached key is not equal
+		bool operator !=(const keyed_set& rhs) const
+		{
+			return !((*this) == rhs);
+		}
+
+	private:
+		KeyFn m_key_fn;
+		storage_type m_map;
+
+		// Orders the map entries by their cached keys only, used by the set algebra algorithms
+		struct cached_key_compare
+		{
+			explicit cached_key_compare(TKeyCompare compare)
+				: compare(std::move(compare))
+			{
+			}
+
+			bool operator()(const typename storage_type::value_type& a,
+			                const typename storage_type::value_type& b) const
+			{
+				return compare(a.first, b.first);
+			}
+
+			TKeyCompare compare;
+		};
+
+		template <typename Iterator>
+		void insert_range_impl(const Iterator& range_begin, const Iterator& range_end)
+		{
+			for (auto it = range_begin; it != range_end; ++it) {
+				insert(*it);
+			}
+		}
+	};
+}
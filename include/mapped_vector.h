@@ -0,0 +1,431 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "export_def.h"
+#include "vector.h"
+
+namespace fcpp {
+	namespace detail {
+		// Buffers of at least this many bytes are memory mapped, smaller ones come from malloc
+		inline size_t mapped_storage_threshold()
+		{
+			return size_t(1) << 20;
+		}
+
+		// Returns true if a buffer of this capacity (in bytes) is memory mapped
+		inline bool is_mapped_storage(size_t capacity_in_bytes)
+		{
+			return capacity_in_bytes >= mapped_storage_threshold();
+		}
+
+		// Resizes a buffer of `old_size` bytes (nullptr if 0) to `new_size` bytes, keeping its contents.
+		// Mapped buffers grow with mremap on Linux, which moves the pages instead of copying them.
+		// Throws std::bad_alloc on failure, in which case the buffer is left untouched.
+		FunctionalCppExport void* storage_reallocate(void* buffer, size_t old_size, size_t new_size);
+
+		FunctionalCppExport void storage_deallocate(void* buffer, size_t size);
+
+		// Bitwise storage for trivially copyable elements, whose buffer is resized in place
+		template <typename T, bool = std::is_trivially_copyable<T>::value>
+		class growable_storage
+		{
+		public:
+			growable_storage()
+				: m_data(nullptr), m_size(0), m_capacity(0)
+			{
+			}
+
+			growable_storage(const growable_storage&) = delete;
+			growable_storage& operator =(const growable_storage&) = delete;
+
+			~growable_storage()
+			{
+				storage_deallocate(m_data, m_capacity * sizeof(T));
+			}
+
+			T* data() const
+			{
+				return m_data;
+			}
+
+			size_t size() const
+			{
+				return m_size;
+			}
+
+			size_t capacity() const
+			{
+				return m_capacity;
+			}
+
+			bool is_mapped() const
+			{
+				return is_mapped_storage(m_capacity * sizeof(T));
+			}
+
+			void reserve(size_t count)
+			{
+				if (count <= m_capacity) {
+					return;
+				}
+				m_data = static_cast<T*>(storage_reallocate(m_data, m_capacity * sizeof(T), count * sizeof(T)));
+				m_capacity = count;
+			}
+
+			void push_back(const T& element)
+			{
+				if (m_size == m_capacity) {
+					// the element may live in the buffer which is about to move
+					const T copy(element);
+					grow(m_size + 1);
+					new (m_data + m_size) T(copy);
+				} else {
+					new (m_data + m_size) T(element);
+				}
+				++m_size;
+			}
+
+			void append(const T* first, size_t count)
+			{
+				if (m_size + count > m_capacity) {
+					// elements which live in the buffer move with it, so they are found again by their offset
+					const std::less<const T*> before;
+					const bool is_own_range = count > 0 && !before(first, m_data) && before(first, m_data + m_size);
+					const auto offset = is_own_range ? static_cast<size_t>(first - m_data) : 0;
+					grow(m_size + count);
+					if (is_own_range) {
+						first = m_data + offset;
+					}
+					std::memcpy(static_cast<void*>(m_data + m_size), first, count * sizeof(T));
+				} else if (count > 0) {
+					std::memmove(static_cast<void*>(m_data + m_size), first, count * sizeof(T));
+				}
+				m_size += count;
+			}
+
+			void resize(size_t count)
+			{
+				grow(count);
+				for (auto i = m_size; i < count; ++i) {
+					new (m_data + i) T();
+				}
+				m_size = count;
+			}
+
+			void pop_back()
+			{
+				--m_size;
+			}
+
+			void clear()
+			{
+				m_size = 0;
+			}
+
+		private:
+			T* m_data;
+			size_t m_size;
+			size_t m_capacity;
+
+			// Doubles the capacity until it fits `count` elements
+			void grow(size_t count)
+			{
+				if (count <= m_capacity) {
+					return;
+				}
+				auto capacity = m_capacity > 0 ? m_capacity : 16;
+				while (capacity < count) {
+					capacity *= 2;
+				}
+				reserve(capacity);
+			}
+		};
+
+		// Other elements need their copy or move constructors, so they are kept in a std::vector
+		template <typename T>
+		class growable_storage<T, false>
+		{
+		public:
+			T* data()
+			{
+				return m_elements.data();
+			}
+
+			const T* data() const
+			{
+				return m_elements.data();
+			}
+
+			size_t size() const
+			{
+				return m_elements.size();
+			}
+
+			size_t capacity() const
+			{
+				return m_elements.capacity();
+			}
+
+			bool is_mapped() const
+			{
+				return false;
+			}
+
+			void reserve(size_t count)
+			{
+				m_elements.reserve(count);
+			}
+
+			void push_back(const T& element)
+			{
+				m_elements.push_back(element);
+			}
+
+			void append(const T* first, size_t count)
+			{
+				std::vector<T> copy(first, first + count);
+				m_elements.insert(m_elements.end(),
+				                  std::make_move_iterator(copy.begin()),
+				                  std::make_move_iterator(copy.end()));
+			}
+
+			void resize(size_t count)
+			{
+				m_elements.resize(count);
+			}
+
+			void pop_back()
+			{
+				m_elements.pop_back();
+			}
+
+			void clear()
+			{
+				m_elements.clear();
+			}
+
+		private:
+			std::vector<T> m_elements;
+		};
+	}
+
+	// A vector for very large numbers of trivially copyable elements, which usually grows without copying them.
+	// Buffers of at least 1MB are memory mapped, and grown with mremap on Linux: the kernel moves the
+	// existing pages to the larger mapping instead of copying every byte into a new buffer, which avoids
+	// most of the copying of a growing multi-GB vector. The buffer is still copied once when it first
+	// becomes mapped, and on every growth on platforms without mremap. Other element types are stored
+	// in a std::vector, as their constructors must run when they are moved.
+	//
+	// The elements are appended and read here, and map, reduce and for_each run directly on the buffer.
+	//
+	// example:
+	//      fcpp::mapped_vector<double> samples;
+	//      for (size_t i = 0; i < 500000000; ++i) {
+	//          samples.insert_back(read_sample(i));
+	//      }
+	//      const auto total = samples.reduce(0.0, std::plus<double>());
+	//
+	// outcome:
+	//      samples.is_mapped() -> true
+	template <typename T>
+	class mapped_vector
+	{
+	public:
+		mapped_vector()
+		{
+		}
+
+		explicit mapped_vector(const vector<T>& elements)
+		{
+			insert_back(elements);
+		}
+
+		mapped_vector(const mapped_vector&) = delete;
+		mapped_vector& operator =(const mapped_vector&) = delete;
+
+		// Returns the number of elements
+		[[nodiscard]] size_t size() const
+		{
+			return m_storage.size();
+		}
+
+		// Returns how many elements fit before the buffer grows
+		[[nodiscard]] size_t capacity() const
+		{
+			return m_storage.capacity();
+		}
+
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_storage.size() == 0;
+		}
+
+		// Returns true if the elements are stored in a memory mapped buffer, which grows without copying
+		[[nodiscard]] bool is_mapped() const
+		{
+			return m_storage.is_mapped();
+		}
+
+		T& operator[](size_t index)
+		{
+			assert(index < size());
+			return m_storage.data()[index];
+		}
+
+		const T& operator[](size_t index) const
+		{
+			assert(index < size());
+			return m_storage.data()[index];
+		}
+
+		T* begin()
+		{
+			return m_storage.data();
+		}
+
+		const T* begin() const
+		{
+			return m_storage.data();
+		}
+
+		T* end()
+		{
+			return m_storage.data() + size();
+		}
+
+		const T* end() const
+		{
+			return m_storage.data() + size();
+		}
+
+		// Inserts an element at the end (mutating)
+		mapped_vector& insert_back(const T& element)
+		{
+			m_storage.push_back(element);
+			return *this;
+		}
+
+		// Inserts the elements of the vector at the end (mutating)
+		mapped_vector& insert_back(const vector<T>& elements)
+		{
+			if (!elements.is_empty()) {
+				m_storage.append(&elements[0], elements.size());
+			}
+			return *this;
+		}
+
+		// Removes the last element, if present (mutating)
+		mapped_vector& remove_back()
+		{
+			if (!is_empty()) {
+				m_storage.pop_back();
+			}
+			return *this;
+		}
+
+		// Makes room for at least `count` elements (mutating)
+		mapped_vector& reserve(size_t count)
+		{
+			m_storage.reserve(count);
+			return *this;
+		}
+
+		// Changes the number of elements, the new elements are value initialized (mutating)
+		mapped_vector& resize(size_t count)
+		{
+			m_storage.resize(count);
+			return *this;
+		}
+
+		// Removes all elements, the capacity is kept (mutating)
+		mapped_vector& clear()
+		{
+			m_storage.clear();
+			return *this;
+		}
+
+		// Performs the functional `map` algorithm on the elements in place, only the output is allocated.
+		// See also fcpp::vector::map for more documentation.
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+		template <typename U, typename Transform>
+#endif
+		vector<U> map(Transform&& transform) const
+		{
+			std::vector<U> transformed_vector;
+			transformed_vector.reserve(size());
+			std::transform(begin(), end(), std::back_inserter(transformed_vector), std::forward<Transform>(transform));
+			return vector<U>(std::move(transformed_vector));
+		}
+
+		// Performs the functional `reduce` algorithm on the elements in place.
+		// See also fcpp::vector::reduce for more documentation.
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, T>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (const auto& element : *this) {
+				result = reduction(result, element);
+			}
+			return result;
+		}
+
+		// Executes the given operation for each element. The operation must not change the vector's contents.
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, T const&>>>
+#else
+		template <typename Callable>
+#endif
+		const mapped_vector& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(), end(), std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns a copy of the elements as an fcpp::vector, for the algorithms which mapped_vector does not
+		// offer. The copy needs as much memory as the elements, so prefer map, reduce and for_each on huge vectors.
+		[[nodiscard]] vector<T> to_vector() const
+		{
+			return vector<T>(std::vector<T>(begin(), end()));
+		}
+
+	private:
+		detail::growable_storage<T> m_storage;
+	};
+}
@@ -0,0 +1,339 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "hashing.h"
+#include "optional.h"
+#include "vector.h"
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+#include <algorithm>
+#include <execution>
+#include <thread>
+#endif
+
+namespace fcpp {
+
+	// A thread-safe cache of transform results with a bounded number of entries, for memoizing an
+	// expensive transform across calls (see map_memoized).
+	//
+	// The entries are distributed over shards by the hash of their key, every shard has its own mutex,
+	// and evicts its least recently used entry when it is full. The capacity is divided evenly among
+	// the shards, so the total number of entries never exceeds the capacity (rounded up to a multiple of
+	// the shard count).
+	//
+	// example:
+	//      fcpp::memo_cache<std::string, int> lengths(1000);
+	//      const auto length = lengths.get_or_compute("hello", [](const std::string& text) {
+	//          return static_cast<int>(text.size());
+	//      });
+	//      const auto cached = lengths.find("hello");
+	//
+	// outcome:
+	//      length -> 5
+	//      cached.value() -> 5
+	//      lengths.hits() -> 1, lengths.misses() -> 1
+	template <typename T, typename U, typename THash = std::hash<T>, typename TEqual = std::equal_to<T>>
+	class memo_cache
+	{
+	public:
+		// Creates an empty cache with at most `capacity` entries, split over `shard_count` shards
+		explicit memo_cache(size_t capacity, size_t shard_count = 16)
+			: m_shard_count(shard_count > 0 ? shard_count : 1),
+			m_shard_capacity(capacity > 0 ? (capacity + m_shard_count - 1) / m_shard_count : 1),
+			m_shards(new shard[m_shard_count]),
+			m_hash(),
+			m_hits(0),
+			m_misses(0)
+		{
+		}
+
+		memo_cache(const memo_cache&) = delete;
+		memo_cache& operator =(const memo_cache&) = delete;
+
+		// Returns the cached value of the key, and marks it as the most recently used entry of its shard
+		[[nodiscard]] optional_t<U> find(const T& key)
+		{
+			optional_t<U> result;
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			const auto it = s.index.find(key);
+			if (it == s.index.end()) {
+				++m_misses;
+				return result;
+			}
+			++m_hits;
+			s.entries.splice(s.entries.begin(), s.entries, it->second);
+			result = it->second->second;
+			return result;
+		}
+
+		// Caches the value of the key (mutating). If the key is already cached, its value is kept.
+		memo_cache& insert(const T& key, const U& value)
+		{
+			auto& s = shard_of(key);
+			std::lock_guard<std::mutex> lock(s.mutex);
+			if (s.index.find(key) != s.index.end()) {
+				return *this;
+			}
+			if (s.entries.size() == m_shard_capacity) {
+				s.index.erase(s.entries.back().first);
+				s.entries.pop_back();
+			}
+			s.entries.emplace_front(key, value);
+			s.index.emplace(s.entries.front().first, s.entries.begin());
+			return *this;
+		}
+
+		// Returns the cached value of the key, or computes it with the transform and caches it.
+		// The transform runs outside of the lock, so two threads missing the same key at the same time
+		// may both compute it.
+		template <typename Transform>
+		U get_or_compute(const T& key, Transform&& transform)
+		{
+			const auto cached = find(key);
+			if (cached.has_value()) {
+				return cached.value();
+			}
+			U value = transform(key);
+			insert(key, value);
+			return value;
+		}
+
+		// Returns the number of cached entries
+		[[nodiscard]] size_t size() const
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				count += m_shards[i].entries.size();
+			}
+			return count;
+		}
+
+		// Returns the maximum number of cached entries
+		[[nodiscard]] size_t capacity() const
+		{
+			return m_shard_capacity * m_shard_count;
+		}
+
+		// Returns how many lookups found their key
+		[[nodiscard]] size_t hits() const
+		{
+			return m_hits.load();
+		}
+
+		// Returns how many lookups did not find their key
+		[[nodiscard]] size_t misses() const
+		{
+			return m_misses.load();
+		}
+
+		// Removes all entries (mutating), the statistics are kept
+		memo_cache& clear()
+		{
+			for (size_t i = 0; i < m_shard_count; ++i) {
+				std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+				m_shards[i].index.clear();
+				m_shards[i].entries.clear();
+			}
+			return *this;
+		}
+
+	private:
+		typedef std::list<std::pair<T, U>> entry_list;
+
+		struct shard
+		{
+			mutable std::mutex mutex;
+			// most recently used first
+			entry_list entries;
+			std::unordered_map<T, typename entry_list::iterator, THash, TEqual> index;
+		};
+
+		size_t m_shard_count;
+		size_t m_shard_capacity;
+		std::unique_ptr<shard[]> m_shards;
+		THash m_hash;
+		std::atomic<size_t> m_hits;
+		std::atomic<size_t> m_misses;
+
+		shard& shard_of(const T& key) const
+		{
+			const auto h = detail::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+			return m_shards[detail::reduce_range(static_cast<std::uint32_t>(h >> 32), m_shard_count)];
+		}
+	};
+
+	namespace detail {
+		// Hashes and compares elements through pointers, so that a call-local memoization
+		// can refer to the elements of the vector instead of copying them as keys
+		template <typename T, typename THash>
+		struct pointee_hash
+		{
+			size_t operator()(const T* element) const
+			{
+				return THash()(*element);
+			}
+		};
+
+		template <typename T, typename TEqual>
+		struct pointee_equal
+		{
+			bool operator()(const T* a, const T* b) const
+			{
+				return TEqual()(*a, *b);
+			}
+		};
+
+		// The default hash and equality of map_memoized, std::hash and operator == of the element type
+		struct element_hash
+		{
+			template <typename T>
+			size_t operator()(const T& element) const
+			{
+				return std::hash<T>()(element);
+			}
+		};
+
+		struct element_equal
+		{
+			template <typename T>
+			bool operator()(const T& a, const T& b) const
+			{
+				return a == b;
+			}
+		};
+
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Transforms the elements in parallel through the cache, `key_of` returns the cache key of an element
+		template <typename U, typename T, typename TAllocator, typename Transform, typename Cache, typename KeyOf>
+		vector<U> map_through_cache_parallel(const vector<T, TAllocator>& source, Transform& transform, Cache& cache, KeyOf key_of)
+		{
+			std::vector<U> transformed_vector(source.size());
+			std::transform(std::execution::par,
+			               source.begin(),
+			               source.end(),
+			               transformed_vector.begin(),
+			               [&transform, &cache, &key_of](const T& element) {
+				               return cache.get_or_compute(key_of(element), [&transform, &element](const auto&) {
+					               return transform(element);
+				               });
+			               });
+			return vector<U>(std::move(transformed_vector));
+		}
+#endif
+	}
+
+	// Performs the functional `map` algorithm, calling the transform only once per distinct element:
+	// the results are memoized in a hash map for the duration of the call, and repeated elements get a
+	// copy of the first result. Useful for expensive transforms over vectors with many repeated values.
+	// The elements must be hashable with THash and comparable with TEqual (by default std::hash and
+	// operator ==). See also fcpp::vector::map for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<std::string> countries({ "GR", "DE", "GR", "GR", "DE" });
+	//      const auto names = fcpp::map_memoized<std::string>(countries, [](const std::string& code) {
+	//          return lookup_country_name(code);
+	//      });
+	//
+	// outcome:
+	//      names -> fcpp::vector<std::string>({ "Greece", "Germany", "Greece", "Greece", "Germany" })
+	//      lookup_country_name is called twice
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename THash = detail::element_hash, typename TEqual = detail::element_equal, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename THash = detail::element_hash, typename TEqual = detail::element_equal, typename T, typename TAllocator, typename Transform>
+#endif
+	vector<U> map_memoized(const vector<T, TAllocator>& source, Transform&& transform)
+	{
+		// the first index of every distinct element, the elements are referenced instead of copied
+		std::unordered_map<const T*, size_t, detail::pointee_hash<T, THash>, detail::pointee_equal<T, TEqual>> first_index;
+		std::vector<U> transformed_vector;
+		transformed_vector.reserve(source.size());
+		for (size_t i = 0; i < source.size(); ++i) {
+			const auto inserted = first_index.emplace(&source[i], i);
+			if (inserted.second) {
+				transformed_vector.push_back(transform(source[i]));
+			} else {
+				transformed_vector.push_back(transformed_vector[inserted.first->second]);
+			}
+		}
+		return vector<U>(std::move(transformed_vector));
+	}
+
+	// Performs the `map_memoized` algorithm with a cache which outlives the call, so that repeated
+	// elements across calls are transformed once as well (as long as they are not evicted).
+	//
+	// example:
+	//      fcpp::memo_cache<std::string, std::string> country_names(10000);
+	//      const auto names = fcpp::map_memoized(countries, lookup_country_name, country_names);
+	//      const auto more_names = fcpp::map_memoized(more_countries, lookup_country_name, country_names);
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename THash, typename TEqual, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename THash, typename TEqual, typename T, typename TAllocator, typename Transform>
+#endif
+	vector<U> map_memoized(const vector<T, TAllocator>& source, Transform&& transform, memo_cache<T, U, THash, TEqual>& cache)
+	{
+		std::vector<U> transformed_vector;
+		transformed_vector.reserve(source.size());
+		for (const auto& element : source) {
+			transformed_vector.push_back(cache.get_or_compute(element, transform));
+		}
+		return vector<U>(std::move(transformed_vector));
+	}
+
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+	// Performs the `map_memoized` algorithm in parallel, the threads share a sharded concurrent cache.
+	// Two threads meeting the same new element at the same time may both transform it.
+	// See also the sequential version for more documentation.
+	template <typename U, typename THash = detail::element_hash, typename TEqual = detail::element_equal, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+	vector<U> map_memoized_parallel(const vector<T, TAllocator>& source, Transform&& transform)
+	{
+		memo_cache<const T*, U, detail::pointee_hash<T, THash>, detail::pointee_equal<T, TEqual>> cache(source.size(), 4 * std::max(1u, std::thread::hardware_concurrency()));
+		return detail::map_through_cache_parallel<U>(source, transform, cache, [](const T& element) {
+			return &element;
+		});
+	}
+
+	// Performs the `map_memoized` algorithm in parallel, with a cache which outlives the call.
+	// See also the sequential version for more documentation.
+	template <typename U, typename THash, typename TEqual, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+	vector<U> map_memoized_parallel(const vector<T, TAllocator>& source, Transform&& transform, memo_cache<T, U, THash, TEqual>& cache)
+	{
+		return detail::map_through_cache_parallel<U>(source, transform, cache, [](const T& element) -> const T& {
+			return element;
+		});
+	}
+#endif
+}
@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include "compatibility.h"
+
+#ifdef MULTIPROCESS_AVAILABLE
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "export_def.h"
+#include "vector.h"
+
+namespace fcpp {
+	// Thrown by the `_multiprocess` algorithms when a worker process cannot be started, or does not finish
+	// successfully (e.g. its callback threw an exception or it was killed)
+	class FunctionalCppExport multiprocess_error : public std::runtime_error
+	{
+	public:
+		explicit multiprocess_error(const std::string& message);
+	};
+
+	namespace detail {
+		// A memory region shared with the child processes forked after its creation, the children's
+		// writes are visible to the parent once they have exited
+		class FunctionalCppExport shared_memory_region
+		{
+		public:
+			explicit shared_memory_region(size_t size_in_bytes);
+
+			shared_memory_region(const shared_memory_region&) = delete;
+			shared_memory_region& operator =(const shared_memory_region&) = delete;
+
+			~shared_memory_region();
+
+			void* data() const;
+
+		private:
+			void* m_data;
+			size_t m_size;
+		};
+
+		// Returns how many worker processes are used by default, one per hardware thread
+		FunctionalCppExport size_t default_process_count();
+
+		// Splits [0, element_count) into contiguous chunks and forks one child process per chunk, which calls
+		// `work(chunk_index, start, end)` and exits. Returns the number of chunks once all children have
+		// finished, and throws multiprocess_error if any of them failed.
+		FunctionalCppExport size_t for_each_chunk_in_processes(size_t element_count,
+		                                                       size_t process_count,
+		                                                       const std::function<void(size_t, size_t, size_t)>& work);
+	}
+
+	// Performs the functional `map` algorithm in several processes instead of threads, for CPU-bound
+	// transforms which contend on locks (e.g. the allocator) when run on threads. One child process is
+	// forked per contiguous chunk of the vector (by default one per hardware thread): the children read
+	// the elements through the copy-on-write memory inherited from the fork, and write their results
+	// into memory shared with the caller. Therefore U must be trivially copyable, and the transform must
+	// not rely on other threads of the process (only the forking thread exists in the children).
+	// Throws fcpp::multiprocess_error if a child fails, e.g. when the transform throws.
+	// See also fcpp::vector::map for more documentation.
+	//
+	// example:
+	//      const fcpp::vector<double> samples = load_samples();
+	//      const auto scores = fcpp::map_multiprocess<double>(samples, [](const double& sample) {
+	//          return expensive_score(sample);
+	//      }, 8);
+#ifdef CPP17_AVAILABLE
+	template <typename U, typename T, typename TAllocator, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, T>>>
+#else
+	template <typename U, typename T, typename TAllocator, typename Transform>
+#endif
+	vector<U> map_multiprocess(const vector<T, TAllocator>& source, Transform&& transform, size_t process_count = 0)
+	{
+		static_assert(std::is_trivially_copyable<U>::value, "the results of map_multiprocess must be trivially copyable");
+		detail::shared_memory_region shared_results(source.size() * sizeof(U));
+		U* results = static_cast<U*>(shared_results.data());
+		detail::for_each_chunk_in_processes(source.size(), process_count, [&source, &transform, results](size_t, size_t start, size_t end) {
+			for (auto i = start; i < end; ++i) {
+				new (results + i) U(transform(source[i]));
+			}
+		});
+		return vector<U>(std::vector<U>(results, results + source.size()));
+	}
+
+	// Performs the functional `reduce` algorithm in several processes, see map_multiprocess.
+	// Every child reduces its chunk starting from `initial`, and the partial results are combined in
+	// order with `combine`. Hence `initial` must be neutral for `combine`, as in std::reduce.
+	// U must be trivially copyable.
+	//
+	// example:
+	//      const fcpp::vector<double> samples = load_samples();
+	//      const auto total_score = fcpp::reduce_multiprocess(samples, 0.0, [](const double& partial, const double& sample) {
+	//          return partial + expensive_score(sample);
+	//      }, std::plus<double>());
+#ifdef CPP17_AVAILABLE
+	template <typename T, typename TAllocator, typename U, typename Reduce, typename Combine, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, T> && std::is_invocable_r_v<U, Combine, U, U>>>
+#else
+	template <typename T, typename TAllocator, typename U, typename Reduce, typename Combine>
+#endif
+	U reduce_multiprocess(const vector<T, TAllocator>& source, const U& initial, Reduce&& reduction, Combine&& combine, size_t process_count = 0)
+	{
+		static_assert(std::is_trivially_copyable<U>::value, "the result of reduce_multiprocess must be trivially copyable");
+		const auto chunk_limit = process_count > 0 ? process_count : detail::default_process_count();
+		detail::shared_memory_region shared_partials(chunk_limit * sizeof(U));
+		U* partials = static_cast<U*>(shared_partials.data());
+		const auto chunk_count = detail::for_each_chunk_in_processes(source.size(), chunk_limit, [&source, &reduction, &initial, partials](size_t chunk, size_t start, size_t end) {
+			U partial = initial;
+			for (auto i = start; i < end; ++i) {
+				partial = reduction(partial, source[i]);
+			}
+			new (partials + chunk) U(partial);
+		});
+		if (chunk_count == 0) {
+			return initial;
+		}
+		U result = partials[0];
+		for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+			result = combine(result, partials[chunk]);
+		}
+		return result;
+	}
+}
+#endif
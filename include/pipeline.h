@@ -0,0 +1,426 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "compatibility.h"
+#include "vector.h"
+
+namespace fcpp {
+
+	// The activity of one pipeline stage during a run
+	struct pipeline_stage_statistics
+	{
+		pipeline_stage_statistics()
+			: batches(0), input_elements(0), output_elements(0), input_waits(0), output_waits(0)
+		{
+		}
+
+		// The number of batches the stage processed
+		size_t batches;
+
+		// The number of elements the stage received
+		size_t input_elements;
+
+		// The number of elements the stage passed on to the next stage
+		size_t output_elements;
+
+		// How many times the stage found its input queue empty and had to wait for the previous stage
+		// (the previous stage is slower)
+		size_t input_waits;
+
+		// How many times the stage found its output queue full and had to wait for the next stage
+		// (backpressure, the next stage is slower)
+		size_t output_waits;
+	};
+
+	namespace detail {
+		// A bounded lock-free queue between exactly one producer thread and one consumer thread
+		template <typename T>
+		class spsc_ring
+		{
+		public:
+			spsc_ring(size_t capacity, const std::atomic<bool>& aborted)
+				: m_slots(round_up_to_power_of_two(capacity)),
+				m_mask(m_slots.size() - 1),
+				m_closed(false),
+				m_aborted(aborted)
+			{
+				m_head.value.store(0);
+				m_tail.value.store(0);
+			}
+
+			// Blocks while the queue is full, returns false if the pipeline was aborted
+			bool push(T&& value, size_t& waits)
+			{
+				const auto tail = m_tail.value.load(std::memory_order_relaxed);
+				if (tail - m_head.value.load(std::memory_order_acquire) == m_slots.size()) {
+					++waits;
+					while (tail - m_head.value.load(std::memory_order_acquire) == m_slots.size()) {
+						if (m_aborted.load(std::memory_order_relaxed)) {
+							return false;
+						}
+						std::this_thread::yield();
+					}
+				}
+				m_slots[tail & m_mask] = std::move(value);
+				m_tail.value.store(tail + 1, std::memory_order_release);
+				return true;
+			}
+
+			// Blocks while the queue is empty, returns false once the queue is closed and drained,
+			// or if the pipeline was aborted
+			bool pop(T& value, size_t& waits)
+			{
+				const auto head = m_head.value.load(std::memory_order_relaxed);
+				if (m_tail.value.load(std::memory_order_acquire) == head) {
+					++waits;
+					while (m_tail.value.load(std::memory_order_acquire) == head) {
+						if (m_closed.load(std::memory_order_acquire)) {
+							if (m_tail.value.load(std::memory_order_acquire) == head) {
+								return false;
+							}
+							break;
+						}
+						if (m_aborted.load(std::memory_order_relaxed)) {
+							return false;
+						}
+						std::this_thread::yield();
+					}
+				}
+				value = std::move(m_slots[head & m_mask]);
+				m_head.value.store(head + 1, std::memory_order_release);
+				return true;
+			}
+
+			// Called by the producer after its last push
+			void close()
+			{
+				m_closed.store(true, std::memory_order_release);
+			}
+
+		private:
+			// The producer and the consumer index live in different cache lines
+			struct padded_index
+			{
+				std::atomic<size_t> value;
+				char padding[64 - sizeof(std::atomic<size_t>)];
+			};
+
+			std::vector<T> m_slots;
+			size_t m_mask;
+			padded_index m_head;
+			padded_index m_tail;
+			std::atomic<bool> m_closed;
+			const std::atomic<bool>& m_aborted;
+
+			static size_t round_up_to_power_of_two(size_t value)
+			{
+				size_t result = 1;
+				while (result < value) {
+					result <<= 1;
+				}
+				return result;
+			}
+		};
+
+		// The state shared by the threads of one pipeline run
+		struct pipeline_run
+		{
+			pipeline_run(size_t capacity, size_t stage_count)
+				: queue_capacity(capacity), queues(), threads(), statistics(stage_count), aborted(false), error_mutex(), error()
+			{
+			}
+
+			// Stops all threads of the run, the first error is rethrown by the caller of run
+			void fail(std::exception_ptr exception)
+			{
+				{
+					std::lock_guard<std::mutex> lock(error_mutex);
+					if (!error) {
+						error = exception;
+					}
+				}
+				aborted.store(true);
+			}
+
+			void join_and_rethrow()
+			{
+				for (auto& thread : threads) {
+					thread.join();
+				}
+				if (error) {
+					std::rethrow_exception(error);
+				}
+			}
+
+			size_t queue_capacity;
+			// queue i is the input of stage i, the last queue is the output of the pipeline
+			std::vector<std::shared_ptr<void>> queues;
+			std::vector<std::thread> threads;
+			std::vector<pipeline_stage_statistics> statistics;
+			std::atomic<bool> aborted;
+			std::mutex error_mutex;
+			std::exception_ptr error;
+		};
+	}
+
+	// Runs a sequence of map/filter stages over streaming data with pipeline parallelism:
+	// every stage runs on its own thread, and consecutive stages are connected with bounded lock-free
+	// single-producer/single-consumer queues which carry batches of elements. While a stage transforms
+	// one batch, the previous stage already works on the next one, so the stages overlap instead of
+	// running one after another over the whole data set. When a stage is slower than its predecessor,
+	// the queue in between fills up and the predecessor waits (backpressure), which bounds the memory.
+	//
+	// Building a pipeline does not run anything; `run` feeds the input in batches and collects the
+	// output in order. An exception thrown by a stage stops all stages and is rethrown by `run`.
+	//
+	// example:
+	//      const fcpp::vector<std::string> lines({"4", "x", "15", "8"});
+	//      const auto numbers = fcpp::pipeline<std::string>()
+	//          .filter([](const std::string& line) {
+	//              return !line.empty() && std::isdigit(line[0]);
+	//          })
+	//          .map<int>([](const std::string& line) {
+	//              return std::stoi(line);
+	//          })
+	//          .map<int>([](const int& number) {
+	//              return number * 2;
+	//          })
+	//          .run(lines);
+	//
+	// outcome:
+	//      numbers -> fcpp::vector<int>({8, 30, 16})
+	template <typename TIn, typename TOut = TIn>
+	class pipeline
+	{
+		typedef std::function<void(detail::pipeline_run&, size_t)> stage_launcher;
+
+	public:
+		// Creates a pipeline without stages. The input is split into batches of `batch_size` elements,
+		// and every queue between two stages holds up to `queue_capacity` batches.
+		explicit pipeline(size_t batch_size = 1024, size_t queue_capacity = 16)
+			: m_batch_size(batch_size > 0 ? batch_size : 1),
+			m_queue_capacity(queue_capacity > 0 ? queue_capacity : 1),
+			m_stages()
+		{
+		}
+
+		// Returns a pipeline with an additional stage, which transforms every element with the given function
+		// (same callables as fcpp::vector::map)
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Transform, typename = std::enable_if_t<std::is_invocable_r_v<U, Transform, TOut>>>
+#else
+		template <typename U, typename Transform>
+#endif
+		[[nodiscard]] pipeline<TIn, U> map(Transform&& transform) const
+		{
+			typedef typename std::decay<Transform>::type transform_type;
+			const transform_type stage_transform(std::forward<Transform>(transform));
+			return with_stage<U>([stage_transform](std::vector<TOut>& batch, std::vector<U>& output) {
+				for (const auto& element : batch) {
+					output.push_back(stage_transform(element));
+				}
+			});
+		}
+
+		// Returns a pipeline with an additional stage, which keeps only the elements satisfying the predicate
+		// (same callables as fcpp::vector::filter)
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TOut>>>
+#else
+		template <typename Filter>
+#endif
+		[[nodiscard]] pipeline filter(Filter&& predicate_to_keep) const
+		{
+			typedef typename std::decay<Filter>::type filter_type;
+			const filter_type predicate(std::forward<Filter>(predicate_to_keep));
+			return with_stage<TOut>([predicate](std::vector<TOut>& batch, std::vector<TOut>& output) {
+				for (auto& element : batch) {
+					if (predicate(element)) {
+						output.push_back(std::move(element));
+					}
+				}
+			});
+		}
+
+		// Runs the pipeline over the input and returns the output elements in input order
+		[[nodiscard]] vector<TOut> run(const vector<TIn>& input) const
+		{
+			std::vector<pipeline_stage_statistics> statistics;
+			return run(input, statistics);
+		}
+
+		// Runs the pipeline over the input and returns the output elements in input order.
+		// The activity of every stage (e.g. how often it was slowed down by backpressure) is stored in `statistics`.
+		vector<TOut> run(const vector<TIn>& input, std::vector<pipeline_stage_statistics>& statistics) const
+		{
+			std::vector<TOut> output;
+			consume(input, statistics, [&output](std::vector<TOut>& batch) {
+				output.insert(output.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+			});
+			return vector<TOut>(std::move(output));
+		}
+
+		// Runs the pipeline and reduces its output on the calling thread while the stages are still
+		// running, so the reduction overlaps with the stages as well (same callables as fcpp::vector::reduce)
+		//
+		// example:
+		//      const fcpp::vector<int> numbers({1, 2, 3, 4});
+		//      const auto sum_of_squares = fcpp::pipeline<int>()
+		//          .map<int>([](const int& number) {
+		//              return number * number;
+		//          })
+		//          .run_reduce(numbers, 0, [](const int& partial_sum, const int& number) {
+		//              return partial_sum + number;
+		//          });
+		//
+		// outcome:
+		//      sum_of_squares -> 30
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TOut>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U run_reduce(const vector<TIn>& input, const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			std::vector<pipeline_stage_statistics> statistics;
+			consume(input, statistics, [&result, &reduction](std::vector<TOut>& batch) {
+				for (const auto& element : batch) {
+					result = reduction(result, element);
+				}
+			});
+			return result;
+		}
+
+		// Returns the number of stages
+		[[nodiscard]] size_t stage_count() const
+		{
+			return m_stages.size();
+		}
+
+	private:
+		template <typename UIn, typename UOut>
+		friend class pipeline;
+
+		size_t m_batch_size;
+		size_t m_queue_capacity;
+		// Every launcher creates the output queue of its stage and starts the stage's thread
+		std::vector<stage_launcher> m_stages;
+
+		template <typename U, typename Process>
+		pipeline<TIn, U> with_stage(Process process) const
+		{
+			pipeline<TIn, U> extended(m_batch_size, m_queue_capacity);
+			extended.m_stages = m_stages;
+			extended.m_stages.push_back([process](detail::pipeline_run& run, size_t index) {
+				launch_stage<U>(run, index, process);
+			});
+			return extended;
+		}
+
+		template <typename U, typename Process>
+		static void launch_stage(detail::pipeline_run& run, size_t index, Process process)
+		{
+			typedef detail::spsc_ring<std::vector<TOut>> input_queue;
+			typedef detail::spsc_ring<std::vector<U>> output_queue;
+			const auto input = std::static_pointer_cast<input_queue>(run.queues[index]);
+			const auto output = std::make_shared<output_queue>(run.queue_capacity, run.aborted);
+			run.queues.push_back(output);
+			auto& statistics = run.statistics[index];
+			run.threads.push_back(std::thread([&run, &statistics, input, output, process]() {
+				try {
+					std::vector<TOut> batch;
+					while (input->pop(batch, statistics.input_waits)) {
+						std::vector<U> result;
+						result.reserve(batch.size());
+						process(batch, result);
+						++statistics.batches;
+						statistics.input_elements += batch.size();
+						statistics.output_elements += result.size();
+						if (!result.empty() && !output->push(std::move(result), statistics.output_waits)) {
+							break;
+						}
+					}
+				} catch (...) {
+					run.fail(std::current_exception());
+				}
+				output->close();
+			}));
+		}
+
+		// Starts the stage threads and a source thread which feeds the input in batches,
+		// and hands every output batch to `sink` on the calling thread
+		template <typename Sink>
+		void consume(const vector<TIn>& input, std::vector<pipeline_stage_statistics>& statistics, Sink&& sink) const
+		{
+			typedef detail::spsc_ring<std::vector<TIn>> source_queue;
+			typedef detail::spsc_ring<std::vector<TOut>> sink_queue;
+			detail::pipeline_run run(m_queue_capacity, m_stages.size());
+			const auto source = std::make_shared<source_queue>(m_queue_capacity, run.aborted);
+			run.queues.push_back(source);
+			try {
+				for (size_t i = 0; i < m_stages.size(); ++i) {
+					m_stages[i](run, i);
+				}
+				const auto batch_size = m_batch_size;
+				run.threads.push_back(std::thread([&input, source, batch_size]() {
+					size_t waits = 0;
+					for (size_t start = 0; start < input.size(); start += batch_size) {
+						const auto end = std::min(start + batch_size, input.size());
+						std::vector<TIn> batch;
+						batch.reserve(end - start);
+						for (auto i = start; i < end; ++i) {
+							batch.push_back(input[i]);
+						}
+						if (!source->push(std::move(batch), waits)) {
+							break;
+						}
+					}
+					source->close();
+				}));
+				const auto output = std::static_pointer_cast<sink_queue>(run.queues.back());
+				std::vector<TOut> batch;
+				size_t waits = 0;
+				while (output->pop(batch, waits)) {
+					sink(batch);
+				}
+			} catch (...) {
+				run.fail(std::current_exception());
+			}
+			run.join_and_rethrow();
+			statistics = run.statistics;
+		}
+	};
+}
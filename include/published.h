@@ -0,0 +1,249 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace fcpp {
+
+	// Holds a read-mostly value (e.g. a configuration or lookup vector) which many threads read
+	// and a few threads replace from time to time, in the style of read-copy-update.
+	//
+	// Readers take an immutable snapshot of the current version. Taking a snapshot does not lock:
+	// the reader registers in one of several reader slots (chosen per thread, so that readers do not
+	// share a cache line) under the current epoch, and then reads the published pointer. Writers build
+	// a new version and publish it with an atomic pointer exchange, so readers always see either the
+	// old or the new version in full.
+	//
+	// Old versions are reclaimed with epoch-based reclamation: every publication advances the epoch,
+	// and the version replaced by a publication is destroyed during the next one, after the readers
+	// registered in the epochs which could have seen it have released their snapshots. A writer only
+	// waits for snapshots which were taken two publications ago.
+	//
+	// example:
+	//      fcpp::published<fcpp::vector<int>> thresholds(fcpp::vector<int>({10, 20}));
+	//
+	//      // reader threads
+	//      const auto snapshot = thresholds.snapshot();
+	//      const auto index_of_20 = snapshot->find_first_index(20);
+	//
+	//      // writer thread
+	//      thresholds.update([](fcpp::vector<int>& values) {
+	//          values.insert_back(30);
+	//      });
+	//
+	// outcome:
+	//      index_of_20.value() -> 1
+	//      thresholds.snapshot()->size() -> 3
+	template <typename T>
+	class published
+	{
+		static const size_t reader_slot_count = 64;
+
+		// The readers registered under even and odd epochs, padded to its own cache line
+		struct reader_slot
+		{
+			std::atomic<size_t> readers[2];
+			char padding[64 - 2 * sizeof(std::atomic<size_t>)];
+		};
+
+	public:
+		// An immutable handle to the version which was current when it was created. The version stays
+		// alive at least until the handle is destroyed, even if newer versions are published meanwhile.
+		class snapshot_handle
+		{
+		public:
+			snapshot_handle(snapshot_handle&& other)
+				: m_value(other.m_value), m_readers(other.m_readers)
+			{
+				other.m_readers = nullptr;
+			}
+
+			snapshot_handle(const snapshot_handle&) = delete;
+			snapshot_handle& operator =(const snapshot_handle&) = delete;
+			snapshot_handle& operator =(snapshot_handle&&) = delete;
+
+			~snapshot_handle()
+			{
+				if (m_readers != nullptr) {
+					m_readers->fetch_sub(1);
+				}
+			}
+
+			const T& operator*() const
+			{
+				return *m_value;
+			}
+
+			const T* operator->() const
+			{
+				return m_value;
+			}
+
+			const T& get() const
+			{
+				return *m_value;
+			}
+
+		private:
+			friend class published;
+
+			snapshot_handle(const T* value, std::atomic<size_t>* readers)
+				: m_value(value), m_readers(readers)
+			{
+			}
+
+			const T* m_value;
+			std::atomic<size_t>* m_readers;
+		};
+
+		explicit published(T initial_value)
+			: m_current(new T(std::move(initial_value))), m_retired(nullptr), m_epoch(0)
+		{
+			for (auto& slot : m_slots) {
+				slot.readers[0].store(0);
+				slot.readers[1].store(0);
+			}
+		}
+
+		published(const published&) = delete;
+		published& operator =(const published&) = delete;
+
+		// All snapshots must have been released before destruction
+		~published()
+		{
+			delete m_current.load();
+			delete m_retired;
+		}
+
+		// Returns a handle to the current version, without locking.
+		// Retries only if a writer advances the epoch at the same moment.
+		[[nodiscard]] snapshot_handle snapshot() const
+		{
+			auto& slot = m_slots[reader_slot_of_this_thread()];
+			while (true) {
+				const auto epoch = m_epoch.load();
+				auto& readers = slot.readers[epoch & 1];
+				readers.fetch_add(1);
+				if (m_epoch.load() == epoch) {
+					return snapshot_handle(m_current.load(), &readers);
+				}
+				// a writer advanced the epoch in between, register under the new one
+				readers.fetch_sub(1);
+			}
+		}
+
+		// Executes the given operation on the current version and returns its result
+		//
+		// example:
+		//      const fcpp::published<fcpp::vector<int>> numbers(fcpp::vector<int>({1, 2, 3}));
+		//      const auto size = numbers.read([](const fcpp::vector<int>& values) {
+		//          return values.size();
+		//      });
+		//
+		// outcome:
+		//      size -> 3
+		template <typename Callable>
+		auto read(Callable&& operation) const -> decltype(operation(std::declval<const T&>()))
+		{
+			const auto handle = snapshot();
+			return operation(*handle);
+		}
+
+		// Replaces the current version with the given value. Readers which already hold a snapshot keep
+		// seeing the previous version, new snapshots see the new one.
+		published& publish(T value)
+		{
+			std::lock_guard<std::mutex> lock(m_writer_mutex);
+			publish_locked(new T(std::move(value)));
+			return *this;
+		}
+
+		// Copies the current version, applies the given mutation to the copy and publishes it.
+		// Concurrent updates are serialized, so no update is lost.
+		//
+		// example:
+		//      fcpp::published<fcpp::vector<int>> numbers(fcpp::vector<int>({1, 2, 3}));
+		//      numbers.update([](fcpp::vector<int>& values) {
+		//          values.insert_back(4);
+		//      });
+		//
+		// outcome:
+		//      numbers.snapshot().get() -> fcpp::vector<int>({1, 2, 3, 4})
+		template <typename Callable>
+		published& update(Callable&& mutation)
+		{
+			std::lock_guard<std::mutex> lock(m_writer_mutex);
+			auto next = new T(*m_current.load());
+			mutation(*next);
+			publish_locked(next);
+			return *this;
+		}
+
+		// Returns the number of publications so far
+		[[nodiscard]] size_t version() const
+		{
+			return m_epoch.load();
+		}
+
+	private:
+		std::atomic<const T*> m_current;
+		const T* m_retired;
+		std::atomic<size_t> m_epoch;
+		mutable reader_slot m_slots[reader_slot_count];
+		std::mutex m_writer_mutex;
+
+		static size_t reader_slot_of_this_thread()
+		{
+			static thread_local const size_t slot = std::hash<std::thread::id>()(std::this_thread::get_id()) % reader_slot_count;
+			return slot;
+		}
+
+		// A reader registered in epoch k holds version k or k + 1, therefore the version retired by the
+		// previous publication is released once the readers of the previous epoch are gone. Those readers
+		// share the counters with the next epoch, so they must be drained before the epoch advances.
+		void publish_locked(const T* next)
+		{
+			const auto epoch = m_epoch.load();
+			const auto replaced = m_current.exchange(next);
+			wait_for_readers((epoch + 1) & 1);
+			delete m_retired;
+			m_retired = replaced;
+			m_epoch.store(epoch + 1);
+		}
+
+		void wait_for_readers(size_t parity) const
+		{
+			for (auto& slot : m_slots) {
+				while (slot.readers[parity].load() != 0) {
+					std::this_thread::yield();
+				}
+			}
+		}
+	};
+}
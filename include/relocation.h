@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace fcpp {
+	// Whether an object of type T can be relocated, i.e. moved to another address and the original
+	// destroyed, by copying its bytes. This holds for most types, except those pointing into themselves
+	// (e.g. std::string with its small string buffer in libstdc++) or registering their address elsewhere.
+	//
+	// fcpp::vector shifts the elements of such types with memmove when inserting and removing in the middle,
+	// instead of moving and destroying them one by one. Trivially copyable types and the standard smart
+	// pointers are relocatable, other types opt in by specializing this trait.
+	//
+	// example:
+	//      struct file_handle { ... };
+	//
+	//      namespace fcpp {
+	//          template <>
+	//          struct is_trivially_relocatable<file_handle> : std::true_type {};
+	//      }
+	template <typename T>
+	struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+	{
+	};
+
+	template <typename T>
+	struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+	{
+	};
+
+	template <typename T>
+	struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+	{
+	};
+
+	template <typename T>
+	struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+	{
+	};
+
+	namespace detail {
+		// Whether shifting with memmove is worthwhile and possible: std::vector already does it for trivially
+		// copyable types, and the slots left behind are filled with default constructed elements
+		template <typename T>
+		struct uses_relocating_shift : std::integral_constant<bool,
+			is_trivially_relocatable<T>::value &&
+			!std::is_trivially_copyable<T>::value &&
+			std::is_nothrow_default_constructible<T>::value>
+		{
+		};
+
+		// Removes `count` elements starting at `index` by destroying them and relocating the following ones
+		template <typename T, typename TAllocator>
+		void relocating_erase(std::vector<T, TAllocator>& elements, size_t index, size_t count)
+		{
+			const auto size = elements.size();
+			T* data = elements.data();
+			for (auto i = index; i < index + count; ++i) {
+				data[i].~T();
+			}
+			std::memmove(static_cast<void*>(data + index),
+			             static_cast<const void*>(data + index + count),
+			             (size - index - count) * sizeof(T));
+			// the last slots have been relocated, they get new elements for resize to destroy
+			for (auto i = size - count; i < size; ++i) {
+				new (data + i) T();
+			}
+			elements.resize(size - count);
+		}
+
+		// Inserts `count` elements at `index` by relocating them from `source`, whose slots are left with
+		// default constructed elements
+		template <typename T, typename TAllocator>
+		void relocating_insert(std::vector<T, TAllocator>& elements, size_t index, T* source, size_t count)
+		{
+			const auto size = elements.size();
+			elements.resize(size + count);
+			T* data = elements.data();
+			for (auto i = size; i < size + count; ++i) {
+				data[i].~T();
+			}
+			std::memmove(static_cast<void*>(data + index + count),
+			             static_cast<const void*>(data + index),
+			             (size - index) * sizeof(T));
+			std::memcpy(static_cast<void*>(data + index),
+			            static_cast<const void*>(source),
+			            count * sizeof(T));
+			for (size_t i = 0; i < count; ++i) {
+				new (source + i) T();
+			}
+		}
+	}
+}
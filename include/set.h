@@ -22,12 +22,21 @@
 
 #pragma once
 #include <algorithm>
+#include <functional>
 #include <set>
+#include <vector>
 #include "optional.h"
+#include "vector_fwd.h"
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+#include <atomic>
+#include <execution>
+#include <numeric>
+#include <thread>
+#endif
 
 namespace fcpp {
-	template <typename T>
-	class vector;
+	template <class TKey, class THash, class TEqual>
+	class frozen_set;
 
 	// A lightweight wrapper around std::set, enabling fluent and functional
 	// programming on the set itself, rather than using the more procedural style
@@ -54,7 +63,8 @@ namespace fcpp {
 		{
 		}
 
-		explicit set(const vector<TKey>& vector)
+		template <typename TAllocator>
+		explicit set(const vector<TKey, TAllocator>& vector)
 			: m_set(vector.begin(), vector.end())
 		{
 		}
@@ -64,6 +74,40 @@ namespace fcpp {
 		{
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Creates a set from a (large) vector by sorting and removing the duplicates in parallel, and then
+		// building the tree from the sorted unique keys in linear time, instead of inserting one key at a time.
+		//
+		// example:
+		//      const fcpp::vector<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+		//      const auto unique_numbers = fcpp::set<int>::from_parallel(numbers);
+		//
+		// outcome:
+		//      unique_numbers -> fcpp::set<int>({1, 2, 3, 4, 5, 7, 8})
+		template <typename TAllocator>
+		[[nodiscard]] static set from_parallel(const vector<TKey, TAllocator>& vector)
+		{
+			return from_parallel(std::vector<TKey>(vector.begin(), vector.end()));
+		}
+
+		// Creates a set from a (large) vector in parallel. See from_parallel for fcpp::vector for more details.
+		[[nodiscard]] static set from_parallel(std::vector<TKey> keys)
+		{
+			const TCompare compare;
+			std::sort(std::execution::par, keys.begin(), keys.end(), compare);
+			keys.erase(std::unique(std::execution::par,
+			                       keys.begin(),
+			                       keys.end(),
+			                       [&compare](const TKey& a, const TKey& b) {
+				                       return !compare(a, b) && !compare(b, a);
+			                       }), keys.end());
+			// constructing a std::set from a sorted range is linear
+			return set(std::set<TKey, TCompare>(std::make_move_iterator(keys.begin()),
+			                                    std::make_move_iterator(keys.end()),
+			                                    compare));
+		}
+#endif
+
 		// Returns the set of elements which belong to the current set but not in the other set.
 		// In Venn diagram notation, if A is the current set and B is the other set, then
 		// the difference is the operation A – B = {x : x ∈ A and x ∉ B}
@@ -220,6 +264,30 @@ namespace fcpp {
 			return set<UKey, UCompare>(transformed_set);
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the functional `map` algorithm in parallel. The set is split into balanced chunks of
+		// consecutive keys, each chunk's transformed keys are sorted in parallel, and the sorted chunks
+		// are merged pairwise (also in parallel) before building the resulting set in linear time.
+		// See also the sequential version for more documentation.
+		template <class UKey, class UCompare = std::less<UKey>, typename Transform, typename = std::enable_if_t<
+			          std::is_invocable_r_v<UKey, Transform, TKey>>>
+		set<UKey, UCompare> map_parallel(Transform&& transform) const
+		{
+			const UCompare compare;
+			const auto boundaries = chunk_boundaries();
+			std::vector<std::vector<UKey>> chunks(boundaries.size() - 1);
+			for_each_chunk_parallel(boundaries, [&](size_t chunk, const_set_iterator first, const_set_iterator last) {
+				auto& transformed = chunks[chunk];
+				for (; first != last; ++first) {
+					transformed.push_back(transform(*first));
+				}
+				std::sort(transformed.begin(), transformed.end(), compare);
+			});
+			const auto merged = merge_sorted_chunks_parallel(std::move(chunks), compare);
+			return set<UKey, UCompare>(std::set<UKey, UCompare>(merged.begin(), merged.end()));
+		}
+#endif
+
 		// Returns true if all keys match the predicate (return true)
 		//
 		// example:
@@ -246,6 +314,25 @@ namespace fcpp {
 			                   std::forward<Callable>(unary_predicate));
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the `all_of` algorithm in parallel, over balanced chunks of the set.
+		// All chunks stop early once a key does not match the predicate.
+		// See also the sequential version for more documentation.
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+		bool all_of_parallel(Callable&& unary_predicate) const
+		{
+			std::atomic<bool> is_mismatch_found(false);
+			for_each_chunk_parallel(chunk_boundaries(), [&](size_t, const_set_iterator first, const_set_iterator last) {
+				for (; first != last && !is_mismatch_found.load(std::memory_order_relaxed); ++first) {
+					if (!unary_predicate(*first)) {
+						is_mismatch_found = true;
+					}
+				}
+			});
+			return !is_mismatch_found;
+		}
+#endif
+
 		// Returns true if at least one key match the predicate (returns true)
 		//
 		// example:
@@ -272,6 +359,25 @@ namespace fcpp {
 			                   std::forward<Callable>(unary_predicate));
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the `any_of` algorithm in parallel, over balanced chunks of the set.
+		// All chunks stop early once a key matches the predicate.
+		// See also the sequential version for more documentation.
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+		bool any_of_parallel(Callable&& unary_predicate) const
+		{
+			std::atomic<bool> is_match_found(false);
+			for_each_chunk_parallel(chunk_boundaries(), [&](size_t, const_set_iterator first, const_set_iterator last) {
+				for (; first != last && !is_match_found.load(std::memory_order_relaxed); ++first) {
+					if (unary_predicate(*first)) {
+						is_match_found = true;
+					}
+				}
+			});
+			return is_match_found;
+		}
+#endif
+
 		// Returns true if none of the keys match the predicate (all return false)
 		//
 		// example:
@@ -298,6 +404,16 @@ namespace fcpp {
 			                    std::forward<Callable>(unary_predicate));
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the `none_of` algorithm in parallel, over balanced chunks of the set.
+		// See also the sequential version for more documentation.
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+		bool none_of_parallel(Callable&& unary_predicate) const
+		{
+			return !any_of_parallel(std::forward<Callable>(unary_predicate));
+		}
+#endif
+
 		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
 		// accumulating all the values in the vector to an initial value. (non-mutating)
 		//
@@ -326,6 +442,41 @@ namespace fcpp {
 			return result;
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the functional `reduce` algorithm in parallel. The set is split into balanced chunks of
+		// consecutive keys, each chunk is reduced starting from `initial`, and the partial results are
+		// combined in the order of the chunks. Therefore `initial` must be the identity of `combine`
+		// (eg. 0 for a sum, "" for concatenation), and `combine` must be associative.
+		//
+		// example:
+		//      const fcpp::set<int> numbers({1, 4, 2, 5, 8, 3});
+		//      const auto sum = numbers.reduce_parallel(0,
+		//          [](const int& partial, const int& number) { return partial + number; },
+		//          [](const int& a, const int& b) { return a + b; });
+		//
+		// outcome:
+		//      sum -> 23
+		template <typename U, typename Reduce, typename Combine, typename = std::enable_if_t<
+			          std::is_invocable_r_v<U, Reduce, U, TKey> && std::is_invocable_r_v<U, Combine, U, U>>>
+		U reduce_parallel(const U& initial, Reduce&& reduction, Combine&& combine) const
+		{
+			const auto boundaries = chunk_boundaries();
+			std::vector<U> partial_results(boundaries.size() - 1, initial);
+			for_each_chunk_parallel(boundaries, [&](size_t chunk, const_set_iterator first, const_set_iterator last) {
+				auto result = initial;
+				for (; first != last; ++first) {
+					result = reduction(result, *first);
+				}
+				partial_results[chunk] = std::move(result);
+			});
+			auto result = partial_results[0];
+			for (size_t chunk = 1; chunk < partial_results.size(); ++chunk) {
+				result = combine(result, partial_results[chunk]);
+			}
+			return result;
+		}
+#endif
+
 		// Performs the functional `filter` algorithm, in which all keys of this instance
 		// which match the given predicate are kept (mutating)
 		//
@@ -365,6 +516,17 @@ namespace fcpp {
 			return *this;
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the functional `filter` algorithm in parallel.
+		// See also the sequential version for more documentation.
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+		set& filter_parallel(Filter&& predicate_to_keep)
+		{
+			m_set = filtered_parallel(std::forward<Filter>(predicate_to_keep)).m_set;
+			return *this;
+		}
+#endif
+
 		// Performs the functional `filter` algorithm in a copy of this instance, in which all keys
 		// of the copy which match the given predicate are kept (non-mutating)
 		//
@@ -394,6 +556,32 @@ namespace fcpp {
 			return set(copy);
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the `filtered` algorithm in parallel. Each chunk of consecutive keys keeps its matching
+		// keys in order, so the chunks' outputs only need to be concatenated to build the resulting set
+		// in linear time. See also the sequential version for more documentation.
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+		set filtered_parallel(Filter&& predicate_to_keep) const
+		{
+			const auto boundaries = chunk_boundaries();
+			std::vector<std::vector<TKey>> chunks(boundaries.size() - 1);
+			for_each_chunk_parallel(boundaries, [&](size_t chunk, const_set_iterator first, const_set_iterator last) {
+				for (; first != last; ++first) {
+					if (predicate_to_keep(*first)) {
+						chunks[chunk].push_back(*first);
+					}
+				}
+			});
+			std::set<TKey, TCompare> copy(m_set.key_comp());
+			for (const auto& chunk : chunks) {
+				for (const auto& key : chunk) {
+					copy.insert(copy.end(), key);
+				}
+			}
+			return set(copy);
+		}
+#endif
+
 #ifdef CPP17_AVAILABLE
 		template <typename Iterator>
 		using deref_type = typename std::iterator_traits<Iterator>::value_type;
@@ -474,6 +662,21 @@ namespace fcpp {
 			return *this;
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Executes the given operation for each key of the set in parallel, over balanced chunks of the set.
+		// The operation must not change the set's contents during execution.
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, TKey const&>>>
+		const set& for_each_parallel(Callable&& operation) const
+		{
+			for_each_chunk_parallel(chunk_boundaries(), [&operation](size_t, const_set_iterator first, const_set_iterator last) {
+				for (; first != last; ++first) {
+					operation(*first);
+				}
+			});
+			return *this;
+		}
+#endif
+
 		vector<TKey> keys() const
 		{
 			vector<TKey> vec;
@@ -484,6 +687,26 @@ namespace fcpp {
 			return std::move(vec);
 		}
 
+		// Returns an immutable copy of the set with contiguous storage and O(1) lookups through a
+		// perfect hash function, for lookup tables which are built once and queried many times.
+		// Requires including "frozen_set.h". See fcpp::frozen_set for more details.
+		//
+		// example:
+		//      const fcpp::set<int> codes({200, 301, 404, 500});
+		//      const auto frozen_codes = codes.freeze();
+		//
+		//      const fcpp::set<person, person_comparator> persons({person(15, "Jake"), person(18, "Jannet")});
+		//      const auto frozen_persons = persons.freeze<person_hash>();
+		//
+		// outcome:
+		//      frozen_codes.contains(404) -> true
+		//      frozen_persons.contains(person(15, "Jake")) -> true
+		template <class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey>>
+		[[nodiscard]] frozen_set<TKey, THash, TEqual> freeze(THash hash = THash(), TEqual equal = TEqual()) const
+		{
+			return frozen_set<TKey, THash, TEqual>(begin(), end(), std::move(hash), std::move(equal));
+		}
+
 		// Removes an element from the set, if it exists, potentially changing the set's contents (mutating)
 		//
 		// example:
@@ -528,6 +751,57 @@ namespace fcpp {
 			return *this;
 		}
 
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// The batch is sorted first, so that consecutive keys are inserted with a position hint
+		// (amortized O(1) per key when they land next to each other) instead of a full tree descent.
+		//
+		// example:
+		//      fcpp::set<int> numbers({1, 4, 2});
+		//      const std::vector<int> batch({18, 3, 4, 7});
+		//      numbers.insert_range(batch.begin(), batch.end());
+		//
+		// outcome:
+		//      numbers -> fcpp::set<int>({1, 2, 3, 4, 7, 18})
+		template <typename Iterator>
+		set& insert_range(const Iterator& range_begin, const Iterator& range_end)
+		{
+			std::vector<TKey> batch(range_begin, range_end);
+			const auto compare = m_set.key_comp();
+			std::sort(batch.begin(), batch.end(), compare);
+			batch.erase(std::unique(batch.begin(),
+			                        batch.end(),
+			                        [&compare](const TKey& a, const TKey& b) {
+				                        return !compare(a, b) && !compare(b, a);
+			                        }), batch.end());
+			auto hint = m_set.begin();
+			for (const auto& key : batch) {
+				hint = m_set.insert(hint, key);
+				++hint;
+			}
+			return *this;
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		//
+		// example:
+		//      fcpp::set<int> numbers({1, 4, 2});
+		//      numbers.insert(fcpp::vector<int>({18, 3, 4, 7}));
+		//
+		// outcome:
+		//      numbers -> fcpp::set<int>({1, 2, 3, 4, 7, 18})
+		set& insert(const vector<TKey>& batch)
+		{
+			return insert_range(batch.begin(), batch.end());
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		set& insert(const std::vector<TKey>& batch)
+		{
+			return insert_range(batch.cbegin(), batch.cend());
+		}
+
 		// Returns a copy by inserting an element in the set, if it does not already exist (non-mutating)
 		//
 		// example:
@@ -598,32 +872,61 @@ namespace fcpp {
 			return m_set.count(key) != 0;
 		}
 
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		// The batch is visited in sorted order, so that the set is traversed in a single ordered sweep
+		// instead of one tree descent per key. When the batch is much smaller than the set, the sweep
+		// jumps forward with a descent instead of walking over all keys in between.
+		//
+		// example:
+		//      const fcpp::set<int> numbers({1, 4, 2});
+		//      const auto found = numbers.contains_all(fcpp::vector<int>({4, 15, 1}));
+		//
+		// outcome:
+		//      found -> std::vector<bool>({true, false, true})
+		[[nodiscard]] std::vector<bool> contains_all(const vector<TKey>& batch) const
+		{
+			return contains_all_impl(batch.begin(), batch.end());
+		}
+
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		// See contains_all for fcpp::vector for more details.
+		[[nodiscard]] std::vector<bool> contains_all(const std::vector<TKey>& batch) const
+		{
+			return contains_all_impl(batch.cbegin(), batch.cend());
+		}
+
 		// Returns the size of the vector (how many elements it contains, it may be different from its capacity)
 		[[nodiscard]] size_t size() const
 		{
 			return m_set.size();
 		}
 
+		// Returns the comparison predicate ordering the keys
+		[[nodiscard]] TCompare key_comp() const
+		{
+			return m_set.key_comp();
+		}
+
 		// Returns the begin iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::set<TKey>::iterator begin()
+		[[nodiscard]] typename std::set<TKey, TCompare>::iterator begin()
 		{
 			return m_set.begin();
 		}
 
 		// Returns the const begin iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::set<TKey>::const_iterator begin() const
+		[[nodiscard]] typename std::set<TKey, TCompare>::const_iterator begin() const
 		{
 			return m_set.begin();
 		}
 
 		// Returns the end iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::set<TKey>::iterator end()
+		[[nodiscard]] typename std::set<TKey, TCompare>::iterator end()
 		{
 			return m_set.end();
 		}
 
 		// Returns the const end iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::set<TKey>::const_iterator end() const
+		[[nodiscard]] typename std::set<TKey, TCompare>::const_iterator end() const
 		{
 			return m_set.end();
 		}
@@ -708,6 +1011,98 @@ namespace fcpp {
 			assert(index < size());
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		typedef typename std::set<TKey, TCompare>::const_iterator const_set_iterator;
+
+		// Splits the set into balanced chunks of consecutive keys, a few per hardware thread so that
+		// uneven per-key costs are balanced too. Returns the chunk boundaries, including begin and end.
+		std::vector<const_set_iterator> chunk_boundaries() const
+		{
+			const size_t thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+			const auto chunk_count = std::max<size_t>(1, std::min(size(), 4 * thread_count));
+			std::vector<const_set_iterator> boundaries;
+			boundaries.reserve(chunk_count + 1);
+			auto it = m_set.cbegin();
+			boundaries.push_back(it);
+			for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+				std::advance(it, size() * (chunk + 1) / chunk_count - size() * chunk / chunk_count);
+				boundaries.push_back(it);
+			}
+			return boundaries;
+		}
+
+		// Executes operation(chunk index, chunk begin, chunk end) for all chunks in parallel
+		template <typename Operation>
+		static void for_each_chunk_parallel(const std::vector<const_set_iterator>& boundaries, Operation&& operation)
+		{
+			std::vector<size_t> chunks(boundaries.size() - 1);
+			std::iota(chunks.begin(), chunks.end(), 0);
+			std::for_each(std::execution::par,
+			              chunks.begin(),
+			              chunks.end(),
+			              [&boundaries, &operation](size_t chunk) {
+				              operation(chunk, boundaries[chunk], boundaries[chunk + 1]);
+			              });
+		}
+
+		// Merges sorted chunks pairwise, with the merges of each round running in parallel
+		template <typename U, typename UCompare>
+		static std::vector<U> merge_sorted_chunks_parallel(std::vector<std::vector<U>> chunks, const UCompare& compare)
+		{
+			while (chunks.size() > 1) {
+				std::vector<std::vector<U>> merged((chunks.size() + 1) / 2);
+				std::vector<size_t> pairs(merged.size());
+				std::iota(pairs.begin(), pairs.end(), 0);
+				std::for_each(std::execution::par,
+				              pairs.begin(),
+				              pairs.end(),
+				              [&chunks, &merged, &compare](size_t pair) {
+					              if (2 * pair + 1 == chunks.size()) {
+						              merged[pair] = std::move(chunks[2 * pair]);
+						              return;
+					              }
+					              const auto& left = chunks[2 * pair];
+					              const auto& right = chunks[2 * pair + 1];
+					              merged[pair].reserve(left.size() + right.size());
+					              std::merge(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(merged[pair]), compare);
+				              });
+				chunks = std::move(merged);
+			}
+			return chunks.empty() ? std::vector<U>() : std::move(chunks[0]);
+		}
+#endif
+
+		template <typename Iterator>
+		std::vector<bool> contains_all_impl(const Iterator& batch_begin, const Iterator& batch_end) const
+		{
+			const auto batch_size = static_cast<size_t>(std::distance(batch_begin, batch_end));
+			std::vector<bool> found(batch_size, false);
+			std::vector<size_t> order(batch_size);
+			for (size_t i = 0; i < batch_size; ++i) {
+				order[i] = i;
+			}
+			const auto compare = m_set.key_comp();
+			std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+				return compare(*(batch_begin + a), *(batch_begin + b));
+			});
+
+			// walking the tree costs O(1) per visited key, a descent O(log n) per batch key
+			const auto use_descent = batch_size * 16 < size();
+			auto it = m_set.begin();
+			for (const auto index : order) {
+				const auto& key = *(batch_begin + index);
+				if (use_descent) {
+					it = m_set.lower_bound(key);
+				} else {
+					while (it != m_set.end() && compare(*it, key)) {
+						++it;
+					}
+				}
+				found[index] = it != m_set.end() && !compare(key, *it);
+			}
+			return found;
+		}
+
 #ifdef CPP17_AVAILABLE
 		template <typename Iterator, typename = std::enable_if_t<is_valid_iterator<Iterator>::value>>
 		[[nodiscard]] auto zip_impl(const Iterator& set_begin, const Iterator& set_end) const ->
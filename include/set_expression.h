@@ -0,0 +1,522 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "set.h"
+#include "vector.h"
+
+namespace fcpp {
+	template <class TKey, class TCompare>
+	class btree_set;
+
+	template <class TKey, size_t N, class TCompare>
+	class small_set;
+
+	namespace detail {
+		enum class set_operation
+		{
+			push_operand,
+			union_with,
+			intersect_with,
+			difference_with,
+			symmetric_difference_with
+		};
+
+		template <typename Container, typename TKey>
+		bool operand_contains(const Container& container, const TKey& key)
+		{
+			return container.contains(key);
+		}
+
+		template <typename TKey, typename TCompare>
+		bool operand_contains(const std::set<TKey, TCompare>& container, const TKey& key)
+		{
+			return container.count(key) > 0;
+		}
+	}
+
+	// A lazy set-algebra formula over ordered sets, built with the operators
+	// `|` (union), `&` (intersection), `-` (difference) and `^` (symmetric difference).
+	//
+	// Building the expression does not compute anything. The formula is evaluated only when the
+	// expression is converted to a set, iterated, counted or queried with `contains`. The evaluation
+	// is a single simultaneous merge over all operand sets: for each key (in ascending order), the
+	// formula is evaluated on which operands contain the key, so no intermediate sets are created.
+	//
+	// Operands can be fcpp::set, std::set, fcpp::btree_set, fcpp::small_set or other expressions.
+	// Operands passed as lvalues are referenced and must outlive the expression, temporary operands
+	// are moved into the expression.
+	//
+	// example:
+	//      const fcpp::set<int> a({1, 2, 3, 4});
+	//      const fcpp::set<int> b({3, 4, 5});
+	//      const fcpp::set<int> c({2, 4, 5, 6});
+	//      const fcpp::set<int> d({4});
+	//      const auto expression = ((a | b) & c) - d;
+	//
+	// outcome:
+	//      expression.contains(5) -> true
+	//      expression.size() -> 2
+	//      fcpp::set<int>(expression) -> fcpp::set<int>({2, 5})
+	template <class TKey, class TCompare = std::less<TKey>>
+	class set_expression
+	{
+		// A forward-only cursor over the keys of an operand, in ascending order
+		struct cursor
+		{
+			virtual ~cursor()
+			{
+			}
+
+			virtual bool is_done() const = 0;
+			virtual const TKey& key() const = 0;
+			virtual void advance() = 0;
+		};
+
+		struct operand
+		{
+			virtual ~operand()
+			{
+			}
+
+			virtual std::unique_ptr<cursor> open() const = 0;
+			virtual bool contains(const TKey& key) const = 0;
+		};
+
+		template <typename Iterator>
+		struct range_cursor : cursor
+		{
+			Iterator it;
+			Iterator end;
+
+			range_cursor(Iterator range_begin, Iterator range_end)
+				: it(range_begin), end(range_end)
+			{
+			}
+
+			bool is_done() const override
+			{
+				return it == end;
+			}
+
+			const TKey& key() const override
+			{
+				return *it;
+			}
+
+			void advance() override
+			{
+				++it;
+			}
+		};
+
+		template <typename Container>
+		struct container_operand : operand
+		{
+			std::shared_ptr<const Container> container;
+
+			explicit container_operand(std::shared_ptr<const Container> c)
+				: container(std::move(c))
+			{
+			}
+
+			std::unique_ptr<cursor> open() const override
+			{
+				typedef decltype(container->begin()) iterator;
+				return std::unique_ptr<cursor>(new range_cursor<iterator>(container->begin(), container->end()));
+			}
+
+			bool contains(const TKey& key) const override
+			{
+				return detail::operand_contains(*container, key);
+			}
+		};
+
+		// The formula in postfix notation: operands push whether they contain the current key,
+		// operators pop two such values and push the result
+		typedef detail::set_operation instruction_kind;
+
+		struct instruction
+		{
+			instruction_kind kind;
+			size_t operand_index;
+		};
+
+	public:
+		// An input iterator over the keys of the evaluated expression, in ascending order.
+		// Each increment advances the simultaneous merge of the operands to the next key of the result.
+		class const_iterator
+		{
+		public:
+			typedef std::input_iterator_tag iterator_category;
+			typedef TKey value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TKey* pointer;
+			typedef const TKey& reference;
+
+			const_iterator()
+				: m_state()
+			{
+			}
+
+			reference operator*() const
+			{
+				return *m_state->current;
+			}
+
+			pointer operator->() const
+			{
+				return m_state->current;
+			}
+
+			const_iterator& operator++()
+			{
+				m_state->advance_matching_operands();
+				m_state->find_next_key();
+				if (m_state->current == nullptr) {
+					m_state.reset();
+				}
+				return *this;
+			}
+
+			bool operator ==(const const_iterator& rhs) const
+			{
+				return m_state == rhs.m_state;
+			}
+
+			bool operator !=(const const_iterator& rhs) const
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+			friend class set_expression;
+
+			struct merge_state
+			{
+				const set_expression* expression;
+				std::vector<std::unique_ptr<cursor>> cursors;
+				std::vector<char> is_member;
+				std::vector<char> stack;
+				const TKey* current;
+
+				explicit merge_state(const set_expression* e)
+					: expression(e), cursors(), is_member(e->m_operands.size(), 0), stack(), current(nullptr)
+				{
+					for (const auto& o : e->m_operands) {
+						cursors.push_back(o->open());
+					}
+				}
+
+				// Moves to the smallest key (over all operands) which satisfies the formula
+				void find_next_key()
+				{
+					const auto& compare = expression->m_compare;
+					while (true) {
+						const TKey* smallest = nullptr;
+						for (const auto& c : cursors) {
+							if (!c->is_done() && (smallest == nullptr || compare(c->key(), *smallest))) {
+								smallest = &c->key();
+							}
+						}
+						current = smallest;
+						if (smallest == nullptr) {
+							return;
+						}
+						for (size_t i = 0; i < cursors.size(); ++i) {
+							is_member[i] = !cursors[i]->is_done() && !compare(*smallest, cursors[i]->key());
+						}
+						if (expression->evaluate_formula(is_member, stack)) {
+							return;
+						}
+						advance_matching_operands();
+					}
+				}
+
+				void advance_matching_operands()
+				{
+					for (size_t i = 0; i < cursors.size(); ++i) {
+						if (is_member[i]) {
+							cursors[i]->advance();
+						}
+					}
+				}
+			};
+
+			std::shared_ptr<merge_state> m_state;
+
+			explicit const_iterator(std::shared_ptr<merge_state> state)
+				: m_state(std::move(state))
+			{
+				m_state->find_next_key();
+				if (m_state->current == nullptr) {
+					m_state.reset();
+				}
+			}
+		};
+
+		// Creates an expression consisting of a single operand, referencing (lvalue) or owning (rvalue) the container.
+		// Usually not called directly, the operators create the operands.
+		template <typename Container>
+		static set_expression from_operand(std::shared_ptr<const Container> container)
+		{
+			set_expression expression;
+			expression.m_operands.push_back(std::make_shared<container_operand<Container>>(std::move(container)));
+			instruction push = {instruction_kind::push_operand, 0};
+			expression.m_formula.push_back(push);
+			return expression;
+		}
+
+		// Combines two expressions with a set operation. Usually not called directly, see the operators.
+		static set_expression combine(const set_expression& lhs, const set_expression& rhs, instruction_kind kind)
+		{
+			set_expression expression(lhs);
+			const auto offset = lhs.m_operands.size();
+			expression.m_operands.insert(expression.m_operands.end(), rhs.m_operands.begin(), rhs.m_operands.end());
+			for (auto step : rhs.m_formula) {
+				step.operand_index += offset;
+				expression.m_formula.push_back(step);
+			}
+			instruction operation = {kind, 0};
+			expression.m_formula.push_back(operation);
+			return expression;
+		}
+
+		// Returns the keys of the expression as a set, the formula is evaluated in a single pass
+		[[nodiscard]] set<TKey, TCompare> evaluate() const
+		{
+			std::set<TKey, TCompare> result(m_compare);
+			for (auto it = begin(); it != end(); ++it) {
+				result.insert(result.end(), *it);
+			}
+			return set<TKey, TCompare>(std::move(result));
+		}
+
+		operator set<TKey, TCompare>() const
+		{
+			return evaluate();
+		}
+
+		// Returns the keys of the expression in a vector, in ascending order
+		[[nodiscard]] vector<TKey> keys() const
+		{
+			return vector<TKey>(std::vector<TKey>(begin(), end()));
+		}
+
+		// Returns true if the key belongs to the expression's result, without evaluating the whole expression.
+		// Performance is one lookup per operand.
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			std::vector<char> is_member(m_operands.size(), 0);
+			for (size_t i = 0; i < m_operands.size(); ++i) {
+				is_member[i] = m_operands[i]->contains(key);
+			}
+			std::vector<char> stack;
+			return evaluate_formula(is_member, stack);
+		}
+
+		// Returns the number of keys of the expression's result, without creating a set
+		[[nodiscard]] size_t size() const
+		{
+			return static_cast<size_t>(std::distance(begin(), end()));
+		}
+
+		// Returns true if the expression's result has no keys, stopping at the first key found
+		[[nodiscard]] bool is_empty() const
+		{
+			return begin() == end();
+		}
+
+		// Executes the given operation for each key of the expression's result, in ascending order
+		template <typename Callable>
+		const set_expression& for_each(Callable&& operation) const
+		{
+			for (auto it = begin(); it != end(); ++it) {
+				operation(*it);
+			}
+			return *this;
+		}
+
+		// Returns an iterator which starts the merge of the operands. The operands must not change while iterating.
+		[[nodiscard]] const_iterator begin() const
+		{
+			return const_iterator(std::make_shared<typename const_iterator::merge_state>(this));
+		}
+
+		[[nodiscard]] const_iterator end() const
+		{
+			return const_iterator();
+		}
+
+	private:
+		std::vector<std::shared_ptr<const operand>> m_operands;
+		std::vector<instruction> m_formula;
+		TCompare m_compare;
+
+		set_expression()
+			: m_operands(), m_formula(), m_compare()
+		{
+		}
+
+		bool evaluate_formula(const std::vector<char>& is_member, std::vector<char>& stack) const
+		{
+			stack.clear();
+			for (const auto& step : m_formula) {
+				if (step.kind == instruction_kind::push_operand) {
+					stack.push_back(is_member[step.operand_index]);
+					continue;
+				}
+				const bool rhs = stack.back() != 0;
+				stack.pop_back();
+				const bool lhs = stack.back() != 0;
+				switch (step.kind) {
+					case instruction_kind::union_with:
+						stack.back() = lhs || rhs;
+						break;
+					case instruction_kind::intersect_with:
+						stack.back() = lhs && rhs;
+						break;
+					case instruction_kind::difference_with:
+						stack.back() = lhs && !rhs;
+						break;
+					default:
+						stack.back() = lhs != rhs;
+						break;
+				}
+			}
+			return stack.back() != 0;
+		}
+	};
+
+	namespace detail {
+		template <typename Container>
+		std::shared_ptr<const Container> reference_operand(const Container& container)
+		{
+			return std::shared_ptr<const Container>(&container, [](const Container*) {});
+		}
+
+		template <typename Container>
+		std::shared_ptr<const Container> own_operand(Container&& container)
+		{
+			return std::make_shared<const Container>(std::move(container));
+		}
+	}
+
+	namespace detail {
+		template <class TKey, class TCompare>
+		set_expression<TKey, TCompare> combine_operands(const set_expression<TKey, TCompare>& lhs, const set_expression<TKey, TCompare>& rhs, set_operation operation)
+		{
+			return set_expression<TKey, TCompare>::combine(lhs, rhs, operation);
+		}
+	}
+
+	// Converts an operand to a set expression, lvalue operands are referenced and rvalue operands are owned
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(const set<TKey, TCompare>& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::reference_operand(operand));
+	}
+
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(set<TKey, TCompare>&& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::own_operand(std::move(operand)));
+	}
+
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(const std::set<TKey, TCompare>& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::reference_operand(operand));
+	}
+
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(std::set<TKey, TCompare>&& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::own_operand(std::move(operand)));
+	}
+
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(const btree_set<TKey, TCompare>& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::reference_operand(operand));
+	}
+
+	template <class TKey, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(btree_set<TKey, TCompare>&& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::own_operand(std::move(operand)));
+	}
+
+	template <class TKey, size_t N, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(const small_set<TKey, N, TCompare>& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::reference_operand(operand));
+	}
+
+	template <class TKey, size_t N, class TCompare>
+	set_expression<TKey, TCompare> as_set_expression(small_set<TKey, N, TCompare>&& operand)
+	{
+		return set_expression<TKey, TCompare>::from_operand(detail::own_operand(std::move(operand)));
+	}
+
+	template <class TKey, class TCompare>
+	const set_expression<TKey, TCompare>& as_set_expression(const set_expression<TKey, TCompare>& expression)
+	{
+		return expression;
+	}
+
+	// Union (A ∪ B) of two sets or expressions, evaluated lazily
+	template <typename L, typename R>
+	auto operator |(L&& lhs, R&& rhs) -> decltype(detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::union_with))
+	{
+		return detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::union_with);
+	}
+
+	// Intersection (A ∩ B) of two sets or expressions, evaluated lazily
+	template <typename L, typename R>
+	auto operator &(L&& lhs, R&& rhs) -> decltype(detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::intersect_with))
+	{
+		return detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::intersect_with);
+	}
+
+	// Difference (A – B) of two sets or expressions, evaluated lazily
+	template <typename L, typename R>
+	auto operator -(L&& lhs, R&& rhs) -> decltype(detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::difference_with))
+	{
+		return detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::difference_with);
+	}
+
+	// Symmetric difference (keys in exactly one of A and B) of two sets or expressions, evaluated lazily
+	template <typename L, typename R>
+	auto operator ^(L&& lhs, R&& rhs) -> decltype(detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::symmetric_difference_with))
+	{
+		return detail::combine_operands(as_set_expression(std::forward<L>(lhs)), as_set_expression(std::forward<R>(rhs)), detail::set_operation::symmetric_difference_with);
+	}
+}
@@ -0,0 +1,916 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <set>
+#include <utility>
+#include <vector>
+#include "optional.h"
+#include "set.h"
+#include "vector.h"
+
+namespace fcpp {
+	// An ordered set which keeps up to N keys sorted inline, inside the object itself, and only
+	// moves them to a std::set tree when it outgrows that. Small sets (eg. permission or tag sets)
+	// therefore need no heap allocation at all, and their lookups are a linear scan over a few
+	// contiguous keys, which is faster than descending a tree for small sizes. When a large set
+	// shrinks back to N / 2 keys, the keys move inline again.
+	//
+	// The API matches fcpp::set. Inserting or removing a key invalidates all iterators.
+	//
+	// example:
+	//      fcpp::small_set<std::string, 4> permissions({"read", "write"});
+	//      permissions.insert("execute");
+	//
+	// outcome:
+	//      permissions -> fcpp::small_set<std::string, 4>({"execute", "read", "write"})
+	//      permissions.is_inline() -> true
+	template <class TKey, size_t N = 8, class TCompare = std::less<TKey>>
+	class small_set
+	{
+		static_assert(N > 0, "small_set needs room for at least one inline key");
+
+	public:
+		// A bidirectional iterator over the keys of the set, in ascending order
+		class const_iterator
+		{
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef TKey value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TKey* pointer;
+			typedef const TKey& reference;
+
+			const_iterator()
+				: m_key(nullptr), m_it(), m_is_inline(true)
+			{
+			}
+
+			reference operator*() const
+			{
+				return m_is_inline ? *m_key : *m_it;
+			}
+
+			pointer operator->() const
+			{
+				return &(**this);
+			}
+
+			const_iterator& operator++()
+			{
+				if (m_is_inline) {
+					++m_key;
+				} else {
+					++m_it;
+				}
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator copy(*this);
+				++(*this);
+				return copy;
+			}
+
+			const_iterator& operator--()
+			{
+				if (m_is_inline) {
+					--m_key;
+				} else {
+					--m_it;
+				}
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator copy(*this);
+				--(*this);
+				return copy;
+			}
+
+			bool operator ==(const const_iterator& rhs) const
+			{
+				return m_is_inline ? m_key == rhs.m_key : m_it == rhs.m_it;
+			}
+
+			bool operator !=(const const_iterator& rhs) const
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+			friend class small_set;
+
+			const TKey* m_key;
+			typename std::set<TKey, TCompare>::const_iterator m_it;
+			bool m_is_inline;
+
+			explicit const_iterator(const TKey* key)
+				: m_key(key), m_it(), m_is_inline(true)
+			{
+			}
+
+			explicit const_iterator(typename std::set<TKey, TCompare>::const_iterator it)
+				: m_key(nullptr), m_it(it), m_is_inline(false)
+			{
+			}
+		};
+
+		small_set()
+			: m_count(0), m_is_inline(true), m_large(), m_compare()
+		{
+		}
+
+		explicit small_set(const std::set<TKey, TCompare>& set)
+			: m_count(0), m_is_inline(true), m_large(set.key_comp()), m_compare(set.key_comp())
+		{
+			assign_sorted(set.begin(), set.end(), set.size());
+		}
+
+		explicit small_set(const fcpp::set<TKey, TCompare>& set)
+			: m_count(0), m_is_inline(true), m_large(set.key_comp()), m_compare(set.key_comp())
+		{
+			assign_sorted(set.begin(), set.end(), set.size());
+		}
+
+		explicit small_set(const std::vector<TKey>& vector)
+			: m_count(0), m_is_inline(true), m_large(), m_compare()
+		{
+			assign_unsorted(vector.begin(), vector.end());
+		}
+
+		explicit small_set(const vector<TKey>& vector)
+			: m_count(0), m_is_inline(true), m_large(), m_compare()
+		{
+			assign_unsorted(vector.begin(), vector.end());
+		}
+
+		explicit small_set(const std::initializer_list<TKey>& list)
+			: m_count(0), m_is_inline(true), m_large(), m_compare()
+		{
+			assign_unsorted(list.begin(), list.end());
+		}
+
+		small_set(const small_set& other)
+			: m_count(0), m_is_inline(other.m_is_inline), m_large(other.m_large), m_compare(other.m_compare)
+		{
+			for (; m_count < other.m_count; ++m_count) {
+				new (inline_keys() + m_count) TKey(other.inline_keys()[m_count]);
+			}
+		}
+
+		small_set(small_set&& other) noexcept
+			: m_count(0), m_is_inline(other.m_is_inline), m_large(std::move(other.m_large)), m_compare(std::move(other.m_compare))
+		{
+			for (; m_count < other.m_count; ++m_count) {
+				new (inline_keys() + m_count) TKey(std::move(other.inline_keys()[m_count]));
+			}
+		}
+
+		small_set& operator=(const small_set& other)
+		{
+			if (this != &other) {
+				small_set copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		small_set& operator=(small_set&& other) noexcept
+		{
+			if (this != &other) {
+				destroy_inline();
+				m_is_inline = other.m_is_inline;
+				m_large = std::move(other.m_large);
+				m_compare = std::move(other.m_compare);
+				for (; m_count < other.m_count; ++m_count) {
+					new (inline_keys() + m_count) TKey(std::move(other.inline_keys()[m_count]));
+				}
+			}
+			return *this;
+		}
+
+		~small_set()
+		{
+			destroy_inline();
+		}
+
+		// Returns true if the keys are stored inline (no heap allocation), false if they moved to a tree
+		[[nodiscard]] bool is_inline() const
+		{
+			return m_is_inline;
+		}
+
+		// Returns the set of elements which belong to the current set but not in the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the difference is the operation A – B = {x : x ∈ A and x ∉ B}
+		//
+		// example:
+		//      const fcpp::small_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::small_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& diff = set1.difference_with(set2);
+		//
+		// outcome:
+		//      diff -> fcpp::small_set<int>({1, 3, 8})
+		[[nodiscard]] small_set difference_with(const small_set& other) const
+		{
+			std::vector<TKey> diff;
+			std::set_difference(begin(), end(), other.begin(), other.end(), std::back_inserter(diff), m_compare);
+			return from_sorted(diff);
+		}
+
+		[[nodiscard]] small_set difference_with(const std::set<TKey, TCompare>& other) const
+		{
+			std::vector<TKey> diff;
+			std::set_difference(begin(), end(), other.begin(), other.end(), std::back_inserter(diff), m_compare);
+			return from_sorted(diff);
+		}
+
+		// Returns the set of elements which belong either to the current or the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the union is the operation A ∪ B = {x : x ∈ A or x ∈ B}
+		//
+		// example:
+		//      const fcpp::small_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::small_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& combined = set1.union_with(set2);
+		//
+		// outcome:
+		//      combined -> fcpp::small_set<int>({1, 2, 3, 5, 7, 8, 10, 15, 17})
+		[[nodiscard]] small_set union_with(const small_set& other) const
+		{
+			std::vector<TKey> combined;
+			std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(combined), m_compare);
+			return from_sorted(combined);
+		}
+
+		[[nodiscard]] small_set union_with(const std::set<TKey, TCompare>& other) const
+		{
+			std::vector<TKey> combined;
+			std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(combined), m_compare);
+			return from_sorted(combined);
+		}
+
+		// Returns the set of elements which belong to both the current and the other set.
+		// In Venn diagram notation, if A is the current set and B is the other set, then
+		// the intersection is the operation A ∩ B = {x : x ∈ A and x ∈ B}
+		//
+		// example:
+		//      const fcpp::small_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+		//      const fcpp::small_set<int> set2({2, 5, 7, 10, 15, 17});
+		//      const auto& intersection = set1.intersect_with(set2);
+		//
+		// outcome:
+		//      intersection -> fcpp::small_set<int>({2, 5, 7, 10})
+		[[nodiscard]] small_set intersect_with(const small_set& other) const
+		{
+			std::vector<TKey> intersection;
+			std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(intersection), m_compare);
+			return from_sorted(intersection);
+		}
+
+		[[nodiscard]] small_set intersect_with(const std::set<TKey, TCompare>& other) const
+		{
+			std::vector<TKey> intersection;
+			std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(intersection), m_compare);
+			return from_sorted(intersection);
+		}
+
+		// Returns the minimum key in the set, if it's not empty. Performance is O(1).
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+		//      auto minimum = numbers.min();
+		//
+		// outcome:
+		//      minimum.has_value() -> true
+		//      minimum.value() -> 1
+		[[nodiscard]] fcpp::optional_t<TKey> min() const
+		{
+			if (is_empty()) {
+				return fcpp::optional_t<TKey>();
+			}
+			return *begin();
+		}
+
+		// Returns the maximum key in the set, if it's not empty. Performance is O(1).
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+		//      auto maximum = numbers.max();
+		//
+		// outcome:
+		//      maximum.has_value() -> true
+		//      maximum.value() -> 8
+		[[nodiscard]] fcpp::optional_t<TKey> max() const
+		{
+			if (is_empty()) {
+				return fcpp::optional_t<TKey>();
+			}
+			return *(--end());
+		}
+
+		// Performs the functional `map` algorithm, in which every element of the resulting set is the
+		// output of applying the transform function on every element of this instance.
+		//
+		// example:
+		//      const fcpp::small_set<int> input_set({ 1, 3, -5 });
+		//      const auto output_set = input_set.map<std::string>([](const int& element) {
+		//          return std::to_string(element);
+		//      });
+		//
+		// outcome:
+		//      output_set -> fcpp::small_set<std::string>({ "-5", "1", "3" })
+#ifdef CPP17_AVAILABLE
+		template <class UKey, class UCompare = std::less<UKey>, typename Transform, typename = std::enable_if_t<
+			          std::is_invocable_r_v<UKey, Transform, TKey>>>
+#else
+		template <typename UKey, class UCompare = std::less<UKey>, typename Transform>
+#endif
+		small_set<UKey, N, UCompare> map(Transform&& transform) const
+		{
+			std::vector<UKey> transformed;
+			transformed.reserve(size());
+			for (const auto& key : *this) {
+				transformed.push_back(transform(key));
+			}
+			return small_set<UKey, N, UCompare>(transformed);
+		}
+
+		// Returns true if all keys match the predicate (return true)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.all_of([](const int &number) {
+		//          return number < 10;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool all_of(Callable&& unary_predicate) const
+		{
+			return std::all_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if at least one key match the predicate (returns true)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.any_of([](const int &number) {
+		//          return number < 5;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool any_of(Callable&& unary_predicate) const
+		{
+			return std::any_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if none of the keys match the predicate (all return false)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2, 5, 8, 3});
+		//
+		//      // returns true
+		//      numbers.none_of([](const int &number) {
+		//          return number > 10;
+		//      });
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, TKey>>>
+#else
+		template <typename Callable>
+#endif
+		bool none_of(Callable&& unary_predicate) const
+		{
+			return std::none_of(begin(),
+			                    end(),
+			                    std::forward<Callable>(unary_predicate));
+		}
+
+		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
+		// accumulating all the keys of the set to an initial value, in ascending order. (non-mutating)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2});
+		//      const auto sum = numbers.reduce(0, [](const int& partial, const int& number) {
+		//          return partial + number;
+		//      });
+		//
+		// outcome:
+		//      sum -> 7
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, TKey>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (const auto& key : *this) {
+				result = reduction(result, key);
+			}
+			return result;
+		}
+
+		// Performs the functional `filter` algorithm, in which all keys of this instance
+		// which match the given predicate are kept (mutating)
+		//
+		// example:
+		//      fcpp::small_set<int> numbers({ 1, 3, -5, 2, -1, 9, -4 });
+		//      numbers.filter([](const int& element) {
+		//          return element >= 1.5;
+		//      });
+		//
+		// outcome:
+		//      numbers -> fcpp::small_set<int>({ 2, 3, 9 });
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		small_set& filter(Filter&& predicate_to_keep)
+		{
+			*this = filtered(std::forward<Filter>(predicate_to_keep));
+			return *this;
+		}
+
+		// Performs the functional `filter` algorithm in a copy of this instance, in which all keys
+		// of the copy which match the given predicate are kept (non-mutating)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({ 1, 3, -5, 2, -1, 9, -4 });
+		//      auto filtered_numbers = numbers.filtered([](const int& element) {
+		//          return element >= 1.5;
+		//      });
+		//
+		// outcome:
+		//      filtered_numbers -> fcpp::small_set<int>({ 2, 3, 9 });
+		//      numbers -> fcpp::small_set<int>({ 1, 3, -5, 2, -1, 9, -4 });
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, TKey>>>
+#else
+		template <typename Filter>
+#endif
+		small_set filtered(Filter&& predicate_to_keep) const
+		{
+			std::vector<TKey> kept;
+			for (const auto& key : *this) {
+				if (predicate_to_keep(key)) {
+					kept.push_back(key);
+				}
+			}
+			return from_sorted(kept);
+		}
+
+		// Performs the functional `zip` algorithm, in which every key of the resulting set is a
+		// tuple of this instance's key (first) and the second set's key (second).
+		// The sizes of the two sets must be equal.
+		//
+		// example:
+		//      const fcpp::small_set<int> ages({ 25, 45, 30, 63 });
+		//      const fcpp::small_set<std::string> persons({ "Jake", "Bob", "Michael", "Philipp" });
+		//      const auto zipped = ages.zip(persons);
+		//
+		// outcome:
+		//      zipped -> fcpp::small_set<std::pair<int, std::string>>({
+		//                          std::pair<int, std::string>(25, "Bob"),
+		//                          std::pair<int, std::string>(30, "Jake"),
+		//                          std::pair<int, std::string>(45, "Michael"),
+		//                          std::pair<int, std::string>(63, "Philipp"),
+		//                       })
+		template <typename UKey, size_t M, typename UCompare>
+		[[nodiscard]] small_set<std::pair<TKey, UKey>, N> zip(const small_set<UKey, M, UCompare>& set) const
+		{
+			assert(size() == set.size());
+			std::vector<std::pair<TKey, UKey>> combined;
+			combined.reserve(size());
+			auto it1 = begin();
+			auto it2 = set.begin();
+			for (; it1 != end() && it2 != set.end(); ++it1, ++it2) {
+				combined.push_back(std::pair<TKey, UKey>(*it1, *it2));
+			}
+			return small_set<std::pair<TKey, UKey>, N>(combined);
+		}
+
+		// Performs the functional `zip` algorithm by using the unique values of the vector.
+		// The number of uniques vector values must match the set's size.
+		// For more details, see the zip function which accepts a fcpp::small_set as input.
+		template <typename UKey>
+		[[nodiscard]] small_set<std::pair<TKey, UKey>, N> zip(const vector<UKey>& vector) const
+		{
+			return zip(small_set<UKey, N>(vector));
+		}
+
+		// Executes the given operation for each key of the set, in ascending order.
+		// The operation must not change the set's contents during execution.
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, TKey const&>>>
+#else
+		template <typename Callable>
+#endif
+		const small_set& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(),
+			              end(),
+			              std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns all keys of the set in a vector, in ascending order
+		vector<TKey> keys() const
+		{
+			return vector<TKey>(std::vector<TKey>(begin(), end()));
+		}
+
+		// Returns an immutable copy of the set with O(1) lookups through a perfect hash function.
+		// Requires including "frozen_set.h". See fcpp::set::freeze for more details.
+		template <class THash = std::hash<TKey>, class TEqual = std::equal_to<TKey>>
+		[[nodiscard]] frozen_set<TKey, THash, TEqual> freeze(THash hash = THash(), TEqual equal = TEqual()) const
+		{
+			return frozen_set<TKey, THash, TEqual>(begin(), end(), std::move(hash), std::move(equal));
+		}
+
+		// Removes an element from the set, if it exists, potentially changing the set's contents (mutating)
+		//
+		// example:
+		//      fcpp::small_set<int> numbers({1, 4, 2});
+		//      numbers.remove(4);
+		//
+		// outcome:
+		//      numbers -> fcpp::small_set<int>({1, 2})
+		small_set& remove(const TKey& element)
+		{
+			if (!m_is_inline) {
+				m_large.erase(element);
+				if (m_large.size() <= N / 2) {
+					move_inline();
+				}
+				return *this;
+			}
+			const auto position = inline_lower_bound(element);
+			if (position < m_count && !m_compare(element, inline_keys()[position])) {
+				const auto keys = inline_keys();
+				std::move(keys + position + 1, keys + m_count, keys + position);
+				keys[m_count - 1].~TKey();
+				--m_count;
+			}
+			return *this;
+		}
+
+		// Returns a copy by removing an element from the set, if it exists (non-mutating)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2});
+		//      auto less_numbers = numbers.removing(4);
+		//
+		// outcome:
+		//      less_numbers -> fcpp::small_set<int>({1, 2})
+		//      numbers -> fcpp::small_set<int>({1, 2, 4})
+		[[nodiscard]] small_set removing(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.remove(element);
+			return copy;
+		}
+
+		// Inserts an element in the set, if it does not already exist, potentially changing the set's contents (mutating).
+		// The keys move to a std::set when the set outgrows its N inline keys.
+		//
+		// example:
+		//      fcpp::small_set<int> numbers({1, 4, 2});
+		//      numbers.insert(18);
+		//
+		// outcome:
+		//      numbers -> fcpp::small_set<int>({1, 2, 4, 18})
+		small_set& insert(const TKey& element)
+		{
+			if (!m_is_inline) {
+				m_large.insert(element);
+				return *this;
+			}
+			const auto position = inline_lower_bound(element);
+			if (position < m_count && !m_compare(element, inline_keys()[position])) {
+				return *this;
+			}
+			if (m_count == N) {
+				move_to_tree();
+				m_large.insert(element);
+				return *this;
+			}
+			const auto keys = inline_keys();
+			if (position == m_count) {
+				new (keys + m_count) TKey(element);
+			} else {
+				new (keys + m_count) TKey(std::move(keys[m_count - 1]));
+				std::move_backward(keys + position, keys + m_count - 1, keys + m_count);
+				keys[position] = element;
+			}
+			++m_count;
+			return *this;
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		//
+		// example:
+		//      fcpp::small_set<int> numbers({1, 4, 2});
+		//      const std::vector<int> batch({18, 3, 4, 7});
+		//      numbers.insert_range(batch.begin(), batch.end());
+		//
+		// outcome:
+		//      numbers -> fcpp::small_set<int>({1, 2, 3, 4, 7, 18})
+		template <typename Iterator>
+		small_set& insert_range(const Iterator& range_begin, const Iterator& range_end)
+		{
+			// the keys stay inline until the set is full, and the rest of the batch goes to the tree
+			auto it = range_begin;
+			for (; it != range_end && m_is_inline; ++it) {
+				insert(*it);
+			}
+			m_large.insert(it, range_end);
+			return *this;
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		small_set& insert(const vector<TKey>& batch)
+		{
+			return insert_range(batch.begin(), batch.end());
+		}
+
+		// Inserts a batch of elements in the set, ignoring the ones which already exist (mutating).
+		// See insert_range for more details.
+		small_set& insert(const std::vector<TKey>& batch)
+		{
+			return insert_range(batch.cbegin(), batch.cend());
+		}
+
+		// Returns a copy by inserting an element in the set, if it does not already exist (non-mutating)
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2});
+		//      auto augmented_numbers =  numbers.inserting(18);
+		//
+		// outcome:
+		//      augmented_numbers -> fcpp::small_set<int>({1, 2, 4, 18})
+		//      numbers -> fcpp::small_set<int>({1, 2, 4})
+		[[nodiscard]] small_set inserting(const TKey& element) const
+		{
+			auto copy(*this);
+			copy.insert(element);
+			return copy;
+		}
+
+		// Removes all keys from the set, returning to the inline storage (mutating)
+		small_set& clear()
+		{
+			destroy_inline();
+			m_large.clear();
+			m_is_inline = true;
+			return *this;
+		}
+
+		// Returns a new set by clearing all keys from the current set (non-mutating)
+		[[nodiscard]] small_set clearing() const
+		{
+			return small_set();
+		}
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const
+		{
+			return size() == 0;
+		}
+
+		// Returns true if the key is present in the set, otherwise false.
+		// While the keys are inline, this is a linear scan over at most N contiguous keys.
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2});
+		//      numbers.contains(1); // true
+		//      numbers.contains(15); // false
+		[[nodiscard]] bool contains(const TKey& key) const
+		{
+			if (!m_is_inline) {
+				return m_large.count(key) != 0;
+			}
+			const auto position = inline_lower_bound(key);
+			return position < m_count && !m_compare(key, inline_keys()[position]);
+		}
+
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		//
+		// example:
+		//      const fcpp::small_set<int> numbers({1, 4, 2});
+		//      const auto found = numbers.contains_all(fcpp::vector<int>({4, 15, 1}));
+		//
+		// outcome:
+		//      found -> std::vector<bool>({true, false, true})
+		[[nodiscard]] std::vector<bool> contains_all(const vector<TKey>& batch) const
+		{
+			return contains_all(std::vector<TKey>(batch.begin(), batch.end()));
+		}
+
+		// Returns for each key of the batch whether it is present in the set, at the same index as the key.
+		[[nodiscard]] std::vector<bool> contains_all(const std::vector<TKey>& batch) const
+		{
+			std::vector<bool> found(batch.size(), false);
+			for (size_t i = 0; i < batch.size(); ++i) {
+				found[i] = contains(batch[i]);
+			}
+			return found;
+		}
+
+		// Returns the size of the set (how many keys it contains)
+		[[nodiscard]] size_t size() const
+		{
+			return m_is_inline ? m_count : m_large.size();
+		}
+
+		// Returns the const begin iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator begin() const
+		{
+			return m_is_inline
+				? const_iterator(inline_keys())
+				: const_iterator(m_large.begin());
+		}
+
+		// Returns the const end iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator end() const
+		{
+			return m_is_inline
+				? const_iterator(inline_keys() + m_count)
+				: const_iterator(m_large.end());
+		}
+
+		// Returns the given key in the current set, allowing subscripting.
+		// Bounds checking (assert) is enabled for debug builds.
+		// Performance is O(1) while the keys are inline, otherwise O(n).
+		TKey operator[](size_t index) const
+		{
+			assert(index < size());
+			if (m_is_inline) {
+				return inline_keys()[index];
+			}
+			auto it = m_large.begin();
+			std::advance(it, index);
+			return *it;
+		}
+
+		// Returns true if both instances have equal sizes and the corresponding elements (keys) are equal
+		bool operator ==(const small_set& rhs) const
+		{
+			if (size() != rhs.size()) {
+				return false;
+			}
+			auto it1 = begin();
+			auto it2 = rhs.begin();
+			for (; it1 != end(); ++it1, ++it2) {
+				if (!(*it1 == *it2)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Returns false if either the sizes are not equal or at least one corresponding element (key) is not equal
+		bool operator !=(const small_set& rhs) const
+		{
+			return !((*this) == rhs);
+		}
+
+	private:
+		alignas(TKey) unsigned char m_storage[sizeof(TKey) * N];
+		size_t m_count;
+		bool m_is_inline;
+		std::set<TKey, TCompare> m_large;
+		TCompare m_compare;
+
+		TKey* inline_keys()
+		{
+			return reinterpret_cast<TKey*>(m_storage);
+		}
+
+		const TKey* inline_keys() const
+		{
+			return reinterpret_cast<const TKey*>(m_storage);
+		}
+
+		// Linear scan for the first inline key which is not less than the given key,
+		// for a few keys this is faster than a binary search, which mispredicts its branches
+		size_t inline_lower_bound(const TKey& key) const
+		{
+			const auto keys = inline_keys();
+			size_t position = 0;
+			while (position < m_count && m_compare(keys[position], key)) {
+				++position;
+			}
+			return position;
+		}
+
+		void destroy_inline()
+		{
+			for (size_t i = 0; i < m_count; ++i) {
+				inline_keys()[i].~TKey();
+			}
+			m_count = 0;
+		}
+
+		void move_to_tree()
+		{
+			const auto keys = inline_keys();
+			for (size_t i = 0; i < m_count; ++i) {
+				m_large.insert(m_large.end(), std::move(keys[i]));
+			}
+			destroy_inline();
+			m_is_inline = false;
+		}
+
+		void move_inline()
+		{
+			for (auto it = m_large.begin(); it != m_large.end(); ++it, ++m_count) {
+				new (inline_keys() + m_count) TKey(*it);
+			}
+			m_large.clear();
+			m_is_inline = true;
+		}
+
+		// Replaces the contents with the given sorted unique keys
+		template <typename Iterator>
+		void assign_sorted(const Iterator& range_begin, const Iterator& range_end, size_t count)
+		{
+			clear();
+			if (count <= N) {
+				for (auto it = range_begin; it != range_end; ++it, ++m_count) {
+					new (inline_keys() + m_count) TKey(*it);
+				}
+			} else {
+				m_large.insert(range_begin, range_end);
+				m_is_inline = false;
+			}
+		}
+
+		template <typename Iterator>
+		void assign_unsorted(const Iterator& range_begin, const Iterator& range_end)
+		{
+			std::vector<TKey> keys(range_begin, range_end);
+			std::sort(keys.begin(), keys.end(), m_compare);
+			const auto compare = m_compare;
+			keys.erase(std::unique(keys.begin(),
+			                       keys.end(),
+			                       [&compare](const TKey& a, const TKey& b) {
+				                       return !compare(a, b) && !compare(b, a);
+			                       }), keys.end());
+			assign_sorted(keys.begin(), keys.end(), keys.size());
+		}
+
+		small_set from_sorted(const std::vector<TKey>& keys) const
+		{
+			small_set result;
+			result.m_large = std::set<TKey, TCompare>(m_compare);
+			result.m_compare = m_compare;
+			result.assign_sorted(keys.begin(), keys.end(), keys.size());
+			return result;
+		}
+	};
+}
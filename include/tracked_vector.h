@@ -0,0 +1,797 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <vector>
+#include "index_range.h"
+#include "optional.h"
+#include "vector.h"
+
+namespace fcpp {
+
+	// Receives the changes of a tracked_vector, so that values derived from its elements can be updated
+	// without scanning the whole vector. The notifications only contain the changed positions.
+	template <typename T>
+	class tracked_vector_observer
+	{
+	public:
+		virtual ~tracked_vector_observer()
+		{
+		}
+
+		// Called after `count` elements were inserted at `index`, they are source[index] ... source[index + count - 1]
+		virtual void inserted(const vector<T>& source, size_t index, size_t count) = 0;
+
+		// Called before the `count` elements starting at `index` are removed from the source
+		virtual void removing(const vector<T>& source, size_t index, size_t count) = 0;
+
+		// Called before the elements starting at `index` are replaced by `values`, all at once, so that an
+		// observer can update a range in one pass. The old elements are source[index] ... source[index + values.size() - 1]
+		virtual void replacing(const vector<T>& source, size_t index, const vector<T>& values) = 0;
+	};
+
+	namespace detail {
+		template <typename R>
+		class aggregate_state
+		{
+		public:
+			virtual ~aggregate_state()
+			{
+			}
+
+			virtual R value() const = 0;
+		};
+
+		// A fold whose effect can be undone for a removed element, e.g. a sum with plus and minus
+		template <typename T, typename R, typename Fold, typename Unfold>
+		class invertible_fold : public tracked_vector_observer<T>, public aggregate_state<R>
+		{
+		public:
+			invertible_fold(const vector<T>& source, R initial, Fold fold, Unfold unfold)
+				: m_value(std::move(initial)),
+				m_fold(std::move(fold)),
+				m_unfold(std::move(unfold))
+			{
+				inserted(source, 0, source.size());
+			}
+
+			void inserted(const vector<T>& source, size_t index, size_t count) override
+			{
+				for (size_t i = index; i < index + count; ++i) {
+					m_value = m_fold(m_value, source[i]);
+				}
+			}
+
+			void removing(const vector<T>& source, size_t index, size_t count) override
+			{
+				for (size_t i = index; i < index + count; ++i) {
+					m_value = m_unfold(m_value, source[i]);
+				}
+			}
+
+			void replacing(const vector<T>& source, size_t index, const vector<T>& values) override
+			{
+				for (size_t i = 0; i < values.size(); ++i) {
+					m_value = m_fold(m_unfold(m_value, source[index + i]), values[i]);
+				}
+			}
+
+			R value() const override
+			{
+				return m_value;
+			}
+
+		private:
+			R m_value;
+			Fold m_fold;
+			Unfold m_unfold;
+		};
+
+		// Counts the elements satisfying a predicate, and reports either whether all or whether any of them do
+		template <typename T, typename Predicate>
+		class predicate_aggregate : public tracked_vector_observer<T>, public aggregate_state<bool>
+		{
+		public:
+			predicate_aggregate(const vector<T>& source, Predicate predicate, bool requires_all)
+				: m_predicate(std::move(predicate)),
+				m_requires_all(requires_all),
+				m_matching(0),
+				m_total(0)
+			{
+				inserted(source, 0, source.size());
+			}
+
+			void inserted(const vector<T>& source, size_t index, size_t count) override
+			{
+				for (size_t i = index; i < index + count; ++i) {
+					m_matching += m_predicate(source[i]) ? 1 : 0;
+				}
+				m_total += count;
+			}
+
+			void removing(const vector<T>& source, size_t index, size_t count) override
+			{
+				for (size_t i = index; i < index + count; ++i) {
+					m_matching -= m_predicate(source[i]) ? 1 : 0;
+				}
+				m_total -= count;
+			}
+
+			void replacing(const vector<T>& source, size_t index, const vector<T>& values) override
+			{
+				for (size_t i = 0; i < values.size(); ++i) {
+					m_matching -= m_predicate(source[index + i]) ? 1 : 0;
+					m_matching += m_predicate(values[i]) ? 1 : 0;
+				}
+			}
+
+			bool value() const override
+			{
+				return m_requires_all ? m_matching == m_total : m_matching > 0;
+			}
+
+		private:
+			Predicate m_predicate;
+			bool m_requires_all;
+			size_t m_matching;
+			size_t m_total;
+		};
+
+		// The elements satisfying a predicate in their source order, with their source positions
+		// kept aside so that a change only touches the affected positions
+		template <typename T>
+		class filtered_view_state : public tracked_vector_observer<T>
+		{
+		public:
+			filtered_view_state(const vector<T>& source, std::function<bool(const T&)> predicate)
+				: m_predicate(std::move(predicate))
+			{
+				inserted(source, 0, source.size());
+			}
+
+			void inserted(const vector<T>& source, size_t index, size_t count) override
+			{
+				const auto first = lower_bound(index);
+				for (size_t i = first; i < m_positions.size(); ++i) {
+					m_positions[i] += count;
+				}
+				std::vector<size_t> positions;
+				std::vector<T> values;
+				for (size_t i = index; i < index + count; ++i) {
+					if (m_predicate(source[i])) {
+						positions.push_back(i);
+						values.push_back(source[i]);
+					}
+				}
+				m_positions.insert(m_positions.begin() + first, positions.begin(), positions.end());
+				m_values.insert(m_values.begin() + first, values.begin(), values.end());
+			}
+
+			void removing(const vector<T>&, size_t index, size_t count) override
+			{
+				const auto first = lower_bound(index);
+				const auto last = lower_bound(index + count);
+				m_positions.erase(m_positions.begin() + first, m_positions.begin() + last);
+				m_values.erase(m_values.begin() + first, m_values.begin() + last);
+				for (size_t i = first; i < m_positions.size(); ++i) {
+					m_positions[i] -= count;
+				}
+			}
+
+			// The matching elements of the replaced range are spliced in at once, so replacing k elements
+			// moves the following positions at most once instead of once per element
+			void replacing(const vector<T>&, size_t index, const vector<T>& values) override
+			{
+				const auto first = lower_bound(index);
+				const auto last = lower_bound(index + values.size());
+				std::vector<size_t> positions;
+				std::vector<T> matching;
+				for (size_t i = 0; i < values.size(); ++i) {
+					if (m_predicate(values[i])) {
+						positions.push_back(index + i);
+						matching.push_back(values[i]);
+					}
+				}
+				const auto common = std::min(last - first, positions.size());
+				std::copy(positions.begin(), positions.begin() + common, m_positions.begin() + first);
+				std::copy(matching.begin(), matching.begin() + common, m_values.begin() + first);
+				if (positions.size() < last - first) {
+					m_positions.erase(m_positions.begin() + first + common, m_positions.begin() + last);
+					m_values.erase(m_values.begin() + first + common, m_values.begin() + last);
+				} else {
+					m_positions.insert(m_positions.begin() + last, positions.begin() + common, positions.end());
+					m_values.insert(m_values.begin() + last, matching.begin() + common, matching.end());
+				}
+			}
+
+			const std::vector<T>& values() const
+			{
+				return m_values;
+			}
+
+		private:
+			std::function<bool(const T&)> m_predicate;
+			std::vector<size_t> m_positions;
+			std::vector<T> m_values;
+
+			size_t lower_bound(size_t source_index) const
+			{
+				return std::lower_bound(m_positions.begin(), m_positions.end(), source_index) - m_positions.begin();
+			}
+		};
+
+		// The elements ordered in a multiset, with the multiset node of every source position kept aside
+		// so that a removed or replaced element is found without searching
+		template <typename T, typename TCompare>
+		class sorted_view_state : public tracked_vector_observer<T>
+		{
+		public:
+			typedef std::multiset<T, TCompare> element_set;
+
+			sorted_view_state(const vector<T>& source, TCompare comparison)
+				: m_elements(comparison)
+			{
+				inserted(source, 0, source.size());
+			}
+
+			void inserted(const vector<T>& source, size_t index, size_t count) override
+			{
+				std::vector<typename element_set::iterator> nodes;
+				nodes.reserve(count);
+				for (size_t i = index; i < index + count; ++i) {
+					nodes.push_back(m_elements.insert(source[i]));
+				}
+				m_nodes.insert(m_nodes.begin() + index, nodes.begin(), nodes.end());
+			}
+
+			void removing(const vector<T>&, size_t index, size_t count) override
+			{
+				for (size_t i = index; i < index + count; ++i) {
+					m_elements.erase(m_nodes[i]);
+				}
+				m_nodes.erase(m_nodes.begin() + index, m_nodes.begin() + index + count);
+			}
+
+			void replacing(const vector<T>&, size_t index, const vector<T>& values) override
+			{
+				for (size_t i = 0; i < values.size(); ++i) {
+					m_elements.erase(m_nodes[index + i]);
+					m_nodes[index + i] = m_elements.insert(values[i]);
+				}
+			}
+
+			const element_set& elements() const
+			{
+				return m_elements;
+			}
+
+		private:
+			element_set m_elements;
+			std::vector<typename element_set::iterator> m_nodes;
+		};
+
+		// The smallest (or largest) element, the elements are kept ordered in a multiset since
+		// a minimum cannot be undone for a removed element. The multiset node of every source position is
+		// kept (see sorted_view_state), so that removing an element among equivalent ones erases that element.
+		template <typename T, typename TCompare>
+		class extremum_aggregate : public sorted_view_state<T, TCompare>, public aggregate_state<optional_t<T>>
+		{
+		public:
+			extremum_aggregate(const vector<T>& source, TCompare comparison, bool largest)
+				: sorted_view_state<T, TCompare>(source, std::move(comparison)),
+				m_largest(largest)
+			{
+			}
+
+			optional_t<T> value() const override
+			{
+				const auto& elements = this->elements();
+				optional_t<T> result;
+				if (!elements.empty()) {
+					result = m_largest ? *elements.rbegin() : *elements.begin();
+				}
+				return result;
+			}
+
+		private:
+			bool m_largest;
+		};
+	}
+
+	// A handle to an aggregate registered in a tracked_vector, whose value is always up to date.
+	// The aggregate stops being updated when its last handle is destroyed.
+	template <typename R>
+	class tracked_aggregate
+	{
+	public:
+		explicit tracked_aggregate(std::shared_ptr<const detail::aggregate_state<R>> state)
+			: m_state(std::move(state))
+		{
+		}
+
+		// Returns the current value of the aggregate
+		[[nodiscard]] R value() const
+		{
+			return m_state->value();
+		}
+
+	private:
+		std::shared_ptr<const detail::aggregate_state<R>> m_state;
+	};
+
+	// A handle to a filtered view of a tracked_vector: the elements satisfying the predicate, in their
+	// order in the tracked_vector. The view stops being updated when its last handle is destroyed.
+	template <typename T>
+	class tracked_filtered_view
+	{
+	public:
+		explicit tracked_filtered_view(std::shared_ptr<const detail::filtered_view_state<T>> state)
+			: m_state(std::move(state))
+		{
+		}
+
+		// Returns a copy of the elements of the view
+		[[nodiscard]] vector<T> values() const
+		{
+			return vector<T>(m_state->values());
+		}
+
+		[[nodiscard]] size_t size() const
+		{
+			return m_state->values().size();
+		}
+
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_state->values().empty();
+		}
+
+		const T& operator[](size_t index) const
+		{
+			return m_state->values()[index];
+		}
+
+		typename std::vector<T>::const_iterator begin() const
+		{
+			return m_state->values().begin();
+		}
+
+		typename std::vector<T>::const_iterator end() const
+		{
+			return m_state->values().end();
+		}
+
+	private:
+		std::shared_ptr<const detail::filtered_view_state<T>> m_state;
+	};
+
+	// A handle to a sorted view of a tracked_vector. The view stops being updated when its last
+	// handle is destroyed.
+	template <typename T, typename TCompare>
+	class tracked_sorted_view
+	{
+	public:
+		typedef typename detail::sorted_view_state<T, TCompare>::element_set::const_iterator const_iterator;
+
+		explicit tracked_sorted_view(std::shared_ptr<const detail::sorted_view_state<T, TCompare>> state)
+			: m_state(std::move(state))
+		{
+		}
+
+		// Returns a copy of the elements of the view
+		[[nodiscard]] vector<T> values() const
+		{
+			return vector<T>(std::vector<T>(begin(), end()));
+		}
+
+		[[nodiscard]] size_t size() const
+		{
+			return m_state->elements().size();
+		}
+
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_state->elements().empty();
+		}
+
+		const_iterator begin() const
+		{
+			return m_state->elements().begin();
+		}
+
+		const_iterator end() const
+		{
+			return m_state->elements().end();
+		}
+
+	private:
+		std::shared_ptr<const detail::sorted_view_state<T, TCompare>> m_state;
+	};
+
+	// A vector which keeps registered aggregates (sum, count_if, all_of, min, max or any invertible fold)
+	// up to date as it is mutated, so that reading them never scans the elements. Every mutation costs
+	// O(1) per changed element for each aggregate (O(log n) for min and max). The elements can only be
+	// changed through the mutating functions below, the contents are accessible as an fcpp::vector.
+	// Filtered and sorted views (track_filtered, track_sorted) are maintained the same way.
+	//
+	// example:
+	//      fcpp::tracked_vector<int> numbers(fcpp::vector<int>({ 1, 4, 2 }));
+	//      const auto sum = numbers.track_sum();
+	//      const auto largest = numbers.track_max();
+	//      numbers.insert_back(7).remove_at(1);
+	//
+	// outcome:
+	//      numbers.values() -> fcpp::vector<int>({ 1, 2, 7 })
+	//      sum.value() -> 10
+	//      largest.value() -> 7
+	template <typename T>
+	class tracked_vector
+	{
+	public:
+		tracked_vector()
+		{
+		}
+
+		explicit tracked_vector(vector<T> values)
+			: m_values(std::move(values))
+		{
+		}
+
+		tracked_vector(const tracked_vector&) = delete;
+		tracked_vector& operator =(const tracked_vector&) = delete;
+
+		// Returns the elements
+		[[nodiscard]] const vector<T>& values() const
+		{
+			return m_values;
+		}
+
+		[[nodiscard]] size_t size() const
+		{
+			return m_values.size();
+		}
+
+		[[nodiscard]] bool is_empty() const
+		{
+			return m_values.is_empty();
+		}
+
+		const T& operator[](size_t index) const
+		{
+			return m_values[index];
+		}
+
+		typename std::vector<T>::const_iterator begin() const
+		{
+			return m_values.begin();
+		}
+
+		typename std::vector<T>::const_iterator end() const
+		{
+			return m_values.end();
+		}
+
+		// Registers an observer which is notified of every subsequent change, the observer is only
+		// referenced weakly and is dropped once it is destroyed
+		tracked_vector& add_observer(const std::shared_ptr<tracked_vector_observer<T>>& observer)
+		{
+			m_observers.push_back(observer);
+			return *this;
+		}
+
+		// Tracks a fold which can be undone: `unfold(fold(r, x), x)` must equal `r`
+		//
+		// example:
+		//      fcpp::tracked_vector<int> numbers(fcpp::vector<int>({ 1, 4, 2 }));
+		//      const auto squares = numbers.track_fold(0, [](int sum, const int& x) {
+		//          return sum + x * x;
+		//      }, [](int sum, const int& x) {
+		//          return sum - x * x;
+		//      });
+		//
+		// outcome:
+		//      squares.value() -> 21
+		template <typename R, typename Fold, typename Unfold>
+		tracked_aggregate<R> track_fold(R initial, Fold fold, Unfold unfold)
+		{
+			return track<R>(std::make_shared<detail::invertible_fold<T, R, Fold, Unfold>>(m_values, std::move(initial), std::move(fold), std::move(unfold)));
+		}
+
+		// Tracks the sum of the elements
+		tracked_aggregate<T> track_sum()
+		{
+			return track_fold(T(), std::plus<T>(), std::minus<T>());
+		}
+
+		// Tracks the number of elements satisfying the predicate
+		template <typename Predicate>
+		tracked_aggregate<size_t> track_count_if(Predicate predicate)
+		{
+			return track_fold(static_cast<size_t>(0), [predicate](size_t count, const T& element) {
+				return count + (predicate(element) ? 1 : 0);
+			}, [predicate](size_t count, const T& element) {
+				return count - (predicate(element) ? 1 : 0);
+			});
+		}
+
+		// Tracks whether all elements satisfy the predicate (true for an empty vector)
+		template <typename Predicate>
+		tracked_aggregate<bool> track_all_of(Predicate predicate)
+		{
+			return track<bool>(std::make_shared<detail::predicate_aggregate<T, Predicate>>(m_values, std::move(predicate), true));
+		}
+
+		// Tracks whether any element satisfies the predicate (false for an empty vector)
+		template <typename Predicate>
+		tracked_aggregate<bool> track_any_of(Predicate predicate)
+		{
+			return track<bool>(std::make_shared<detail::predicate_aggregate<T, Predicate>>(m_values, std::move(predicate), false));
+		}
+
+		// Tracks the smallest element, which is empty for an empty vector
+		template <typename TCompare = std::less<T>>
+		tracked_aggregate<optional_t<T>> track_min(TCompare comparison = TCompare())
+		{
+			return track<optional_t<T>>(std::make_shared<detail::extremum_aggregate<T, TCompare>>(m_values, std::move(comparison), false));
+		}
+
+		// Tracks the largest element, which is empty for an empty vector
+		template <typename TCompare = std::less<T>>
+		tracked_aggregate<optional_t<T>> track_max(TCompare comparison = TCompare())
+		{
+			return track<optional_t<T>>(std::make_shared<detail::extremum_aggregate<T, TCompare>>(m_values, std::move(comparison), true));
+		}
+
+		// Creates a view of the elements satisfying the predicate, in their order in the vector, which
+		// is kept up to date as the vector is mutated. Appending or removing k elements at the back costs
+		// O(k), changes in the middle additionally shift the source positions stored in the view.
+		//
+		// example:
+		//      fcpp::tracked_vector<int> numbers(fcpp::vector<int>({ 1, 4, 2, 5 }));
+		//      const auto evens = numbers.track_filtered([](const int& x) {
+		//          return x % 2 == 0;
+		//      });
+		//      numbers.insert_back(6).remove_at(1);
+		//
+		// outcome:
+		//      evens.values() -> fcpp::vector<int>({ 2, 6 })
+		template <typename Filter>
+		tracked_filtered_view<T> track_filtered(Filter&& predicate_to_keep)
+		{
+			const auto state = std::make_shared<detail::filtered_view_state<T>>(m_values, std::forward<Filter>(predicate_to_keep));
+			add_observer(state);
+			return tracked_filtered_view<T>(state);
+		}
+
+		// Creates a view of the elements sorted with the comparison predicate, which is kept up to date
+		// as the vector is mutated. Every changed element costs O(log n), changes in the middle of the
+		// vector additionally shift the positions stored in the view.
+		//
+		// example:
+		//      fcpp::tracked_vector<int> numbers(fcpp::vector<int>({ 1, 4, 2, 5 }));
+		//      const auto ascending = numbers.track_sorted();
+		//      numbers.insert_back(3).remove_at(0);
+		//
+		// outcome:
+		//      ascending.values() -> fcpp::vector<int>({ 2, 3, 4, 5 })
+		template <typename TCompare = std::less<T>>
+		tracked_sorted_view<T, TCompare> track_sorted(TCompare comparison = TCompare())
+		{
+			const auto state = std::make_shared<detail::sorted_view_state<T, TCompare>>(m_values, std::move(comparison));
+			add_observer(state);
+			return tracked_sorted_view<T, TCompare>(state);
+		}
+
+		// Inserts an element at the end (mutating)
+		tracked_vector& insert_back(T value)
+		{
+			m_values.insert_back(std::move(value));
+			notify_inserted(size() - 1, 1);
+			return *this;
+		}
+
+		// Inserts the elements of the vector at the end (mutating)
+		tracked_vector& insert_back(const vector<T>& values)
+		{
+			const auto index = size();
+			m_values.insert_back(values);
+			notify_inserted(index, values.size());
+			return *this;
+		}
+
+		tracked_vector& insert_back(const std::initializer_list<T>& list)
+		{
+			return insert_back(vector<T>(list));
+		}
+
+		// Inserts an element at the beginning (mutating)
+		tracked_vector& insert_front(T value)
+		{
+			m_values.insert_front(std::move(value));
+			notify_inserted(0, 1);
+			return *this;
+		}
+
+		// Inserts the elements of the vector at the beginning (mutating)
+		tracked_vector& insert_front(const vector<T>& values)
+		{
+			m_values.insert_front(values);
+			notify_inserted(0, values.size());
+			return *this;
+		}
+
+		tracked_vector& insert_front(const std::initializer_list<T>& list)
+		{
+			return insert_front(vector<T>(list));
+		}
+
+		// Inserts an element at the given index (mutating)
+		tracked_vector& insert_at(size_t index, const T& element)
+		{
+			m_values.insert_at(index, element);
+			notify_inserted(index, 1);
+			return *this;
+		}
+
+		// Inserts the elements of the vector at the given index (mutating)
+		tracked_vector& insert_at(size_t index, const vector<T>& values)
+		{
+			m_values.insert_at(index, values);
+			notify_inserted(index, values.size());
+			return *this;
+		}
+
+		// Removes the element at `index` (mutating)
+		tracked_vector& remove_at(size_t index)
+		{
+			assert(index < size());
+			notify_removing(index, 1);
+			m_values.remove_at(index);
+			return *this;
+		}
+
+		// Removes the last element, if present (mutating)
+		tracked_vector& remove_back()
+		{
+			if (is_empty()) {
+				return *this;
+			}
+			return remove_at(size() - 1);
+		}
+
+		// Removes the first element, if present (mutating)
+		tracked_vector& remove_front()
+		{
+			if (is_empty()) {
+				return *this;
+			}
+			return remove_at(0);
+		}
+
+		// Removes the elements whose index is contained in the given index range (mutating)
+		tracked_vector& remove_range(index_range range)
+		{
+			if (!range.is_valid || size() < range.end + 1) {
+				return *this;
+			}
+			notify_removing(range.start, range.count);
+			m_values.remove_range(range);
+			return *this;
+		}
+
+		// Replaces the existing contents starting at `index` with the contents of the given vector (mutating)
+		tracked_vector& replace_range_at(size_t index, const vector<T>& values)
+		{
+			assert(index + values.size() <= size());
+			notify_replacing(index, values);
+			m_values.replace_range_at(index, values);
+			return *this;
+		}
+
+		tracked_vector& replace_range_at(size_t index, const std::initializer_list<T>& list)
+		{
+			return replace_range_at(index, vector<T>(list));
+		}
+
+		// Replaces all existing elements with a constant element (mutating)
+		tracked_vector& fill(const T& element)
+		{
+			return replace_range_at(0, vector<T>(size(), element));
+		}
+
+		// Removes all elements (mutating)
+		tracked_vector& clear()
+		{
+			notify_removing(0, size());
+			m_values.clear();
+			return *this;
+		}
+
+	private:
+		vector<T> m_values;
+		std::vector<std::weak_ptr<tracked_vector_observer<T>>> m_observers;
+
+		template <typename R, typename Aggregate>
+		tracked_aggregate<R> track(const std::shared_ptr<Aggregate>& aggregate)
+		{
+			add_observer(aggregate);
+			return tracked_aggregate<R>(aggregate);
+		}
+
+		// Calls the function for every live observer, and drops the destroyed ones
+		template <typename Notify>
+		void for_each_observer(Notify notify)
+		{
+			size_t live = 0;
+			for (size_t i = 0; i < m_observers.size(); ++i) {
+				const auto observer = m_observers[i].lock();
+				if (!observer) {
+					continue;
+				}
+				notify(*observer);
+				m_observers[live++] = m_observers[i];
+			}
+			m_observers.resize(live);
+		}
+
+		void notify_inserted(size_t index, size_t count)
+		{
+			if (count == 0) {
+				return;
+			}
+			const auto& values = m_values;
+			for_each_observer([&values, index, count](tracked_vector_observer<T>& observer) {
+				observer.inserted(values, index, count);
+			});
+		}
+
+		void notify_removing(size_t index, size_t count)
+		{
+			if (count == 0) {
+				return;
+			}
+			const auto& values = m_values;
+			for_each_observer([&values, index, count](tracked_vector_observer<T>& observer) {
+				observer.removing(values, index, count);
+			});
+		}
+
+		void notify_replacing(size_t index, const vector<T>& replacement)
+		{
+			if (replacement.is_empty()) {
+				return;
+			}
+			const auto& values = m_values;
+			for_each_observer([&values, &replacement, index](tracked_vector_observer<T>& observer) {
+				observer.replacing(values, index, replacement);
+			});
+		}
+	};
+}
@@ -0,0 +1,413 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "export_def.h"
+#include "optional.h"
+#include "set.h"
+#include "vector.h"
+
+namespace fcpp {
+	// An ordered set of strings stored in a radix tree (compressed trie). Keys sharing a prefix
+	// share the nodes of that prefix, and chains of nodes with a single child are compressed
+	// into one node with a multi-character label, so that the memory grows with the number of
+	// distinct branches rather than with the total length of the keys.
+	//
+	// Besides the fcpp::set API, the tree supports prefix queries: `with_prefix` returns a view of
+	// all keys starting with a prefix, without scanning the other keys, and `longest_prefix_match`
+	// returns the longest key which is a prefix of a query (eg. for route tables).
+	//
+	// The keys are iterated in ascending order, the same as in fcpp::set<std::string>.
+	// Inserting or removing a key invalidates all iterators and views.
+	//
+	// example:
+	//      const fcpp::trie_set routes({"/api", "/api/users", "/api/orders", "/static"});
+	//      const auto api_routes = routes.with_prefix("/api/");
+	//
+	// outcome:
+	//      api_routes.keys() -> fcpp::vector<std::string>({"/api/orders", "/api/users"})
+	//      routes.longest_prefix_match("/api/users/15") -> "/api/users"
+	class FunctionalCppExport trie_set
+	{
+		struct node
+		{
+			node();
+
+			// the characters on the edge from the parent to this node
+			std::string label;
+			bool is_key;
+			// sorted by the first character of their label
+			std::vector<std::unique_ptr<node>> children;
+		};
+
+	public:
+		// A forward iterator over the keys of the set (or of a prefix view), in ascending order
+		class FunctionalCppExport const_iterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef std::string value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const std::string* pointer;
+			typedef const std::string& reference;
+
+			const_iterator();
+
+			reference operator*() const;
+			pointer operator->() const;
+			const_iterator& operator++();
+			const_iterator operator++(int);
+			bool operator ==(const const_iterator& rhs) const;
+			bool operator !=(const const_iterator& rhs) const;
+
+		private:
+			friend class trie_set;
+
+			struct frame
+			{
+				const node* visited;
+				size_t next_child;
+			};
+
+			// the path from the subtree root to the current node, and the key spelled by it
+			std::vector<frame> m_path;
+			std::string m_key;
+
+			const_iterator(const node* subtree_root, std::string key);
+			void advance();
+		};
+
+		// A read-only view of the keys starting with a given prefix, in ascending order.
+		// The view refers to the set's nodes, so it must not outlive the set or any modification of it.
+		class FunctionalCppExport prefix_view
+		{
+		public:
+			[[nodiscard]] const_iterator begin() const;
+			[[nodiscard]] const_iterator end() const;
+
+			// Returns the number of keys in the view, performance is O(number of keys in the view)
+			[[nodiscard]] size_t size() const;
+			[[nodiscard]] bool is_empty() const;
+
+			// Returns the keys of the view in a vector, in ascending order
+			[[nodiscard]] vector<std::string> keys() const;
+
+			// Executes the given operation for each key of the view, in ascending order
+			template <typename Callable>
+			const prefix_view& for_each(Callable&& operation) const
+			{
+				std::for_each(begin(),
+				              end(),
+				              std::forward<Callable>(operation));
+				return *this;
+			}
+
+		private:
+			friend class trie_set;
+
+			const node* m_subtree_root;
+			std::string m_subtree_key;
+
+			prefix_view(const node* subtree_root, std::string subtree_key);
+		};
+
+		trie_set();
+		explicit trie_set(const std::set<std::string>& set);
+		explicit trie_set(const fcpp::set<std::string>& set);
+		explicit trie_set(const std::vector<std::string>& vector);
+		explicit trie_set(const std::initializer_list<std::string>& list);
+
+		explicit trie_set(const vector<std::string>& vector)
+			: trie_set()
+		{
+			for (const auto& key : vector) {
+				insert(key);
+			}
+		}
+
+		trie_set(const trie_set& other);
+		trie_set(trie_set&& other);
+		trie_set& operator=(trie_set other);
+		~trie_set();
+
+		// Returns the keys starting with the given prefix, without visiting the other keys.
+		// Finding the first key of the view costs O(prefix length).
+		//
+		// example:
+		//      const fcpp::trie_set paths({"/usr/bin", "/usr/lib", "/var/log"});
+		//      const auto usr_paths = paths.with_prefix("/usr/");
+		//
+		// outcome:
+		//      usr_paths.keys() -> fcpp::vector<std::string>({"/usr/bin", "/usr/lib"})
+		[[nodiscard]] prefix_view with_prefix(const std::string& prefix) const;
+
+		// Returns the longest key which is a prefix of the query, if any. Performance is O(query length).
+		//
+		// example:
+		//      const fcpp::trie_set routes({"/", "/api", "/api/users"});
+		//      routes.longest_prefix_match("/api/users/15"); // "/api/users"
+		//      routes.longest_prefix_match("/apis");         // "/api"
+		//      routes.longest_prefix_match("static");        // no value
+		[[nodiscard]] fcpp::optional_t<std::string> longest_prefix_match(const std::string& query) const;
+
+		// Returns the set of keys which belong to the current set but not in the other set (A – B)
+		[[nodiscard]] trie_set difference_with(const trie_set& other) const;
+		[[nodiscard]] trie_set difference_with(const std::set<std::string>& other) const;
+
+		// Returns the set of keys which belong either to the current or the other set (A ∪ B)
+		[[nodiscard]] trie_set union_with(const trie_set& other) const;
+		[[nodiscard]] trie_set union_with(const std::set<std::string>& other) const;
+
+		// Returns the set of keys which belong to both the current and the other set (A ∩ B)
+		[[nodiscard]] trie_set intersect_with(const trie_set& other) const;
+		[[nodiscard]] trie_set intersect_with(const std::set<std::string>& other) const;
+
+		// Returns the minimum key in the set, if it's not empty. Performance is O(key length).
+		[[nodiscard]] fcpp::optional_t<std::string> min() const;
+
+		// Returns the maximum key in the set, if it's not empty. Performance is O(key length).
+		[[nodiscard]] fcpp::optional_t<std::string> max() const;
+
+		// Performs the functional `map` algorithm, in which every element of the resulting set is the
+		// output of applying the transform function on every key of this instance.
+		// Since the transformed keys are not necessarily strings, the result is a fcpp::set.
+		//
+		// example:
+		//      const fcpp::trie_set words({"a", "bb", "ccc"});
+		//      const auto lengths = words.map<size_t>([](const std::string& word) {
+		//          return word.size();
+		//      });
+		//
+		// outcome:
+		//      lengths -> fcpp::set<size_t>({1, 2, 3})
+#ifdef CPP17_AVAILABLE
+		template <class UKey, class UCompare = std::less<UKey>, typename Transform, typename = std::enable_if_t<
+			          std::is_invocable_r_v<UKey, Transform, std::string>>>
+#else
+		template <typename UKey, class UCompare = std::less<UKey>, typename Transform>
+#endif
+		set<UKey, UCompare> map(Transform&& transform) const
+		{
+			std::set<UKey, UCompare> transformed_set;
+			for (const auto& key : *this) {
+				transformed_set.insert(transform(key));
+			}
+			return set<UKey, UCompare>(transformed_set);
+		}
+
+		// Returns true if all keys match the predicate (return true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, std::string>>>
+#else
+		template <typename Callable>
+#endif
+		bool all_of(Callable&& unary_predicate) const
+		{
+			return std::all_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if at least one key match the predicate (returns true)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, std::string>>>
+#else
+		template <typename Callable>
+#endif
+		bool any_of(Callable&& unary_predicate) const
+		{
+			return std::any_of(begin(),
+			                   end(),
+			                   std::forward<Callable>(unary_predicate));
+		}
+
+		// Returns true if none of the keys match the predicate (all return false)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, std::string>>>
+#else
+		template <typename Callable>
+#endif
+		bool none_of(Callable&& unary_predicate) const
+		{
+			return std::none_of(begin(),
+			                    end(),
+			                    std::forward<Callable>(unary_predicate));
+		}
+
+		// Performs the functional `reduce` (fold/accumulate) algorithm, by returning the result of
+		// accumulating all the keys of the set to an initial value, in ascending order. (non-mutating)
+		//
+		// example:
+		//      const fcpp::trie_set tokens({"the", "quick", "brown", "fox"});
+		//      const auto sentence = tokens.reduce<std::string>("", [](const std::string& partial, const std::string& token) {
+		//          return partial.length() != 0
+		//              ? partial + " " + token
+		//              : token;
+		//      });
+		//
+		// outcome:
+		//      sentence -> std::string("brown fox quick the");
+#ifdef CPP17_AVAILABLE
+		template <typename U, typename Reduce, typename = std::enable_if_t<std::is_invocable_r_v<U, Reduce, U, std::string>>>
+#else
+		template <typename U, typename Reduce>
+#endif
+		U reduce(const U& initial, Reduce&& reduction) const
+		{
+			auto result = initial;
+			for (const auto& key : *this) {
+				result = reduction(result, key);
+			}
+			return result;
+		}
+
+		// Performs the functional `filter` algorithm, in which all keys of this instance
+		// which match the given predicate are kept (mutating)
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, std::string>>>
+#else
+		template <typename Filter>
+#endif
+		trie_set& filter(Filter&& predicate_to_keep)
+		{
+			*this = filtered(std::forward<Filter>(predicate_to_keep));
+			return *this;
+		}
+
+		// Performs the functional `filter` algorithm in a copy of this instance, in which all keys
+		// of the copy which match the given predicate are kept (non-mutating)
+		//
+		// example:
+		//      const fcpp::trie_set words({"apple", "avocado", "banana"});
+		//      const auto long_words = words.filtered([](const std::string& word) {
+		//          return word.size() > 5;
+		//      });
+		//
+		// outcome:
+		//      long_words -> fcpp::trie_set({"avocado", "banana"})
+#ifdef CPP17_AVAILABLE
+		template <typename Filter, typename = std::enable_if_t<std::is_invocable_r_v<bool, Filter, std::string>>>
+#else
+		template <typename Filter>
+#endif
+		trie_set filtered(Filter&& predicate_to_keep) const
+		{
+			trie_set copy;
+			for (const auto& key : *this) {
+				if (predicate_to_keep(key)) {
+					copy.insert(key);
+				}
+			}
+			return copy;
+		}
+
+		// Executes the given operation for each key of the set, in ascending order.
+		// The operation must not change the set's contents during execution.
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<void, Callable, std::string const&>>>
+#else
+		template <typename Callable>
+#endif
+		const trie_set& for_each(Callable&& operation) const
+		{
+			std::for_each(begin(),
+			              end(),
+			              std::forward<Callable>(operation));
+			return *this;
+		}
+
+		// Returns all keys of the set in a vector, in ascending order
+		[[nodiscard]] vector<std::string> keys() const;
+
+		// Removes a key from the set, if it exists. Nodes left with a single child are merged with it (mutating)
+		trie_set& remove(const std::string& key);
+
+		// Returns a copy by removing a key from the set, if it exists (non-mutating)
+		[[nodiscard]] trie_set removing(const std::string& key) const;
+
+		// Inserts a key in the set, if it does not already exist. Performance is O(key length) (mutating)
+		//
+		// example:
+		//      fcpp::trie_set paths({"/usr/bin"});
+		//      paths.insert("/usr/lib");
+		//
+		// outcome:
+		//      paths -> fcpp::trie_set({"/usr/bin", "/usr/lib"}), sharing the "/usr/" node
+		trie_set& insert(const std::string& key);
+
+		// Returns a copy by inserting a key in the set, if it does not already exist (non-mutating)
+		[[nodiscard]] trie_set inserting(const std::string& key) const;
+
+		// Removes all keys from the set (mutating)
+		trie_set& clear();
+
+		// Returns a new set by clearing all keys from the current set (non-mutating)
+		[[nodiscard]] trie_set clearing() const;
+
+		// Returns true if the set is empty
+		[[nodiscard]] bool is_empty() const;
+
+		// Returns true if the key is present in the set, otherwise false. Performance is O(key length).
+		[[nodiscard]] bool contains(const std::string& key) const;
+
+		// Returns the size of the set (how many keys it contains)
+		[[nodiscard]] size_t size() const;
+
+		// Returns the const begin iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator begin() const;
+
+		// Returns the const end iterator, useful for other standard library algorithms
+		[[nodiscard]] const_iterator end() const;
+
+		// Returns true if both instances have equal sizes and the corresponding keys are equal
+		bool operator ==(const trie_set& rhs) const;
+
+		// Returns false if either the sizes are not equal or at least one corresponding key is not equal
+		bool operator !=(const trie_set& rhs) const;
+
+	private:
+		std::unique_ptr<node> m_root;
+		size_t m_size;
+
+		static std::unique_ptr<node> clone(const node& original);
+
+		template <typename Iterator>
+		static trie_set from_sorted(Iterator range_begin, const Iterator& range_end)
+		{
+			trie_set result;
+			for (; range_begin != range_end; ++range_begin) {
+				result.insert(*range_begin);
+			}
+			return result;
+		}
+	};
+}
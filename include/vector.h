@@ -26,8 +26,11 @@
 #include <type_traits>
 #include <vector>
 #include <iterator>
+#include <new>
 #include "index_range.h"
 #include "optional.h"
+#include "relocation.h"
+#include "vector_fwd.h"
 #ifdef PARALLEL_ALGORITHM_AVAILABLE
 #include <execution>
 #endif
@@ -42,7 +45,11 @@ namespace fcpp {
 	//
 	// Member functions can be mutating (eg. my_vector.reverse()) or
 	// non-mutating (eg. my_vector.reversed()) enforcing thread safety if needed
-	template <typename T>
+	//
+	// The storage is allocated with TAllocator (std::allocator by default), e.g. fcpp::aligned_allocator
+	// for cache line aligned storage backed by huge pages. The non-mutating functions returning the same
+	// element type keep the allocator, the ones returning another element type use std::allocator.
+	template <typename T, typename TAllocator>
 	class vector
 	{
 	public:
@@ -51,16 +58,23 @@ namespace fcpp {
 		{
 		}
 
-		explicit vector(const std::vector<T>& vector)
+		explicit vector(const std::vector<T, TAllocator>& vector)
 			: m_vector(vector)
 		{
 		}
 
-		explicit vector(std::vector<T>&& vector)
+		explicit vector(std::vector<T, TAllocator>&& vector)
 			: m_vector(std::move(vector))
 		{
 		}
 
+		// Copies the elements of a std::vector using a different allocator
+		template <typename UAllocator>
+		explicit vector(const std::vector<T, UAllocator>& vector)
+			: m_vector(vector.begin(), vector.end())
+		{
+		}
+
 		explicit vector(std::initializer_list<T> list)
 			: m_vector(std::move(list))
 		{
@@ -351,9 +365,9 @@ namespace fcpp {
 #else
 		template <typename Callable>
 #endif
-		vector filtered(Callable&& predicate_to_keep) const
+		vector filtered(Callable&& predicate_to_keep) const&
 		{
-			std::vector<T> filtered_vector;
+			std::vector<T, TAllocator> filtered_vector;
 			filtered_vector.reserve(m_vector.size());
 			std::copy_if(m_vector.begin(),
 			             m_vector.end(),
@@ -362,6 +376,18 @@ namespace fcpp {
 			return vector(filtered_vector);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+#ifdef CPP17_AVAILABLE
+		template <typename Callable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Callable, T>>>
+#else
+		template <typename Callable>
+#endif
+		vector filtered(Callable&& predicate_to_keep) &&
+		{
+			filter(std::forward<Callable>(predicate_to_keep));
+			return std::move(*this);
+		}
+
 #ifdef PARALLEL_ALGORITHM_AVAILABLE
 		// Performs the `filtered` algorithm in parallel.
 		// See also the sequential version for more documentation.
@@ -374,7 +400,7 @@ namespace fcpp {
 			copy.filter_parallel(predicate_to_keep);
 			return copy;
 #else
-        std::vector<T> filtered_vector;
+        std::vector<T, TAllocator> filtered_vector;
         filtered_vector.reserve(m_vector.size());
         std::copy_if(std::execution::par,
                      m_vector.begin(),
@@ -409,12 +435,19 @@ namespace fcpp {
 		// outcome:
 		//      input_vector -> fcpp::vector<int>({ 1, 3, -5, 2, -1, 9, -4 });
 		//      reversed_vector -> fcpp::vector<int>({ -4, 9, -1, 2, -5, 3, 1 })
-		[[nodiscard]] vector reversed() const
+		[[nodiscard]] vector reversed() const&
 		{
-			std::vector<T> reversed_vector(m_vector.crbegin(), m_vector.crend());
+			std::vector<T, TAllocator> reversed_vector(m_vector.crbegin(), m_vector.crend());
 			return vector(std::move(reversed_vector));
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector reversed() &&
+		{
+			reverse();
+			return std::move(*this);
+		}
+
 #ifdef CPP17_AVAILABLE
 		template <typename Iterator>
 		using deref_type = typename std::iterator_traits<Iterator>::value_type;
@@ -452,8 +485,8 @@ namespace fcpp {
 		//          tuple.second = names_vector[i];
 		//          zipped_vector.insert_back(tuple);
 		//      }
-		template <typename U>
-		[[nodiscard]] vector<std::pair<T, U>> zip(const vector<U>& vector) const
+		template <typename U, typename UAllocator>
+		[[nodiscard]] vector<std::pair<T, U>> zip(const vector<U, UAllocator>& vector) const&
 		{
 #ifdef CPP17_AVAILABLE
 			return zip_impl(vector.begin(), vector.end());
@@ -462,6 +495,13 @@ namespace fcpp {
 #endif
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		template <typename U, typename UAllocator>
+		[[nodiscard]] vector<std::pair<T, U>> zip(const vector<U, UAllocator>& vector) &&
+		{
+			return zip_moving(vector.begin(), vector.end());
+		}
+
 		// Performs the functional `zip` algorithm, in which every element of the resulting vector is a
 		// tuple of this instance's element (first) and the second vector's element (second) at the same
 		// index. The sizes of the two vectors must be equal.
@@ -488,8 +528,8 @@ namespace fcpp {
 		//          tuple.second = names_vector[i];
 		//          zipped_vector.insert_back(tuple);
 		//      }
-		template <typename U>
-		[[nodiscard]] vector<std::pair<T, U>> zip(const std::vector<U>& vector) const
+		template <typename U, typename UAllocator>
+		[[nodiscard]] vector<std::pair<T, U>> zip(const std::vector<U, UAllocator>& vector) const&
 		{
 #ifdef CPP17_AVAILABLE
 			return zip_impl(vector.cbegin(), vector.cend());
@@ -498,6 +538,13 @@ namespace fcpp {
 #endif
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		template <typename U, typename UAllocator>
+		[[nodiscard]] vector<std::pair<T, U>> zip(const std::vector<U, UAllocator>& vector) &&
+		{
+			return zip_moving(vector.cbegin(), vector.cend());
+		}
+
 		// example:
 		//      const fcpp::vector ages_vector({32, 25, 53});
 		//      const std::initializer_list<std::string> names_vector({"Jake", "Mary", "John"});
@@ -521,7 +568,7 @@ namespace fcpp {
 		//          zipped_vector.insert_back(tuple);
 		//      }
 		template <typename U>
-		[[nodiscard]] vector<std::pair<T, U>> zip(const std::initializer_list<U>& list) const
+		[[nodiscard]] vector<std::pair<T, U>> zip(const std::initializer_list<U>& list) const&
 		{
 #ifdef CPP17_AVAILABLE
 			return zip_impl(list.begin(), list.end());
@@ -530,6 +577,13 @@ namespace fcpp {
 #endif
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		template <typename U>
+		[[nodiscard]] vector<std::pair<T, U>> zip(const std::initializer_list<U>& list) &&
+		{
+			return zip_moving(list.begin(), list.end());
+		}
+
 		// Sorts the vector in place (mutating). The comparison predicate takes two elements
 		// `v1` and `v2` and returns true if the first element `v1` should appear before `v2`.
 		//
@@ -648,7 +702,7 @@ namespace fcpp {
 #else
 		template <typename Sortable>
 #endif
-		vector sorted(Sortable&& comparison_predicate) const
+		vector sorted(Sortable&& comparison_predicate) const&
 		{
 			auto sorted_vector(m_vector);
 			std::sort(sorted_vector.begin(),
@@ -657,6 +711,18 @@ namespace fcpp {
 			return vector(sorted_vector);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+#ifdef CPP17_AVAILABLE
+		template <typename Sortable, typename = std::enable_if_t<std::is_invocable_r_v<bool, Sortable, T, T>>>
+#else
+		template <typename Sortable>
+#endif
+		vector sorted(Sortable&& comparison_predicate) &&
+		{
+			sort(std::forward<Sortable>(comparison_predicate));
+			return std::move(*this);
+		}
+
 #ifdef PARALLEL_ALGORITHM_AVAILABLE
 		// Performs the `sorted` algorithm in parallel.
 		// See also the sequential version for more documentation.
@@ -680,11 +746,17 @@ namespace fcpp {
 		//
 		// outcome:
 		//      sorted_numbers -> fcpp::vector({-4, 1, 3, 9});
-		[[nodiscard]] vector sorted_ascending() const
+		[[nodiscard]] vector sorted_ascending() const&
 		{
 			return sorted(std::less_equal<T>());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector sorted_ascending() &&
+		{
+			return std::move(*this).sorted(std::less_equal<T>());
+		}
+
 #ifdef PARALLEL_ALGORITHM_AVAILABLE
 		// Performs the `sorted_ascending` algorithm in parallel.
 		// See also the sequential version for more documentation.
@@ -702,11 +774,17 @@ namespace fcpp {
 		//
 		// outcome:
 		//      sorted_numbers -> fcpp::vector({9, 3, 1, -4});
-		[[nodiscard]] vector sorted_descending() const
+		[[nodiscard]] vector sorted_descending() const&
 		{
 			return sorted(std::greater_equal<T>());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector sorted_descending() &&
+		{
+			return std::move(*this).sorted(std::greater_equal<T>());
+		}
+
 #ifdef PARALLEL_ALGORITHM_AVAILABLE
 		// Performs the `sorted_descending` algorithm in parallel.
 		// See also the sequential version for more documentation.
@@ -830,7 +908,7 @@ namespace fcpp {
 		vector& remove_at(size_t index)
 		{
 			assert_smaller_size(index);
-			m_vector.erase(begin() + index);
+			erase_elements(index, 1);
 			return *this;
 		}
 
@@ -842,7 +920,7 @@ namespace fcpp {
 		//
 		// outcome:
 		//      shorter_vector -> fcpp::vector<int>({1, 4, 2, 5, 3, 1, 7, 1});
-		[[nodiscard]] vector removing_at(size_t index) const
+		[[nodiscard]] vector removing_at(size_t index) const&
 		{
 			assert_smaller_size(index);
 			auto copy(m_vector);
@@ -850,6 +928,13 @@ namespace fcpp {
 			return vector(copy);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector removing_at(size_t index) &&
+		{
+			remove_at(index);
+			return std::move(*this);
+		}
+
 		// Removes the last element, if present (mutating)
 		//
 		// example:
@@ -872,13 +957,20 @@ namespace fcpp {
 		//
 		// outcome:
 		//      shorter_vector -> fcpp::vector<int>({1, 4, 2, 5, 8, 3, 1, 7});
-		[[nodiscard]] vector removing_back() const
+		[[nodiscard]] vector removing_back() const&
 		{
 			auto copy(m_vector);
 			copy.pop_back();
 			return vector(copy);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector removing_back() &&
+		{
+			remove_back();
+			return std::move(*this);
+		}
+
 		// Removes the first element, if present (mutating)
 		//
 		// example:
@@ -903,7 +995,7 @@ namespace fcpp {
 		//
 		// outcome:
 		//      shorter_numbers -> fcpp::vector<int>({4, 2, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector removing_front() const
+		[[nodiscard]] vector removing_front() const&
 		{
 			if (size() == 0) {
 				return *this;
@@ -911,6 +1003,13 @@ namespace fcpp {
 			return removing_at(0);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector removing_front() &&
+		{
+			remove_front();
+			return std::move(*this);
+		}
+
 		// Removes the elements whose index is contained in the given index range (mutating)
 		//
 		// example:
@@ -924,8 +1023,7 @@ namespace fcpp {
 			if (!range.is_valid || size() < range.end + 1) {
 				return *this;
 			}
-			m_vector.erase(begin() + range.start,
-			               begin() + range.start + range.count);
+			erase_elements(range.start, range.count);
 			return *this;
 		}
 
@@ -937,7 +1035,7 @@ namespace fcpp {
 		//
 		// outcome:
 		//		shorter_vector -> fcpp::vector<int>({ 1, 4, 3, 1, 7, 1 })
-		[[nodiscard]] vector removing_range(index_range range) const
+		[[nodiscard]] vector removing_range(index_range range) const&
 		{
 			if (!range.is_valid || size() < range.end + 1) {
 				return *this;
@@ -948,6 +1046,13 @@ namespace fcpp {
 			return vector(shorter_vector);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector removing_range(index_range range) &&
+		{
+			remove_range(range);
+			return std::move(*this);
+		}
+
 		// Inserts an element at the given index, therefore changing the vector's contents (mutating)
 		//
 		// example:
@@ -959,7 +1064,15 @@ namespace fcpp {
 		vector& insert_at(size_t index, const T& element)
 		{
 			assert_smaller_or_equal_size(index);
-			m_vector.insert(begin() + index, element);
+			insert_element(index, element, detail::uses_relocating_shift<T>());
+			return *this;
+		}
+
+		// Inserts an element at the given index by moving it, e.g. a move-only element (mutating)
+		vector& insert_at(size_t index, T&& element)
+		{
+			assert_smaller_or_equal_size(index);
+			insert_element(index, std::move(element), detail::uses_relocating_shift<T>());
 			return *this;
 		}
 
@@ -971,7 +1084,7 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({1, 4, 2, 18, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector inserting_at(size_t index, const T& element) const
+		[[nodiscard]] vector inserting_at(size_t index, const T& element) const&
 		{
 			assert_smaller_or_equal_size(index);
 			auto copy(m_vector);
@@ -979,6 +1092,13 @@ namespace fcpp {
 			return vector(copy);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_at(size_t index, const T& element) &&
+		{
+			insert_at(index, element);
+			return std::move(*this);
+		}
+
 		// Inserts a range of elements starting at the given index, therefore changing the vector's contents (mutating)
 		//
 		// example:
@@ -988,11 +1108,20 @@ namespace fcpp {
 		//
 		// outcome:
 		//      numbers -> fcpp::vector({1, 4, 2, 9, -5, 6, 5, 8, 3, 1, 7, 1});
-		vector& insert_at(size_t index, const vector<T>& vector)
+		vector& insert_at(size_t index, const vector& vector)
 		{
 			return insert_at_impl(index, vector.begin(), vector.end());
 		}
 
+		// Inserts the elements of a temporary vector starting at the given index by moving them,
+		// e.g. move-only elements. The given vector is left empty (mutating)
+		vector& insert_at(size_t index, vector&& vector)
+		{
+			insert_at_impl(index, std::make_move_iterator(vector.begin()), std::make_move_iterator(vector.end()));
+			vector.clear();
+			return *this;
+		}
+
 		// Returns a copy by inserting a range of elements starting at the given index (non-mutating)
 		//
 		// example:
@@ -1002,11 +1131,32 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({1, 4, 2, 9, -5, 6, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector inserting_at(size_t index, const vector<T>& vector) const
+		[[nodiscard]] vector inserting_at(size_t index, const vector& vector) const&
 		{
 			return inserting_at_impl(index, vector.begin(), vector.end());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_at(size_t index, const vector& vector) &&
+		{
+			insert_at(index, vector);
+			return std::move(*this);
+		}
+
+		// Returns a copy with the elements of a temporary vector moved in starting at the given index (non-mutating)
+		[[nodiscard]] vector inserting_at(size_t index, vector&& vector) const&
+		{
+			auto augmented_vector(*this);
+			augmented_vector.insert_at(index, std::move(vector));
+			return augmented_vector;
+		}
+
+		[[nodiscard]] vector inserting_at(size_t index, vector&& vector) &&
+		{
+			insert_at(index, std::move(vector));
+			return std::move(*this);
+		}
+
 		// Inserts a range of elements starting at the given index, therefore changing the vector's contents (mutating)
 		//
 		// example:
@@ -1030,11 +1180,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({1, 4, 2, 9, -5, 6, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector inserting_at(size_t index, const std::vector<T>& vector) const
+		[[nodiscard]] vector inserting_at(size_t index, const std::vector<T>& vector) const&
 		{
 			return inserting_at_impl(index, vector.cbegin(), vector.cend());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_at(size_t index, const std::vector<T>& vector) &&
+		{
+			insert_at(index, vector);
+			return std::move(*this);
+		}
+
 		// Inserts a range of elements starting at the given index, therefore changing the vector's contents (mutating)
 		//
 		// example:
@@ -1058,11 +1215,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({1, 4, 2, 9, -5, 6, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector inserting_at(size_t index, std::initializer_list<T> list) const
+		[[nodiscard]] vector inserting_at(size_t index, std::initializer_list<T> list) const&
 		{
 			return inserting_at(index, std::vector<T>(std::move(list)));
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_at(size_t index, std::initializer_list<T> list) &&
+		{
+			insert_at(index, std::move(list));
+			return std::move(*this);
+		}
+
 		// Inserts a value at the end of the vector in place (mutating)
 		//
 		// example:
@@ -1073,7 +1237,38 @@ namespace fcpp {
 		//      numbers -> fcpp::vector({1, 4, 2, 5, 8, 3, 1, 7, 1, 18});
 		vector& insert_back(T value)
 		{
-			m_vector.push_back(value);
+			m_vector.push_back(std::move(value));
+			return *this;
+		}
+
+		// Constructs an element at the end of the vector in place from the given arguments (mutating)
+		//
+		// example:
+		//      fcpp::vector<std::unique_ptr<int>> pointers;
+		//      pointers.emplace_back(new int(3));
+		//
+		// outcome:
+		//      *pointers[0] -> 3
+		template <typename... Args>
+		vector& emplace_back(Args&&... args)
+		{
+			m_vector.emplace_back(std::forward<Args>(args)...);
+			return *this;
+		}
+
+		// Constructs an element at the given index in place from the given arguments (mutating)
+		//
+		// example:
+		//      fcpp::vector<person> persons({ person(15, "Jake") });
+		//      persons.emplace_at(0, 18, "Jannet");
+		//
+		// outcome:
+		//      persons -> fcpp::vector({ person(18, "Jannet"), person(15, "Jake") })
+		template <typename... Args>
+		vector& emplace_at(size_t index, Args&&... args)
+		{
+			assert_smaller_or_equal_size(index);
+			emplace_element(index, detail::uses_relocating_shift<T>(), std::forward<Args>(args)...);
 			return *this;
 		}
 
@@ -1087,7 +1282,7 @@ namespace fcpp {
 		//      numbers -> fcpp::vector({18, 1, 4, 2, 5, 8, 3, 1, 7, 1});
 		vector& insert_front(T value)
 		{
-			return insert_at(0, value);
+			return insert_at(0, std::move(value));
 		}
 
 		// Makes a copy of the vector, inserts value at the end of the copy and returns the copy (non-mutating)
@@ -1098,13 +1293,20 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({1, 4, 2, 5, 8, 3, 1, 7, 1, 18});
-		[[nodiscard]] vector inserting_back(T value) const
+		[[nodiscard]] vector inserting_back(T value) const&
 		{
 			auto augmented_vector(m_vector);
 			augmented_vector.push_back(value);
 			return vector(augmented_vector);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_back(T value) &&
+		{
+			insert_back(std::move(value));
+			return std::move(*this);
+		}
+
 		// Makes a copy of the vector, inserts value at the beginning of the copy and returns the copy (non-mutating)
 		//
 		// example:
@@ -1113,11 +1315,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector({18, 1, 4, 2, 5, 8, 3, 1, 7, 1});
-		[[nodiscard]] vector inserting_front(T value) const
+		[[nodiscard]] vector inserting_front(T value) const&
 		{
 			return inserting_at(0, value);
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_front(T value) &&
+		{
+			insert_front(std::move(value));
+			return std::move(*this);
+		}
+
 		// Inserts a range of values at the end of the vector in place (mutating)
 		//
 		// example:
@@ -1126,11 +1335,34 @@ namespace fcpp {
 		//
 		// outcome:
 		//      numbers -> fcpp::vector<int> numbers({ 4, 5, 6, 1, 2, 3 });
-		vector& insert_back(const vector<T>& vector)
+		vector& insert_back(const vector& vector)
 		{
 			return insert_back_range_impl(vector.begin(), vector.end());
 		}
 
+		// Inserts the elements of a temporary vector at the end by moving them, e.g. move-only elements.
+		// The given vector is left empty (mutating)
+		//
+		// example:
+		//      fcpp::vector<std::unique_ptr<int>> pointers;
+		//      fcpp::vector<std::unique_ptr<int>> more_pointers;
+		//      more_pointers.emplace_back(new int(3));
+		//      pointers.insert_back(std::move(more_pointers));
+		//
+		// outcome:
+		//      pointers.size() -> 1
+		//      more_pointers.size() -> 0
+		vector& insert_back(vector&& vector)
+		{
+			if (m_vector.empty()) {
+				m_vector.swap(vector.m_vector);
+				return *this;
+			}
+			insert_back_range_impl(std::make_move_iterator(vector.begin()), std::make_move_iterator(vector.end()));
+			vector.clear();
+			return *this;
+		}
+
 		// Inserts a range of values at the beginning of the vector in place (mutating)
 		//
 		// example:
@@ -1139,11 +1371,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      numbers -> fcpp::vector<int> numbers({ 1, 2, 3, 4, 5, 6 });
-		vector& insert_front(const vector<T>& vector)
+		vector& insert_front(const vector& vector)
 		{
 			return insert_front_range_impl(vector.begin(), vector.end());
 		}
 
+		// Inserts the elements of a temporary vector at the beginning by moving them, e.g. move-only elements.
+		// The given vector is left empty (mutating)
+		vector& insert_front(vector&& vector)
+		{
+			return insert_at(0, std::move(vector));
+		}
+
 		// Makes a copy of the vector, inserts a range of values at the end of the copy, and returns the copy (non-mutating)
 		//
 		// example:
@@ -1152,11 +1391,32 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 4, 5, 6, 1, 2, 3 });
-		[[nodiscard]] vector inserting_back(const vector<T>& vector) const
+		[[nodiscard]] vector inserting_back(const vector& vector) const&
 		{
 			return inserting_back_range_impl(vector.begin(), vector.end());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_back(const vector& vector) &&
+		{
+			insert_back(vector);
+			return std::move(*this);
+		}
+
+		// Returns a copy with the elements of a temporary vector moved in at the end (non-mutating)
+		[[nodiscard]] vector inserting_back(vector&& vector) const&
+		{
+			auto augmented_vector(*this);
+			augmented_vector.insert_back(std::move(vector));
+			return augmented_vector;
+		}
+
+		[[nodiscard]] vector inserting_back(vector&& vector) &&
+		{
+			insert_back(std::move(vector));
+			return std::move(*this);
+		}
+
 		// Makes a copy of the vector, inserts a range of values at the beginning of the copy, and returns the copy (non-mutating)
 		//
 		// example:
@@ -1165,11 +1425,32 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 1, 2, 3, 4, 5, 6 });
-		[[nodiscard]] vector inserting_front(const vector<T>& vector) const
+		[[nodiscard]] vector inserting_front(const vector& vector) const&
 		{
 			return inserting_front_range_impl(vector.begin(), vector.end());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_front(const vector& vector) &&
+		{
+			insert_front(vector);
+			return std::move(*this);
+		}
+
+		// Returns a copy with the elements of a temporary vector moved in at the beginning (non-mutating)
+		[[nodiscard]] vector inserting_front(vector&& vector) const&
+		{
+			auto augmented_vector(*this);
+			augmented_vector.insert_front(std::move(vector));
+			return augmented_vector;
+		}
+
+		[[nodiscard]] vector inserting_front(vector&& vector) &&
+		{
+			insert_front(std::move(vector));
+			return std::move(*this);
+		}
+
 		// Inserts a range of values at the end of the vector in place (mutating)
 		//
 		// example:
@@ -1204,11 +1485,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 4, 5, 6, 1, 2, 3 });
-		[[nodiscard]] vector inserting_back(const std::vector<T>& vector) const
+		[[nodiscard]] vector inserting_back(const std::vector<T>& vector) const&
 		{
 			return inserting_back_range_impl(vector.cbegin(), vector.cend());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_back(const std::vector<T>& vector) &&
+		{
+			insert_back(vector);
+			return std::move(*this);
+		}
+
 		// Makes a copy of the vector, inserts a range of values at the beginning of the copy, and returns the copy (non-mutating)
 		//
 		// example:
@@ -1217,11 +1505,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 1, 2, 3, 4, 5, 6 });
-		[[nodiscard]] vector inserting_front(const std::vector<T>& vector) const
+		[[nodiscard]] vector inserting_front(const std::vector<T>& vector) const&
 		{
 			return inserting_front_range_impl(vector.cbegin(), vector.cend());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_front(const std::vector<T>& vector) &&
+		{
+			insert_front(vector);
+			return std::move(*this);
+		}
+
 		// Inserts a range of values at the end of the vector in place (mutating)
 		//
 		// example:
@@ -1256,11 +1551,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 4, 5, 6, 1, 2, 3 });
-		[[nodiscard]] vector inserting_back(const std::initializer_list<T>& list) const
+		[[nodiscard]] vector inserting_back(const std::initializer_list<T>& list) const&
 		{
 			return inserting_back(std::vector<T>(list));
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_back(const std::initializer_list<T>& list) &&
+		{
+			insert_back(list);
+			return std::move(*this);
+		}
+
 		// Makes a copy of the vector, inserts a range of values at the beginning of the copy, and returns the copy (non-mutating)
 		//
 		// example:
@@ -1269,11 +1571,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      augmented_numbers -> fcpp::vector<int> numbers({ 1, 2, 3, 4, 5, 6 });
-		[[nodiscard]] vector inserting_front(const std::initializer_list<T>& list) const
+		[[nodiscard]] vector inserting_front(const std::initializer_list<T>& list) const&
 		{
 			return inserting_front(std::vector<T>(list));
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector inserting_front(const std::initializer_list<T>& list) &&
+		{
+			insert_front(list);
+			return std::move(*this);
+		}
+
 		// Replaces the existing contents starting at `index` with the contents of the given vector (mutating)
 		//
 		// example:
@@ -1282,7 +1591,7 @@ namespace fcpp {
 		//
 		// outcome:
 		//      numbers -> fcpp::vector({ 1, 4, 2, 5, 9, -10, 8, 7, 1 })
-		vector& replace_range_at(size_t index, const vector<T>& vector)
+		vector& replace_range_at(size_t index, const vector& vector)
 		{
 			return replace_range_at_imp(index, vector.begin(), vector.end());
 		}
@@ -1321,11 +1630,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      replaced_numbers -> fcpp::vector({ 1, 4, 2, 5, 9, -10, 8, 7, 1 })
-		[[nodiscard]] vector replacing_range_at(size_t index, const vector<T>& vector) const
+		[[nodiscard]] vector replacing_range_at(size_t index, const vector& vector) const&
 		{
 			return replacing_range_at_imp(index, vector.begin(), vector.end());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector replacing_range_at(size_t index, const vector& vector) &&
+		{
+			replace_range_at(index, vector);
+			return std::move(*this);
+		}
+
 		// Returns a copy whose elements starting at `index` are replaced with the contents of the given vector (non-mutating)
 		//
 		// example:
@@ -1334,11 +1650,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      replaced_numbers -> fcpp::vector({ 1, 4, 2, 5, 9, -10, 8, 7, 1 })
-		[[nodiscard]] vector replacing_range_at(size_t index, const std::vector<T>& vector) const
+		[[nodiscard]] vector replacing_range_at(size_t index, const std::vector<T>& vector) const&
 		{
 			return replacing_range_at_imp(index, vector.cbegin(), vector.cend());
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector replacing_range_at(size_t index, const std::vector<T>& vector) &&
+		{
+			replace_range_at(index, vector);
+			return std::move(*this);
+		}
+
 		// Returns a copy whose elements starting at `index` are replaced with the contents of the given vector (non-mutating)
 		//
 		// example:
@@ -1347,11 +1670,18 @@ namespace fcpp {
 		//
 		// outcome:
 		//      replaced_numbers -> fcpp::vector({ 1, 4, 2, 5, 9, -10, 8, 7, 1 })
-		[[nodiscard]] vector replacing_range_at(size_t index, const std::initializer_list<T>& list) const
+		[[nodiscard]] vector replacing_range_at(size_t index, const std::initializer_list<T>& list) const&
 		{
 			return replacing_range_at(index, std::vector<T>(list));
 		}
 
+		// Same as above, but reuses the elements of a temporary instead of copying them (e.g. for move-only elements)
+		[[nodiscard]] vector replacing_range_at(size_t index, const std::initializer_list<T>& list) &&
+		{
+			replace_range_at(index, list);
+			return std::move(*this);
+		}
+
 		// Replaces all existing elements with a constant element (mutating)
 		//
 		// example:
@@ -1430,25 +1760,25 @@ namespace fcpp {
 		}
 
 		// Returns the begin iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::vector<T>::iterator begin()
+		[[nodiscard]] typename std::vector<T, TAllocator>::iterator begin()
 		{
 			return m_vector.begin();
 		}
 
 		// Returns the const begin iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::vector<T>::const_iterator begin() const
+		[[nodiscard]] typename std::vector<T, TAllocator>::const_iterator begin() const
 		{
 			return m_vector.begin();
 		}
 
 		// Returns the end iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::vector<T>::iterator end()
+		[[nodiscard]] typename std::vector<T, TAllocator>::iterator end()
 		{
 			return m_vector.end();
 		}
 
 		// Returns the const end iterator, useful for other standard library algorithms
-		[[nodiscard]] typename std::vector<T>::const_iterator end() const
+		[[nodiscard]] typename std::vector<T, TAllocator>::const_iterator end() const
 		{
 			return m_vector.end();
 		}
@@ -1467,6 +1797,16 @@ namespace fcpp {
 			return set<T, UCompare>(*this);
 		}
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+		// Performs the `distinct` algorithm in parallel, by sorting and removing the duplicates in parallel.
+		// See also set::from_parallel and the sequential version for more documentation.
+		template <typename UCompare = std::less<T>>
+		set<T, UCompare> distinct_parallel() const
+		{
+			return set<T, UCompare>::from_parallel(*this);
+		}
+#endif
+
 		// Returns a reference to the element in the given index, allowing subscripting and value editing.
 		// Bounds checking (assert) is enabled for debug builds.
 		T& operator[](size_t index)
@@ -1484,7 +1824,7 @@ namespace fcpp {
 		}
 
 		// Returns true if both instances have equal sizes and the corresponding elements (same index) are equal
-		bool operator ==(const vector<T>& rhs) const
+		bool operator ==(const vector& rhs) const
 		{
 #ifdef CPP17_AVAILABLE
 			return std::equal(begin(),
@@ -1507,13 +1847,87 @@ namespace fcpp {
 		}
 
 		// Returns false if either the sizes are not equal or at least one corresponding element (same index) is not equal
-		bool operator !=(const vector<T>& rhs) const
+		bool operator !=(const vector& rhs) const
 		{
 			return !((*this) == rhs);
 		}
 
 	private:
-		std::vector<T> m_vector;
+		std::vector<T, TAllocator> m_vector;
+
+		// Removes `count` elements starting at `index`, with memmove for trivially relocatable types
+		void erase_elements(size_t index, size_t count)
+		{
+			erase_elements(index, count, detail::uses_relocating_shift<T>());
+		}
+
+		void erase_elements(size_t index, size_t count, std::true_type)
+		{
+			detail::relocating_erase(m_vector, index, count);
+		}
+
+		void erase_elements(size_t index, size_t count, std::false_type)
+		{
+			m_vector.erase(begin() + index,
+			               begin() + index + count);
+		}
+
+		template <typename U>
+		void insert_element(size_t index, U&& element, std::true_type)
+		{
+			// copied first, since the element may belong to this vector
+			T copy(std::forward<U>(element));
+			detail::relocating_insert(m_vector, index, &copy, 1);
+		}
+
+		template <typename U>
+		void insert_element(size_t index, U&& element, std::false_type)
+		{
+			m_vector.insert(begin() + index, std::forward<U>(element));
+		}
+
+		template <typename... Args>
+		void emplace_element(size_t index, std::true_type, Args&&... args)
+		{
+			T element(std::forward<Args>(args)...);
+			detail::relocating_insert(m_vector, index, &element, 1);
+		}
+
+		template <typename... Args>
+		void emplace_element(size_t index, std::false_type, Args&&... args)
+		{
+			m_vector.emplace(begin() + index, std::forward<Args>(args)...);
+		}
+
+		// Pairs the elements, which are moved out of this instance, with the given ones
+		template <typename Iterator>
+		vector<std::pair<T, typename std::iterator_traits<Iterator>::value_type>> zip_moving(Iterator vec_begin, Iterator vec_end)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type U;
+			assert(m_vector.size() == static_cast<size_t>(std::distance(vec_begin, vec_end)));
+			std::vector<std::pair<T, U>> combined_vector;
+			combined_vector.reserve(m_vector.size());
+			for (size_t i = 0; i < m_vector.size(); ++i, ++vec_begin) {
+				combined_vector.push_back(std::pair<T, U>(std::move(m_vector[i]), *vec_begin));
+			}
+			m_vector.clear();
+			return vector<std::pair<T, U>>(std::move(combined_vector));
+		}
+
+		template <typename Iterator>
+		void insert_elements(size_t index, const Iterator& vec_begin, const Iterator& vec_end, std::true_type)
+		{
+			std::vector<T> copies(vec_begin, vec_end);
+			detail::relocating_insert(m_vector, index, copies.data(), copies.size());
+		}
+
+		template <typename Iterator>
+		void insert_elements(size_t index, const Iterator& vec_begin, const Iterator& vec_end, std::false_type)
+		{
+			m_vector.insert(begin() + index,
+			                vec_begin,
+			                vec_end);
+		}
 		// The iterator passed here may not necessarily be from std::vector as long as it's a valid iterable range
 #ifdef CPP17_AVAILABLE
 		template <typename Iterator, typename = std::enable_if_t<std::is_constructible_v<
@@ -1537,9 +1951,7 @@ namespace fcpp {
 #endif
 		vector& insert_front_range_impl(const Iterator& vec_begin, const Iterator& vec_end)
 		{
-			m_vector.insert(m_vector.begin(),
-			                vec_begin,
-			                vec_end);
+			insert_elements(0, vec_begin, vec_end, detail::uses_relocating_shift<T>());
 			return *this;
 		}
 
@@ -1582,9 +1994,8 @@ namespace fcpp {
 		{
 			using U = deref_type<Iterator>;
 #else
-		template <typename U>
-		[[nodiscard]] vector<std::pair<T, U>> zip_impl(const typename std::vector<U>::const_iterator& vec_begin,
-		                                               const typename std::vector<U>::const_iterator& vec_end) const
+		template <typename U, typename Iterator>
+		[[nodiscard]] vector<std::pair<T, U>> zip_impl(const Iterator& vec_begin, const Iterator& vec_end) const
 		{
 #endif
 			const auto vec_size = std::distance(vec_begin, vec_end);
@@ -1610,9 +2021,7 @@ namespace fcpp {
 		{
 			if (vec_begin != vec_end) {
 				assert_smaller_or_equal_size(index);
-				m_vector.insert(begin() + index,
-				                vec_begin,
-				                vec_end);
+				insert_elements(index, vec_begin, vec_end, detail::uses_relocating_shift<T>());
 			}
 			return *this;
 		}
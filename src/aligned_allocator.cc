@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include "aligned_allocator.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace fcpp {
+	namespace {
+		std::atomic<size_t> allocations(0);
+		std::atomic<size_t> huge_page_allocations(0);
+		std::atomic<size_t> live_bytes(0);
+		std::atomic<size_t> huge_page_live_bytes(0);
+
+		size_t round_up(size_t size, size_t alignment)
+		{
+			return (size + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	allocation_statistics aligned_allocation_statistics()
+	{
+		allocation_statistics statistics;
+		statistics.allocations = allocations.load();
+		statistics.huge_page_allocations = huge_page_allocations.load();
+		statistics.live_bytes = live_bytes.load();
+		statistics.huge_page_live_bytes = huge_page_live_bytes.load();
+		return statistics;
+	}
+
+	size_t huge_page_backed_bytes(const void* address, size_t size)
+	{
+#ifdef __linux__
+		const auto first = reinterpret_cast<uintptr_t>(address);
+		const auto last = first + size;
+		std::ifstream smaps("/proc/self/smaps");
+		std::string line;
+		auto overlapping = false;
+		size_t backed = 0;
+		while (std::getline(smaps, line)) {
+			// a mapping starts with its address range "start-end perms ...", followed by "Field: value" lines
+			const auto dash = line.find('-');
+			const auto space = line.find(' ');
+			if (dash != std::string::npos && space != std::string::npos && dash < space && line.find(':') > space) {
+				const auto start = std::stoull(line.substr(0, dash), nullptr, 16);
+				const auto end = std::stoull(line.substr(dash + 1, space - dash - 1), nullptr, 16);
+				overlapping = start < last && first < end;
+			} else if (overlapping && line.compare(0, 15, "AnonHugePages: ") == 0) {
+				std::istringstream value(line.substr(15));
+				size_t kilobytes = 0;
+				value >> kilobytes;
+				backed += kilobytes * 1024;
+			}
+		}
+		return backed;
+#else
+		(void)address;
+		(void)size;
+		return 0;
+#endif
+	}
+
+	namespace detail {
+		void* aligned_allocate(size_t size, size_t alignment, size_t huge_page_threshold)
+		{
+			const auto huge = size >= huge_page_threshold;
+			if (huge && alignment < huge_page_size()) {
+				alignment = huge_page_size();
+			}
+			if (alignment < sizeof(void*)) {
+				alignment = sizeof(void*);
+			}
+			// huge page buffers are whole pages, so that madvise covers all of them
+			const auto allocated_size = huge ? round_up(size, huge_page_size()) : size;
+#ifdef _MSC_VER
+			void* pointer = _aligned_malloc(allocated_size > 0 ? allocated_size : 1, alignment);
+			if (pointer == nullptr) {
+				throw std::bad_alloc();
+			}
+#else
+			void* pointer = nullptr;
+			if (posix_memalign(&pointer, alignment, allocated_size > 0 ? allocated_size : 1) != 0) {
+				throw std::bad_alloc();
+			}
+#endif
+			++allocations;
+			live_bytes += size;
+			if (huge) {
+#ifdef __linux__
+				madvise(pointer, allocated_size, MADV_HUGEPAGE);
+#endif
+				++huge_page_allocations;
+				huge_page_live_bytes += size;
+			}
+			return pointer;
+		}
+
+		void aligned_deallocate(void* pointer, size_t size, size_t huge_page_threshold)
+		{
+			if (pointer == nullptr) {
+				return;
+			}
+			live_bytes -= size;
+			if (size >= huge_page_threshold) {
+				huge_page_live_bytes -= size;
+			}
+#ifdef _MSC_VER
+			_aligned_free(pointer);
+#else
+			free(pointer);
+#endif
+		}
+	}
+}
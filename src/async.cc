@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "async.h"
+
+namespace fcpp {
+	operation_cancelled::operation_cancelled()
+		: std::runtime_error("operation cancelled")
+	{
+	}
+
+	cancellation_token::cancellation_token()
+		: m_cancelled(std::make_shared<std::atomic<bool>>(false))
+	{
+	}
+
+	void cancellation_token::cancel() const
+	{
+		m_cancelled->store(true);
+	}
+
+	bool cancellation_token::is_cancelled() const
+	{
+		return m_cancelled->load(std::memory_order_relaxed);
+	}
+
+	void cancellation_token::throw_if_cancelled() const
+	{
+		if (is_cancelled()) {
+			throw operation_cancelled();
+		}
+	}
+
+	thread_pool::thread_pool(size_t thread_count)
+		: m_threads(), m_tasks(), m_mutex(), m_task_available(), m_stopping(false)
+	{
+		if (thread_count == 0) {
+			thread_count = std::thread::hardware_concurrency();
+		}
+		if (thread_count == 0) {
+			thread_count = 1;
+		}
+		for (size_t i = 0; i < thread_count; ++i) {
+			m_threads.push_back(std::thread([this]() {
+				work();
+			}));
+		}
+	}
+
+	thread_pool::~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_task_available.notify_all();
+		for (auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	void thread_pool::submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_task_available.notify_one();
+	}
+
+	executor thread_pool::as_executor()
+	{
+		return [this](std::function<void()> task) {
+			submit(std::move(task));
+		};
+	}
+
+	size_t thread_pool::thread_count() const
+	{
+		return m_threads.size();
+	}
+
+	void thread_pool::work()
+	{
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_task_available.wait(lock, [this]() {
+					return m_stopping || !m_tasks.empty();
+				});
+				// the queued tasks are finished before stopping
+				if (m_tasks.empty()) {
+					return;
+				}
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	executor default_executor()
+	{
+		static thread_pool pool;
+		return pool.as_executor();
+	}
+}
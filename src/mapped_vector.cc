@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include "mapped_vector.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define FCPP_MMAP_AVAILABLE
+#endif
+
+namespace fcpp {
+	namespace detail {
+		static void* map_buffer(size_t size)
+		{
+#ifdef FCPP_MMAP_AVAILABLE
+			void* buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return buffer == MAP_FAILED ? nullptr : buffer;
+#else
+			return std::malloc(size);
+#endif
+		}
+
+		static void unmap_buffer(void* buffer, size_t size)
+		{
+#ifdef FCPP_MMAP_AVAILABLE
+			munmap(buffer, size);
+#else
+			(void)size;
+			std::free(buffer);
+#endif
+		}
+
+		void* storage_reallocate(void* buffer, size_t old_size, size_t new_size)
+		{
+			if (!is_mapped_storage(new_size)) {
+				void* resized = std::realloc(buffer, new_size);
+				if (resized == nullptr) {
+					throw std::bad_alloc();
+				}
+				return resized;
+			}
+#ifdef __linux__
+			if (buffer != nullptr && is_mapped_storage(old_size)) {
+				void* remapped = mremap(buffer, old_size, new_size, MREMAP_MAYMOVE);
+				if (remapped == MAP_FAILED) {
+					throw std::bad_alloc();
+				}
+				return remapped;
+			}
+#endif
+			void* mapped = map_buffer(new_size);
+			if (mapped == nullptr) {
+				throw std::bad_alloc();
+			}
+			if (buffer != nullptr) {
+				std::memcpy(mapped, buffer, old_size < new_size ? old_size : new_size);
+				storage_deallocate(buffer, old_size);
+			}
+			return mapped;
+		}
+
+		void storage_deallocate(void* buffer, size_t size)
+		{
+			if (buffer == nullptr) {
+				return;
+			}
+			if (is_mapped_storage(size)) {
+				unmap_buffer(buffer, size);
+			} else {
+				std::free(buffer);
+			}
+		}
+	}
+}
@@ -0,0 +1,125 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include "multiprocess.h"
+
+#ifdef MULTIPROCESS_AVAILABLE
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fcpp {
+	multiprocess_error::multiprocess_error(const std::string& message)
+		: std::runtime_error(message)
+	{
+	}
+
+	namespace detail {
+		shared_memory_region::shared_memory_region(size_t size_in_bytes)
+			: m_data(nullptr), m_size(std::max<size_t>(size_in_bytes, 1))
+		{
+			m_data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (m_data == MAP_FAILED) {
+				throw multiprocess_error("could not map shared memory");
+			}
+		}
+
+		shared_memory_region::~shared_memory_region()
+		{
+			munmap(m_data, m_size);
+		}
+
+		void* shared_memory_region::data() const
+		{
+			return m_data;
+		}
+
+		size_t default_process_count()
+		{
+			const auto count = std::thread::hardware_concurrency();
+			return count > 0 ? count : 1;
+		}
+
+		// Waits for the child process, returns true if it exited successfully
+		static bool wait_for(pid_t child)
+		{
+			int status = 0;
+			while (waitpid(child, &status, 0) < 0) {
+				if (errno != EINTR) {
+					return false;
+				}
+			}
+			return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		}
+
+		size_t for_each_chunk_in_processes(size_t element_count,
+		                                   size_t process_count,
+		                                   const std::function<void(size_t, size_t, size_t)>& work)
+		{
+			if (process_count == 0) {
+				process_count = default_process_count();
+			}
+			const auto chunk_count = std::min(process_count, element_count);
+			std::vector<pid_t> children;
+			children.reserve(chunk_count);
+			auto started = true;
+			for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+				const auto start = element_count * chunk / chunk_count;
+				const auto end = element_count * (chunk + 1) / chunk_count;
+				const auto child = fork();
+				if (child < 0) {
+					started = false;
+					break;
+				}
+				if (child == 0) {
+					// the child must not return into the caller, nor run the parent's exit handlers
+					try {
+						work(chunk, start, end);
+					} catch (...) {
+						_exit(1);
+					}
+					_exit(0);
+				}
+				children.push_back(child);
+			}
+			auto succeeded = started;
+			for (const auto child : children) {
+				succeeded = wait_for(child) && succeeded;
+			}
+			if (!started) {
+				throw multiprocess_error("could not start a worker process");
+			}
+			if (!succeeded) {
+				throw multiprocess_error("a worker process did not finish successfully");
+			}
+			return chunk_count;
+		}
+	}
+}
+#endif
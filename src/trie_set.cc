@@ -0,0 +1,523 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "trie_set.h"
+
+namespace fcpp {
+	namespace {
+		// Index of the first child whose label starts with a character not less than c,
+		// the children are sorted as unsigned characters, the same as std::string comparisons
+		template <typename Node>
+		size_t child_lower_bound(const Node& parent, char c)
+		{
+			const auto it = std::lower_bound(parent.children.begin(),
+			                                 parent.children.end(),
+			                                 c,
+			                                 [](const std::unique_ptr<Node>& child, char value) {
+				                                 return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(value);
+			                                 });
+			return static_cast<size_t>(it - parent.children.begin());
+		}
+
+		template <typename Node>
+		bool has_child_at(const Node& parent, size_t index, char c)
+		{
+			return index < parent.children.size() && parent.children[index]->label[0] == c;
+		}
+
+		// Length of the common prefix of the label and the key from the given position
+		size_t common_prefix_length(const std::string& label, const std::string& key, size_t position)
+		{
+			size_t length = 0;
+			while (length < label.size() && position + length < key.size() && label[length] == key[position + length]) {
+				++length;
+			}
+			return length;
+		}
+	}
+
+	trie_set::node::node()
+		: label(), is_key(false), children()
+	{
+	}
+
+	trie_set::const_iterator::const_iterator()
+		: m_path(), m_key()
+	{
+	}
+
+	trie_set::const_iterator::const_iterator(const node* subtree_root, std::string key)
+		: m_path(), m_key(std::move(key))
+	{
+		if (subtree_root == nullptr) {
+			return;
+		}
+		frame root_frame = {subtree_root, 0};
+		m_path.push_back(root_frame);
+		if (!subtree_root->is_key) {
+			advance();
+		}
+	}
+
+	trie_set::const_iterator::reference trie_set::const_iterator::operator*() const
+	{
+		return m_key;
+	}
+
+	trie_set::const_iterator::pointer trie_set::const_iterator::operator->() const
+	{
+		return &m_key;
+	}
+
+	trie_set::const_iterator& trie_set::const_iterator::operator++()
+	{
+		advance();
+		return *this;
+	}
+
+	trie_set::const_iterator trie_set::const_iterator::operator++(int)
+	{
+		const_iterator copy(*this);
+		advance();
+		return copy;
+	}
+
+	bool trie_set::const_iterator::operator ==(const const_iterator& rhs) const
+	{
+		if (m_path.empty() || rhs.m_path.empty()) {
+			return m_path.empty() && rhs.m_path.empty();
+		}
+		return m_path.back().visited == rhs.m_path.back().visited;
+	}
+
+	bool trie_set::const_iterator::operator !=(const const_iterator& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	// Pre-order traversal with the children in ascending order, which visits the keys in ascending order
+	void trie_set::const_iterator::advance()
+	{
+		while (!m_path.empty()) {
+			auto& top = m_path.back();
+			if (top.next_child < top.visited->children.size()) {
+				const node* child = top.visited->children[top.next_child].get();
+				++top.next_child;
+				m_key.append(child->label);
+				frame child_frame = {child, 0};
+				m_path.push_back(child_frame);
+				if (child->is_key) {
+					return;
+				}
+			} else {
+				m_key.resize(m_key.size() - top.visited->label.size());
+				m_path.pop_back();
+			}
+		}
+	}
+
+	trie_set::prefix_view::prefix_view(const node* subtree_root, std::string subtree_key)
+		: m_subtree_root(subtree_root), m_subtree_key(std::move(subtree_key))
+	{
+	}
+
+	trie_set::const_iterator trie_set::prefix_view::begin() const
+	{
+		return const_iterator(m_subtree_root, m_subtree_key);
+	}
+
+	trie_set::const_iterator trie_set::prefix_view::end() const
+	{
+		return const_iterator();
+	}
+
+	size_t trie_set::prefix_view::size() const
+	{
+		return static_cast<size_t>(std::distance(begin(), end()));
+	}
+
+	bool trie_set::prefix_view::is_empty() const
+	{
+		return begin() == end();
+	}
+
+	vector<std::string> trie_set::prefix_view::keys() const
+	{
+		return vector<std::string>(std::vector<std::string>(begin(), end()));
+	}
+
+	trie_set::trie_set()
+		: m_root(new node()), m_size(0)
+	{
+	}
+
+	trie_set::trie_set(const std::set<std::string>& set)
+		: trie_set()
+	{
+		for (const auto& key : set) {
+			insert(key);
+		}
+	}
+
+	trie_set::trie_set(const fcpp::set<std::string>& set)
+		: trie_set()
+	{
+		for (const auto& key : set) {
+			insert(key);
+		}
+	}
+
+	trie_set::trie_set(const std::vector<std::string>& vector)
+		: trie_set()
+	{
+		for (const auto& key : vector) {
+			insert(key);
+		}
+	}
+
+	trie_set::trie_set(const std::initializer_list<std::string>& list)
+		: trie_set()
+	{
+		for (const auto& key : list) {
+			insert(key);
+		}
+	}
+
+	trie_set::trie_set(const trie_set& other)
+		: m_root(clone(*other.m_root)), m_size(other.m_size)
+	{
+	}
+
+	trie_set::trie_set(trie_set&& other)
+		: m_root(std::move(other.m_root)), m_size(other.m_size)
+	{
+		other.m_root.reset(new node());
+		other.m_size = 0;
+	}
+
+	trie_set& trie_set::operator=(trie_set other)
+	{
+		std::swap(m_root, other.m_root);
+		std::swap(m_size, other.m_size);
+		return *this;
+	}
+
+	trie_set::~trie_set()
+	{
+	}
+
+	trie_set::prefix_view trie_set::with_prefix(const std::string& prefix) const
+	{
+		const node* x = m_root.get();
+		size_t position = 0;
+		while (position < prefix.size()) {
+			const auto index = child_lower_bound(*x, prefix[position]);
+			if (!has_child_at(*x, index, prefix[position])) {
+				return prefix_view(nullptr, std::string());
+			}
+			const node* child = x->children[index].get();
+			const auto common = common_prefix_length(child->label, prefix, position);
+			if (position + common == prefix.size()) {
+				// the prefix ends inside (or at the end of) the child's label
+				return prefix_view(child, prefix.substr(0, position) + child->label);
+			}
+			if (common < child->label.size()) {
+				return prefix_view(nullptr, std::string());
+			}
+			position += common;
+			x = child;
+		}
+		return prefix_view(x, prefix);
+	}
+
+	fcpp::optional_t<std::string> trie_set::longest_prefix_match(const std::string& query) const
+	{
+		const node* x = m_root.get();
+		auto is_found = x->is_key;
+		size_t longest = 0;
+		size_t position = 0;
+		while (position < query.size()) {
+			const auto index = child_lower_bound(*x, query[position]);
+			if (!has_child_at(*x, index, query[position])) {
+				break;
+			}
+			x = x->children[index].get();
+			if (query.compare(position, x->label.size(), x->label) != 0) {
+				break;
+			}
+			position += x->label.size();
+			if (x->is_key) {
+				is_found = true;
+				longest = position;
+			}
+		}
+		if (!is_found) {
+			return fcpp::optional_t<std::string>();
+		}
+		return query.substr(0, longest);
+	}
+
+	trie_set trie_set::difference_with(const trie_set& other) const
+	{
+		std::vector<std::string> diff;
+		std::set_difference(begin(), end(), other.begin(), other.end(), std::back_inserter(diff));
+		return from_sorted(diff.begin(), diff.end());
+	}
+
+	trie_set trie_set::difference_with(const std::set<std::string>& other) const
+	{
+		std::vector<std::string> diff;
+		std::set_difference(begin(), end(), other.begin(), other.end(), std::back_inserter(diff));
+		return from_sorted(diff.begin(), diff.end());
+	}
+
+	trie_set trie_set::union_with(const trie_set& other) const
+	{
+		std::vector<std::string> combined;
+		std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(combined));
+		return from_sorted(combined.begin(), combined.end());
+	}
+
+	trie_set trie_set::union_with(const std::set<std::string>& other) const
+	{
+		std::vector<std::string> combined;
+		std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(combined));
+		return from_sorted(combined.begin(), combined.end());
+	}
+
+	trie_set trie_set::intersect_with(const trie_set& other) const
+	{
+		std::vector<std::string> intersection;
+		std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(intersection));
+		return from_sorted(intersection.begin(), intersection.end());
+	}
+
+	trie_set trie_set::intersect_with(const std::set<std::string>& other) const
+	{
+		std::vector<std::string> intersection;
+		std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(intersection));
+		return from_sorted(intersection.begin(), intersection.end());
+	}
+
+	fcpp::optional_t<std::string> trie_set::min() const
+	{
+		if (m_size == 0) {
+			return fcpp::optional_t<std::string>();
+		}
+		return *begin();
+	}
+
+	fcpp::optional_t<std::string> trie_set::max() const
+	{
+		if (m_size == 0) {
+			return fcpp::optional_t<std::string>();
+		}
+		// every leaf except the root is a key, so the rightmost leaf is the largest key
+		const node* x = m_root.get();
+		std::string key;
+		while (!x->children.empty()) {
+			x = x->children.back().get();
+			key.append(x->label);
+		}
+		return key;
+	}
+
+	vector<std::string> trie_set::keys() const
+	{
+		return vector<std::string>(std::vector<std::string>(begin(), end()));
+	}
+
+	trie_set& trie_set::remove(const std::string& key)
+	{
+		// the visited nodes, with their index in their parent's children
+		std::vector<std::pair<node*, size_t>> path;
+		path.push_back(std::make_pair(m_root.get(), static_cast<size_t>(0)));
+		size_t position = 0;
+		while (position < key.size()) {
+			node* x = path.back().first;
+			const auto index = child_lower_bound(*x, key[position]);
+			if (!has_child_at(*x, index, key[position])) {
+				return *this;
+			}
+			node* child = x->children[index].get();
+			if (key.compare(position, child->label.size(), child->label) != 0) {
+				return *this;
+			}
+			position += child->label.size();
+			path.push_back(std::make_pair(child, index));
+		}
+
+		node* x = path.back().first;
+		if (!x->is_key) {
+			return *this;
+		}
+		x->is_key = false;
+		--m_size;
+		if (path.size() == 1) {
+			return *this;
+		}
+
+		// keep the tree compressed: no leaves without a key, and no non-key nodes with a single child
+		const auto merge_with_only_child = [](node* n) {
+			std::unique_ptr<node> child = std::move(n->children[0]);
+			n->label.append(child->label);
+			n->is_key = child->is_key;
+			n->children = std::move(child->children);
+		};
+		if (x->children.empty()) {
+			node* parent = path[path.size() - 2].first;
+			parent->children.erase(parent->children.begin() + path.back().second);
+			if (path.size() > 2 && !parent->is_key && parent->children.size() == 1) {
+				merge_with_only_child(parent);
+			}
+		} else if (x->children.size() == 1) {
+			merge_with_only_child(x);
+		}
+		return *this;
+	}
+
+	trie_set trie_set::removing(const std::string& key) const
+	{
+		auto copy(*this);
+		copy.remove(key);
+		return copy;
+	}
+
+	trie_set& trie_set::insert(const std::string& key)
+	{
+		node* x = m_root.get();
+		size_t position = 0;
+		while (true) {
+			if (position == key.size()) {
+				if (!x->is_key) {
+					x->is_key = true;
+					++m_size;
+				}
+				return *this;
+			}
+
+			const auto index = child_lower_bound(*x, key[position]);
+			if (!has_child_at(*x, index, key[position])) {
+				std::unique_ptr<node> leaf(new node());
+				leaf->label = key.substr(position);
+				leaf->is_key = true;
+				x->children.insert(x->children.begin() + index, std::move(leaf));
+				++m_size;
+				return *this;
+			}
+
+			node* child = x->children[index].get();
+			const auto common = common_prefix_length(child->label, key, position);
+			if (common < child->label.size()) {
+				// split the child's label, the shared part becomes a new node above it
+				std::unique_ptr<node> middle(new node());
+				middle->label = child->label.substr(0, common);
+				child->label.erase(0, common);
+				middle->children.push_back(std::move(x->children[index]));
+				x->children[index] = std::move(middle);
+				child = x->children[index].get();
+			}
+			x = child;
+			position += common;
+		}
+	}
+
+	trie_set trie_set::inserting(const std::string& key) const
+	{
+		auto copy(*this);
+		copy.insert(key);
+		return copy;
+	}
+
+	trie_set& trie_set::clear()
+	{
+		m_root.reset(new node());
+		m_size = 0;
+		return *this;
+	}
+
+	trie_set trie_set::clearing() const
+	{
+		return trie_set();
+	}
+
+	bool trie_set::is_empty() const
+	{
+		return m_size == 0;
+	}
+
+	bool trie_set::contains(const std::string& key) const
+	{
+		const node* x = m_root.get();
+		size_t position = 0;
+		while (position < key.size()) {
+			const auto index = child_lower_bound(*x, key[position]);
+			if (!has_child_at(*x, index, key[position])) {
+				return false;
+			}
+			x = x->children[index].get();
+			if (key.compare(position, x->label.size(), x->label) != 0) {
+				return false;
+			}
+			position += x->label.size();
+		}
+		return x->is_key;
+	}
+
+	size_t trie_set::size() const
+	{
+		return m_size;
+	}
+
+	trie_set::const_iterator trie_set::begin() const
+	{
+		return const_iterator(m_root.get(), std::string());
+	}
+
+	trie_set::const_iterator trie_set::end() const
+	{
+		return const_iterator();
+	}
+
+	bool trie_set::operator ==(const trie_set& rhs) const
+	{
+		return m_size == rhs.m_size && std::equal(begin(), end(), rhs.begin());
+	}
+
+	bool trie_set::operator !=(const trie_set& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	std::unique_ptr<trie_set::node> trie_set::clone(const node& original)
+	{
+		std::unique_ptr<node> copy(new node());
+		copy->label = original.label;
+		copy->is_key = original.is_key;
+		copy->children.reserve(original.children.size());
+		for (const auto& child : original.children) {
+			copy->children.push_back(clone(*child));
+		}
+		return copy;
+	}
+}
@@ -0,0 +1,196 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "warnings.h"
+#include "aligned_allocator.h"
+#include "vector.h"
+#include "set.h"
+#include "incremental.h"
+
+using namespace fcpp;
+
+typedef vector<int, aligned_allocator<int>> aligned_vector;
+
+static bool is_aligned(const void* pointer, size_t alignment)
+{
+	return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+TEST(AlignedAllocatorTest, CacheLineAlignment)
+{
+	const aligned_vector vector_under_test({ 1, 4, 2 });
+	EXPECT_TRUE(is_aligned(&vector_under_test[0], 64));
+}
+
+TEST(AlignedAllocatorTest, CustomAlignment)
+{
+	const vector<char, aligned_allocator<char, 4096>> vector_under_test(10, 'a');
+	EXPECT_TRUE(is_aligned(&vector_under_test[0], 4096));
+}
+
+TEST(AlignedAllocatorTest, StatisticsOfSmallBuffer)
+{
+	const auto before = aligned_allocation_statistics();
+	{
+		const aligned_vector vector_under_test(100, 7);
+		const auto during = aligned_allocation_statistics();
+		EXPECT_EQ(before.allocations + 1, during.allocations);
+		EXPECT_EQ(before.huge_page_allocations, during.huge_page_allocations);
+		EXPECT_EQ(before.live_bytes + 100 * sizeof(int), during.live_bytes);
+	}
+	EXPECT_EQ(before.live_bytes, aligned_allocation_statistics().live_bytes);
+}
+
+TEST(AlignedAllocatorTest, LargeBufferIsAdvisedHugePages)
+{
+	const auto before = aligned_allocation_statistics();
+	{
+		const size_t count = (size_t(4) << 20) / sizeof(int);
+		const aligned_vector vector_under_test(count, 1);
+		EXPECT_TRUE(is_aligned(&vector_under_test[0], size_t(2) << 20));
+		const auto during = aligned_allocation_statistics();
+		EXPECT_EQ(before.huge_page_allocations + 1, during.huge_page_allocations);
+		EXPECT_EQ(before.huge_page_live_bytes + count * sizeof(int), during.huge_page_live_bytes);
+		EXPECT_GE(count * sizeof(int) + (size_t(4) << 20), huge_page_backed_bytes(&vector_under_test[0], count * sizeof(int)));
+	}
+	EXPECT_EQ(before.huge_page_live_bytes, aligned_allocation_statistics().huge_page_live_bytes);
+}
+
+TEST(AlignedAllocatorTest, MutatingFunctions)
+{
+	aligned_vector vector_under_test({ 1, 4, 2 });
+	vector_under_test.insert_back(5).insert_front(aligned_vector({ 8, 9 })).remove_at(1).sort(std::less<int>());
+	EXPECT_EQ(aligned_vector({ 1, 2, 4, 5, 8 }), vector_under_test);
+	EXPECT_TRUE(is_aligned(&vector_under_test[0], 64));
+}
+
+TEST(AlignedAllocatorTest, NonMutatingFunctionsKeepTheAllocator)
+{
+	const aligned_vector vector_under_test({ 1, 4, 2, 5 });
+	const aligned_vector evens = vector_under_test.filtered([](const int& x) {
+		return x % 2 == 0;
+	});
+	EXPECT_EQ(aligned_vector({ 4, 2 }), evens);
+	const aligned_vector reversed = vector_under_test.reversed();
+	EXPECT_EQ(aligned_vector({ 5, 2, 4, 1 }), reversed);
+}
+
+TEST(AlignedAllocatorTest, MapAndReduce)
+{
+	const aligned_vector vector_under_test({ 1, 4, 2 });
+	const auto strings = vector_under_test.map<std::string>([](const int& x) {
+		return std::to_string(x);
+	});
+	EXPECT_EQ(vector<std::string>({ "1", "4", "2" }), strings);
+	EXPECT_EQ(7, vector_under_test.reduce(0, [](const int& sum, const int& x) {
+		return sum + x;
+	}));
+}
+
+TEST(AlignedAllocatorTest, Distinct)
+{
+	const aligned_vector vector_under_test({ 1, 4, 2, 4, 1 });
+	EXPECT_EQ(set<int>({ 1, 2, 4 }), vector_under_test.distinct());
+}
+
+TEST(AlignedAllocatorTest, FromStdVector)
+{
+	const std::vector<int> values({ 3, 1 });
+	const aligned_vector vector_under_test(values);
+	EXPECT_EQ(aligned_vector({ 3, 1 }), vector_under_test);
+}
+
+TEST(AlignedAllocatorTest, Zip)
+{
+	const aligned_vector numbers({ 1, 4 });
+	const vector<std::string, aligned_allocator<std::string>> names({ "one", "four" });
+	const auto zipped = numbers.zip(names);
+	const auto expected = vector<std::pair<int, std::string>>({ { 1, "one" }, { 4, "four" } });
+	EXPECT_EQ(expected, zipped);
+	const auto zipped_rvalue = aligned_vector(numbers).zip(numbers);
+	const auto expected_rvalue = vector<std::pair<int, int>>({ { 1, 1 }, { 4, 4 } });
+	EXPECT_EQ(expected_rvalue, zipped_rvalue);
+}
+
+TEST(AlignedAllocatorTest, IncrementalAlgorithms)
+{
+	const aligned_vector vector_under_test({ 3, 1, 4, 1, 5 });
+	auto squares = map_incremental<int>(vector_under_test, [](const int& x) {
+		return x * x;
+	});
+	EXPECT_EQ(vector<int>({ 9, 1, 16, 1, 25 }), squares.run_to_completion());
+	auto odd = filtered_incremental(vector_under_test, [](const int& x) {
+		return x % 2 == 1;
+	});
+	EXPECT_EQ(aligned_vector({ 3, 1, 1, 5 }), odd.run_to_completion());
+	auto sum = reduce_incremental(vector_under_test, 0, [](const int& partial, const int& x) {
+		return partial + x;
+	});
+	EXPECT_EQ(14, sum.run_to_completion());
+	auto sorting = sorted_incremental(aligned_vector(vector_under_test), std::less<int>());
+	EXPECT_EQ(aligned_vector({ 1, 1, 3, 4, 5 }), sorting.run_to_completion());
+	auto unique = distinct_incremental(vector_under_test);
+	EXPECT_EQ(set<int>({ 1, 3, 4, 5 }), unique.run_to_completion());
+}
+
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(AlignedAllocatorTest, ParallelFunctions)
+{
+	aligned_vector vector_under_test({ 3, 1, 4, 1, 5 });
+	const auto is_odd = [](const int& x) {
+		return x % 2 == 1;
+	};
+	EXPECT_EQ(vector<int>({ 6, 2, 8, 2, 10 }), vector_under_test.map_parallel<int>([](const int& x) {
+		return 2 * x;
+	}));
+	EXPECT_FALSE(vector_under_test.all_of_parallel(is_odd));
+	EXPECT_TRUE(vector_under_test.any_of_parallel(is_odd));
+	EXPECT_FALSE(vector_under_test.none_of_parallel(is_odd));
+	EXPECT_EQ(aligned_vector({ 3, 1, 1, 5 }), vector_under_test.filtered_parallel(is_odd));
+	EXPECT_EQ(aligned_vector({ 1, 1, 3, 4, 5 }), vector_under_test.sorted_parallel(std::less<int>()));
+	EXPECT_EQ(aligned_vector({ 1, 1, 3, 4, 5 }), vector_under_test.sorted_ascending_parallel());
+	EXPECT_EQ(aligned_vector({ 5, 4, 3, 1, 1 }), vector_under_test.sorted_descending_parallel());
+	EXPECT_EQ(set<int>({ 1, 3, 4, 5 }), vector_under_test.distinct_parallel());
+	EXPECT_EQ(set<int>({ 1, 3, 4, 5 }), set<int>::from_parallel(vector_under_test));
+	int sum = 0;
+	std::mutex mutex;
+	vector_under_test.for_each_parallel([&sum, &mutex](const int& x) {
+		std::lock_guard<std::mutex> lock(mutex);
+		sum += x;
+	});
+	EXPECT_EQ(14, sum);
+
+	vector_under_test.filter_parallel(is_odd).sort_parallel(std::less<int>());
+	EXPECT_EQ(aligned_vector({ 1, 1, 3, 5 }), vector_under_test);
+	vector_under_test.sort_descending_parallel();
+	EXPECT_EQ(aligned_vector({ 5, 3, 1, 1 }), vector_under_test);
+	vector_under_test.sort_ascending_parallel();
+	EXPECT_EQ(aligned_vector({ 1, 1, 3, 5 }), vector_under_test);
+	EXPECT_TRUE(is_aligned(&vector_under_test[0], 64));
+}
+#endif
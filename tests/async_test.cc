@@ -0,0 +1,270 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "warnings.h"
+#include "async.h"
+
+using namespace fcpp;
+
+TEST(AsyncTest, CancellationTokenIsSharedByCopies)
+{
+	const cancellation_token token;
+	const auto copy = token;
+	EXPECT_FALSE(copy.is_cancelled());
+	EXPECT_NO_THROW(copy.throw_if_cancelled());
+	token.cancel();
+	EXPECT_TRUE(copy.is_cancelled());
+	EXPECT_THROW(copy.throw_if_cancelled(), operation_cancelled);
+}
+
+TEST(AsyncTest, ThreadPoolRunsAllTasks)
+{
+	std::atomic<int> executed(0);
+	{
+		thread_pool pool(3);
+		EXPECT_EQ(3, pool.thread_count());
+		for (auto i = 0; i < 100; ++i) {
+			pool.submit([&executed]() {
+				++executed;
+			});
+		}
+	}
+	EXPECT_EQ(100, executed.load());
+}
+
+TEST(AsyncTest, ThreadPoolUsesItsThreads)
+{
+	thread_pool pool(2);
+	std::mutex mutex;
+	std::set<std::thread::id> thread_ids;
+	std::vector<std::future<void>> futures;
+	for (auto i = 0; i < 20; ++i) {
+		const auto done = std::make_shared<std::promise<void>>();
+		futures.push_back(done->get_future());
+		pool.as_executor()([&mutex, &thread_ids, done]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			thread_ids.insert(std::this_thread::get_id());
+			done->set_value();
+		});
+	}
+	for (auto& future : futures) {
+		future.get();
+	}
+	EXPECT_GE(2, thread_ids.size());
+	EXPECT_EQ(0, thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST(AsyncTest, DefaultExecutor)
+{
+	std::promise<std::thread::id> promise;
+	auto future = promise.get_future();
+	default_executor()([&promise]() {
+		promise.set_value(std::this_thread::get_id());
+	});
+	EXPECT_NE(std::this_thread::get_id(), future.get());
+}
+
+TEST(AsyncTest, VectorMapAsync)
+{
+	const vector<int> numbers({1, 3, -5});
+	auto future = map_async<std::string>(numbers, [](const int& number) {
+		return std::to_string(number);
+	});
+	EXPECT_EQ(vector<std::string>({"1", "3", "-5"}), future.get());
+}
+
+TEST(AsyncTest, VectorFilteredAsync)
+{
+	const vector<int> numbers({1, 3, -5, 2, -1, 9, -4});
+	auto future = filtered_async(numbers, [](const int& number) {
+		return number >= 1.5;
+	});
+	EXPECT_EQ(vector<int>({3, 2, 9}), future.get());
+}
+
+TEST(AsyncTest, VectorSortedAsync)
+{
+	const vector<int> numbers({3, 1, 9, -4});
+	auto future = sorted_async(numbers, std::less<int>());
+	EXPECT_EQ(vector<int>({-4, 1, 3, 9}), future.get());
+	EXPECT_EQ(vector<int>({3, 1, 9, -4}), numbers);
+}
+
+TEST(AsyncTest, VectorReduceAsync)
+{
+	const vector<int> numbers({1, 2, 3, 4});
+	auto future = reduce_async(numbers, 0, [](const int& partial_sum, const int& number) {
+		return partial_sum + number;
+	});
+	EXPECT_EQ(10, future.get());
+}
+
+TEST(AsyncTest, VectorOperationsOnTemporaries)
+{
+	std::vector<std::function<void()>> queued_tasks;
+	const executor deferred = [&queued_tasks](std::function<void()> task) {
+		queued_tasks.push_back(std::move(task));
+	};
+	auto mapped = map_async<int>(vector<int>({1, 2, 3}), [](const int& number) {
+		return number * 2;
+	}, cancellation_token(), deferred);
+	auto filtered = filtered_async(vector<int>({1, 2, 3}), [](const int& number) {
+		return number > 1;
+	}, cancellation_token(), deferred);
+	auto sorted = sorted_async(vector<int>({3, 1, 2}), std::less<int>(), cancellation_token(), deferred);
+	auto reduced = reduce_async(vector<int>({1, 2, 3}), 0, [](const int& partial_sum, const int& number) {
+		return partial_sum + number;
+	}, cancellation_token(), deferred);
+
+	// the temporaries are destroyed before the operations run
+	EXPECT_EQ(4, queued_tasks.size());
+	for (const auto& task : queued_tasks) {
+		task();
+	}
+	EXPECT_EQ(vector<int>({2, 4, 6}), mapped.get());
+	EXPECT_EQ(vector<int>({2, 3}), filtered.get());
+	EXPECT_EQ(vector<int>({1, 2, 3}), sorted.get());
+	EXPECT_EQ(6, reduced.get());
+}
+
+TEST(AsyncTest, AsyncOnCustomExecutor)
+{
+	const vector<int> numbers({1, 2, 3});
+	std::vector<std::function<void()>> queued_tasks;
+	const executor deferred = [&queued_tasks](std::function<void()> task) {
+		queued_tasks.push_back(std::move(task));
+	};
+	auto future = map_async<int>(numbers, [](const int& number) {
+		return number * 2;
+	}, cancellation_token(), deferred);
+	EXPECT_EQ(1, queued_tasks.size());
+	queued_tasks[0]();
+	EXPECT_EQ(vector<int>({2, 4, 6}), future.get());
+}
+
+TEST(AsyncTest, AsyncCancelledBeforeStart)
+{
+	const vector<int> numbers({3, 1, 9, -4});
+	cancellation_token token;
+	token.cancel();
+	auto future = sorted_async(numbers, std::less<int>(), token);
+	EXPECT_THROW(future.get(), operation_cancelled);
+}
+
+TEST(AsyncTest, AsyncCancelledWhileRunning)
+{
+	const vector<int> numbers(100000, 1);
+	cancellation_token token;
+	auto transformed = 0;
+	auto future = map_async<int>(numbers, [&token, &transformed](const int& number) {
+		if (++transformed == 10000) {
+			token.cancel();
+		}
+		return number;
+	}, token);
+	EXPECT_THROW(future.get(), operation_cancelled);
+	EXPECT_GT(100000, transformed);
+}
+
+TEST(AsyncTest, AsyncExceptionIsPropagated)
+{
+	const vector<int> numbers({1, 2, 3});
+	auto future = filtered_async(numbers, [](const int&) -> bool {
+		throw std::runtime_error("invalid");
+	});
+	EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(AsyncTest, SetMapAsync)
+{
+	const set<int> numbers({1, 3, -5});
+	auto future = map_async<std::string>(numbers, [](const int& number) {
+		return std::to_string(number);
+	});
+	EXPECT_EQ(set<std::string>({"-5", "1", "3"}), future.get());
+}
+
+TEST(AsyncTest, SetFilteredAsync)
+{
+	const set<int> numbers({1, 3, -5, 2, -1, 9, -4});
+	auto future = filtered_async(numbers, [](const int& number) {
+		return number >= 1.5;
+	});
+	EXPECT_EQ(set<int>({2, 3, 9}), future.get());
+}
+
+TEST(AsyncTest, SetReduceAsync)
+{
+	const set<int> numbers({1, 2, 3, 4});
+	thread_pool pool(2);
+	auto future = reduce_async(numbers, 0, [](const int& partial_sum, const int& number) {
+		return partial_sum + number;
+	}, cancellation_token(), pool.as_executor());
+	EXPECT_EQ(10, future.get());
+}
+
+TEST(AsyncTest, SetOperationsOnTemporaries)
+{
+	std::vector<std::function<void()>> queued_tasks;
+	const executor deferred = [&queued_tasks](std::function<void()> task) {
+		queued_tasks.push_back(std::move(task));
+	};
+	auto mapped = map_async<int>(set<int>({1, 2, 3}), [](const int& number) {
+		return number * 2;
+	}, cancellation_token(), deferred);
+	auto filtered = filtered_async(set<int>({1, 2, 3}), [](const int& number) {
+		return number > 1;
+	}, cancellation_token(), deferred);
+	auto reduced = reduce_async(set<int>({1, 2, 3}), 0, [](const int& partial_sum, const int& number) {
+		return partial_sum + number;
+	}, cancellation_token(), deferred);
+
+	// the temporaries are destroyed before the operations run
+	EXPECT_EQ(3, queued_tasks.size());
+	for (const auto& task : queued_tasks) {
+		task();
+	}
+	EXPECT_EQ(set<int>({2, 4, 6}), mapped.get());
+	EXPECT_EQ(set<int>({2, 3}), filtered.get());
+	EXPECT_EQ(6, reduced.get());
+}
+
+TEST(AsyncTest, SetAsyncCancelledBeforeStart)
+{
+	const set<int> numbers({1, 2, 3});
+	cancellation_token token;
+	token.cancel();
+	auto future = filtered_async(numbers, [](const int& number) {
+		return number > 1;
+	}, token);
+	EXPECT_THROW(future.get(), operation_cancelled);
+}
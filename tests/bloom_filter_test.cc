@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include "warnings.h"
+#include "bloom_filter.h"
+#include "vector.h"
+
+using namespace fcpp;
+
+TEST(BloomFilterTest, NoFalseNegatives)
+{
+	bloom_filter<int> filter(10000, 0.01);
+	for (auto i = 0; i < 10000; ++i) {
+		filter.insert(i * 7);
+	}
+	EXPECT_EQ(10000, filter.size());
+	for (auto i = 0; i < 10000; ++i) {
+		EXPECT_TRUE(filter.might_contain(i * 7));
+	}
+}
+
+TEST(BloomFilterTest, FalsePositiveRateCloseToTarget)
+{
+	bloom_filter<std::string> filter(10000, 0.01);
+	for (auto i = 0; i < 10000; ++i) {
+		filter.insert("key" + std::to_string(i));
+	}
+	auto false_positives = 0;
+	for (auto i = 0; i < 10000; ++i) {
+		if (filter.might_contain("absent" + std::to_string(i))) {
+			++false_positives;
+		}
+	}
+	EXPECT_LT(false_positives, 300);
+}
+
+TEST(BloomFilterTest, Clear)
+{
+	bloom_filter<int> filter(100, 0.01);
+	filter.insert(5);
+	filter.clear();
+	EXPECT_EQ(0, filter.size());
+	EXPECT_FALSE(filter.might_contain(5));
+}
+
+TEST(BloomFilterTest, Sizing)
+{
+	const bloom_filter<int> filter(1000, 0.01);
+	EXPECT_EQ(1000, filter.expected_count());
+	EXPECT_GE(filter.bit_count(), 9585);
+	EXPECT_EQ(0, filter.bit_count() % 512);
+	EXPECT_EQ(7, filter.hash_count());
+}
+
+TEST(BloomSetTest, InsertContains)
+{
+	bloom_set<int> numbers;
+	numbers.insert(1).insert(4).insert(2).insert(4);
+	EXPECT_EQ(3, numbers.size());
+	EXPECT_TRUE(numbers.contains(1));
+	EXPECT_TRUE(numbers.contains(4));
+	EXPECT_FALSE(numbers.contains(15));
+	EXPECT_EQ(set<int>({1, 2, 4}), numbers.as_set());
+}
+
+TEST(BloomSetTest, ConstructFromSet)
+{
+	const bloom_set<int> numbers(set<int>({1, 4, 2}), 0.001);
+	EXPECT_TRUE(numbers.contains(2));
+	EXPECT_FALSE(numbers.contains(3));
+	EXPECT_EQ(0.001, numbers.filter().false_positive_rate());
+}
+
+TEST(BloomSetTest, GrowsBeyondExpectedCount)
+{
+	bloom_set<int> numbers(0.01, 16);
+	for (auto i = 0; i < 5000; ++i) {
+		numbers.insert(i);
+	}
+	EXPECT_GE(numbers.filter().expected_count(), 5000);
+	for (auto i = 0; i < 5000; ++i) {
+		EXPECT_TRUE(numbers.contains(i));
+	}
+	const auto stats = numbers.stats();
+	EXPECT_EQ(5000, stats.queries);
+	EXPECT_EQ(0, stats.filtered_out);
+	EXPECT_EQ(0, stats.false_positives);
+}
+
+TEST(BloomSetTest, StatsForNegativeQueries)
+{
+	bloom_set<int> numbers(0.01, 1000);
+	for (auto i = 0; i < 1000; ++i) {
+		numbers.insert(i);
+	}
+	for (auto i = 1000; i < 11000; ++i) {
+		EXPECT_FALSE(numbers.contains(i));
+	}
+	const auto stats = numbers.stats();
+	EXPECT_EQ(10000, stats.queries);
+	EXPECT_EQ(10000, stats.filtered_out + stats.false_positives);
+	EXPECT_LT(stats.observed_false_positive_rate(), 0.03);
+
+	numbers.reset_stats();
+	EXPECT_EQ(0, numbers.stats().queries);
+	EXPECT_EQ(0.0, numbers.stats().observed_false_positive_rate());
+}
+
+TEST(BloomSetTest, RemoveHeavyWorkloadRebuildsFilter)
+{
+	bloom_set<int> numbers(0.01, 1000);
+	for (auto i = 0; i < 1000; ++i) {
+		numbers.insert(i);
+	}
+	for (auto i = 0; i < 900; ++i) {
+		numbers.remove(i);
+	}
+	EXPECT_EQ(100, numbers.size());
+	EXPECT_LT(numbers.filter().size(), 1000);
+	for (auto i = 0; i < 900; ++i) {
+		EXPECT_FALSE(numbers.contains(i));
+	}
+	for (auto i = 900; i < 1000; ++i) {
+		EXPECT_TRUE(numbers.contains(i));
+	}
+	EXPECT_LT(numbers.stats().observed_false_positive_rate(), 0.05);
+}
+
+TEST(BloomSetTest, Clear)
+{
+	bloom_set<int> numbers;
+	numbers.insert(1).insert(4);
+	numbers.clear();
+	EXPECT_TRUE(numbers.is_empty());
+	EXPECT_FALSE(numbers.contains(1));
+}
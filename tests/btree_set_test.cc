@@ -0,0 +1,299 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "warnings.h"
+#include "btree_set.h"
+#include "frozen_set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+namespace {
+	template <typename TKey, typename TCompare>
+	void expect_same_keys(const std::set<TKey, TCompare>& expected, const btree_set<TKey, TCompare>& actual)
+	{
+		EXPECT_EQ(expected.size(), actual.size());
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin()));
+		EXPECT_TRUE(std::equal(expected.rbegin(), expected.rend(), std::reverse_iterator<typename btree_set<TKey, TCompare>::const_iterator>(actual.end())));
+	}
+}
+
+TEST(BtreeSetTest, EmptyConstructor)
+{
+	const btree_set<int> set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_TRUE(set_under_test.begin() == set_under_test.end());
+	EXPECT_FALSE(set_under_test.min().has_value());
+	EXPECT_FALSE(set_under_test.max().has_value());
+}
+
+TEST(BtreeSetTest, ConstructorRemovesDuplicatesAndSorts)
+{
+	const btree_set<int> set_under_test({1, 5, 3, 3, 1});
+	EXPECT_EQ(3, set_under_test.size());
+	EXPECT_EQ(1, set_under_test[0]);
+	EXPECT_EQ(3, set_under_test[1]);
+	EXPECT_EQ(5, set_under_test[2]);
+}
+
+TEST(BtreeSetTest, ConstructorFromSet)
+{
+	const set<int> numbers({4, 1, 7});
+	const btree_set<int> set_under_test(numbers);
+	EXPECT_EQ(btree_set<int>({1, 4, 7}), set_under_test);
+}
+
+namespace {
+	// A comparator whose order is chosen at runtime
+	struct runtime_order
+	{
+		explicit runtime_order(bool descending = false)
+			: descending(descending)
+		{
+		}
+
+		bool operator()(const int& a, const int& b) const
+		{
+			return descending ? b < a : a < b;
+		}
+
+		bool descending;
+	};
+}
+
+TEST(BtreeSetTest, ConstructorFromSetKeepsComparator)
+{
+	const set<int, runtime_order> numbers(std::set<int, runtime_order>({4, 1, 7}, runtime_order(true)));
+	btree_set<int, runtime_order> set_under_test(numbers);
+	set_under_test.insert(5);
+	EXPECT_EQ(4, set_under_test.size());
+	EXPECT_EQ(7, set_under_test[0]);
+	EXPECT_EQ(5, set_under_test[1]);
+	EXPECT_EQ(4, set_under_test[2]);
+	EXPECT_EQ(1, set_under_test[3]);
+}
+
+TEST(BtreeSetTest, LargeSortedConstruction)
+{
+	std::set<int> expected;
+	for (auto i = 0; i < 100000; ++i) {
+		expected.insert(i * 3);
+	}
+	const btree_set<int> set_under_test(expected);
+	expect_same_keys(expected, set_under_test);
+	EXPECT_TRUE(set_under_test.contains(2997));
+	EXPECT_FALSE(set_under_test.contains(2998));
+}
+
+TEST(BtreeSetTest, RandomInsertRemove)
+{
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 5000);
+	std::set<int> expected;
+	btree_set<int> set_under_test;
+	for (auto i = 0; i < 40000; ++i) {
+		const auto key = distribution(generator);
+		if (i % 3 == 2) {
+			expected.erase(key);
+			set_under_test.remove(key);
+		} else {
+			expected.insert(key);
+			set_under_test.insert(key);
+		}
+	}
+	expect_same_keys(expected, set_under_test);
+	for (auto key = 0; key <= 5000; ++key) {
+		EXPECT_EQ(expected.count(key) != 0, set_under_test.contains(key));
+	}
+
+	for (auto key = 0; key <= 5000; key += 2) {
+		expected.erase(key);
+		set_under_test.remove(key);
+	}
+	expect_same_keys(expected, set_under_test);
+
+	for (auto key = 0; key <= 5000; ++key) {
+		set_under_test.remove(key);
+	}
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_TRUE(set_under_test.begin() == set_under_test.end());
+}
+
+TEST(BtreeSetTest, RandomInsertRemoveCustomType)
+{
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<int> distribution(0, 500);
+	std::set<person, person_comparator> expected;
+	btree_set<person, person_comparator> set_under_test;
+	for (auto i = 0; i < 5000; ++i) {
+		const auto p = person(distribution(generator), "name" + std::to_string(i % 7));
+		if (i % 4 == 3) {
+			expected.erase(p);
+			set_under_test.remove(p);
+		} else {
+			expected.insert(p);
+			set_under_test.insert(p);
+		}
+	}
+	expect_same_keys(expected, set_under_test);
+}
+
+TEST(BtreeSetTest, CopyAndMove)
+{
+	btree_set<int> original({1, 2, 3});
+	auto copy(original);
+	copy.insert(4);
+	EXPECT_EQ(3, original.size());
+	EXPECT_EQ(4, copy.size());
+
+	auto moved(std::move(copy));
+	EXPECT_EQ(btree_set<int>({1, 2, 3, 4}), moved);
+
+	original = moved;
+	EXPECT_EQ(moved, original);
+}
+
+TEST(BtreeSetTest, Difference)
+{
+	const btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+	const btree_set<int> set2({2, 5, 7, 10, 15, 17});
+	EXPECT_EQ(btree_set<int>({1, 3, 8}), set1.difference_with(set2));
+	EXPECT_EQ(btree_set<int>({1, 3, 8}), set1.difference_with(std::set<int>({2, 5, 7, 10, 15, 17})));
+}
+
+TEST(BtreeSetTest, Union)
+{
+	const btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+	const btree_set<int> set2({2, 5, 7, 10, 15, 17});
+	EXPECT_EQ(btree_set<int>({1, 2, 3, 5, 7, 8, 10, 15, 17}), set1.union_with(set2));
+}
+
+TEST(BtreeSetTest, Intersection)
+{
+	const btree_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+	const btree_set<int> set2({2, 5, 7, 10, 15, 17});
+	EXPECT_EQ(btree_set<int>({2, 5, 7, 10}), set1.intersect_with(set2));
+}
+
+TEST(BtreeSetTest, MinMax)
+{
+	const btree_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+	EXPECT_EQ(1, numbers.min().value());
+	EXPECT_EQ(8, numbers.max().value());
+}
+
+TEST(BtreeSetTest, Map)
+{
+	const btree_set<int> numbers({1, 3, -5});
+	const auto mapped = numbers.map<std::string>([](const int& number) {
+		return std::to_string(number);
+	});
+	EXPECT_EQ(btree_set<std::string>({"-5", "1", "3"}), mapped);
+}
+
+TEST(BtreeSetTest, AllAnyNone)
+{
+	const btree_set<int> numbers({1, 4, 2, 5, 8, 3});
+	EXPECT_TRUE(numbers.all_of([](const int& number) { return number < 10; }));
+	EXPECT_TRUE(numbers.any_of([](const int& number) { return number == 5; }));
+	EXPECT_TRUE(numbers.none_of([](const int& number) { return number > 10; }));
+}
+
+TEST(BtreeSetTest, Reduce)
+{
+	const btree_set<std::string> tokens({"the", "quick", "brown", "fox"});
+	const auto sentence = tokens.reduce<std::string>("", [](const std::string& partial, const std::string& token) {
+		return partial.length() != 0
+			? partial + " " + token
+			: token;
+	});
+	EXPECT_EQ("brown fox quick the", sentence);
+}
+
+TEST(BtreeSetTest, Filter)
+{
+	btree_set<int> numbers({1, 3, -5, 2, -1, 9, -4});
+	const auto filtered_numbers = numbers.filtered([](const int& number) {
+		return number >= 2;
+	});
+	EXPECT_EQ(btree_set<int>({2, 3, 9}), filtered_numbers);
+	EXPECT_EQ(7, numbers.size());
+
+	numbers.filter([](const int& number) {
+		return number < 0;
+	});
+	EXPECT_EQ(btree_set<int>({-5, -4, -1}), numbers);
+}
+
+TEST(BtreeSetTest, Zip)
+{
+	const btree_set<int> ages({25, 45, 30, 63});
+	const btree_set<std::string> names({"Jake", "Bob", "Michael", "Philipp"});
+	const auto zipped = ages.zip(names);
+	const auto expected = btree_set<std::pair<int, std::string>>({
+		std::pair<int, std::string>(25, "Bob"),
+		std::pair<int, std::string>(30, "Jake"),
+		std::pair<int, std::string>(45, "Michael"),
+		std::pair<int, std::string>(63, "Philipp"),
+	});
+	EXPECT_EQ(expected, zipped);
+}
+
+TEST(BtreeSetTest, InsertingRemoving)
+{
+	const btree_set<int> numbers({1, 4, 2});
+	EXPECT_EQ(btree_set<int>({1, 2, 4, 18}), numbers.inserting(18));
+	EXPECT_EQ(btree_set<int>({1, 2}), numbers.removing(4));
+	EXPECT_EQ(btree_set<int>({1, 2, 4}), numbers);
+	EXPECT_TRUE(numbers.clearing().is_empty());
+}
+
+TEST(BtreeSetTest, InsertBatch)
+{
+	btree_set<int> numbers({1, 4, 2});
+	numbers.insert(vector<int>({18, 3, 4, 7}));
+	EXPECT_EQ(btree_set<int>({1, 2, 3, 4, 7, 18}), numbers);
+	EXPECT_EQ(std::vector<bool>({true, false, true}), numbers.contains_all(std::vector<int>({4, 15, 1})));
+}
+
+TEST(BtreeSetTest, KeysAndForEach)
+{
+	const btree_set<int> numbers({3, 1, 2});
+	EXPECT_EQ(vector<int>({1, 2, 3}), numbers.keys());
+	auto sum = 0;
+	numbers.for_each([&sum](const int& number) { sum += number; });
+	EXPECT_EQ(6, sum);
+}
+
+TEST(BtreeSetTest, Freeze)
+{
+	const btree_set<int> numbers({3, 1, 2});
+	const auto frozen_numbers = numbers.freeze();
+	EXPECT_TRUE(frozen_numbers.contains(2));
+	EXPECT_FALSE(frozen_numbers.contains(4));
+}
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "warnings.h"
+#include "concurrent_set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+TEST(ConcurrentSetTest, EmptyConstructor)
+{
+	const concurrent_set<int> set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_LT(0, set_under_test.shard_count());
+}
+
+TEST(ConcurrentSetTest, InsertIfAbsent)
+{
+	concurrent_set<std::string> set_under_test;
+	EXPECT_TRUE(set_under_test.insert_if_absent("one"));
+	EXPECT_FALSE(set_under_test.insert_if_absent("one"));
+	EXPECT_TRUE(set_under_test.insert_if_absent(std::string("two")));
+	EXPECT_EQ(2, set_under_test.size());
+}
+
+TEST(ConcurrentSetTest, InsertContainsRemove)
+{
+	concurrent_set<int> set_under_test;
+	set_under_test.insert(18).insert(7).insert(18);
+	EXPECT_EQ(2, set_under_test.size());
+	EXPECT_TRUE(set_under_test.contains(18));
+	set_under_test.remove(18).remove(3);
+	EXPECT_FALSE(set_under_test.contains(18));
+	EXPECT_TRUE(set_under_test.contains(7));
+	EXPECT_FALSE(set_under_test.is_empty());
+}
+
+TEST(ConcurrentSetTest, Clear)
+{
+	concurrent_set<int> set_under_test;
+	set_under_test.insert(1).insert(2).clear();
+	EXPECT_TRUE(set_under_test.is_empty());
+}
+
+TEST(ConcurrentSetTest, SingleShard)
+{
+	concurrent_set<int> set_under_test(0);
+	EXPECT_EQ(1, set_under_test.shard_count());
+	set_under_test.insert(5).insert(6);
+	EXPECT_EQ(set<int>({5, 6}), set_under_test.snapshot());
+}
+
+TEST(ConcurrentSetTest, Snapshot)
+{
+	concurrent_set<int> set_under_test(16);
+	for (auto i = 0; i < 100; ++i) {
+		set_under_test.insert(i % 10);
+	}
+	const auto snapshot = set_under_test.snapshot();
+	EXPECT_EQ(set<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), snapshot);
+	const auto odd_numbers = set_under_test.snapshot().filtered([](const int& number) {
+		return number % 2 == 1;
+	});
+	EXPECT_EQ(set<int>({1, 3, 5, 7, 9}), odd_numbers);
+}
+
+TEST(ConcurrentSetTest, CustomHash)
+{
+	concurrent_set<person, person_hash> set_under_test;
+	set_under_test.insert(person(51, "George")).insert(person(81, "Jackie"));
+	EXPECT_FALSE(set_under_test.insert_if_absent(person(51, "George")));
+	const auto snapshot = set_under_test.snapshot<person_comparator>();
+	EXPECT_EQ(2, snapshot.size());
+	EXPECT_TRUE(snapshot.contains(person(81, "Jackie")));
+}
+
+TEST(ConcurrentSetTest, ForEach)
+{
+	concurrent_set<int> set_under_test;
+	set_under_test.insert(1).insert(2).insert(3);
+	auto sum = 0;
+	set_under_test.for_each([&sum](const int& key) {
+		sum += key;
+	});
+	EXPECT_EQ(6, sum);
+}
+
+TEST(ConcurrentSetTest, ConcurrentDeduplication)
+{
+	concurrent_set<int> set_under_test;
+	std::atomic<int> new_keys(0);
+	std::vector<std::thread> threads;
+	for (auto t = 0; t < 8; ++t) {
+		threads.emplace_back([&set_under_test, &new_keys, t]() {
+			// every key is inserted by two threads
+			for (auto i = 0; i < 10000; ++i) {
+				if (set_under_test.insert_if_absent((t / 2) * 10000 + i)) {
+					++new_keys;
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(40000, new_keys.load());
+	EXPECT_EQ(40000, set_under_test.size());
+	EXPECT_TRUE(set_under_test.contains(39999));
+}
@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "warnings.h"
+#include "concurrent_vector.h"
+
+using namespace fcpp;
+
+TEST(ConcurrentVectorTest, EmptyConstructor)
+{
+	const concurrent_vector<int> vector_under_test;
+	EXPECT_EQ(0, vector_under_test.size());
+	EXPECT_TRUE(vector_under_test.is_empty());
+}
+
+TEST(ConcurrentVectorTest, PushBack)
+{
+	concurrent_vector<int> vector_under_test;
+	EXPECT_EQ(0, vector_under_test.push_back(5));
+	EXPECT_EQ(1, vector_under_test.push_back(8));
+	EXPECT_EQ(2, vector_under_test.size());
+	EXPECT_EQ(5, vector_under_test[0]);
+	EXPECT_EQ(8, vector_under_test[1]);
+}
+
+TEST(ConcurrentVectorTest, ElementsDoNotMoveWhenGrowing)
+{
+	concurrent_vector<int> vector_under_test;
+	vector_under_test.push_back(3);
+	const int* first = &vector_under_test[0];
+	for (auto i = 0; i < 10000; ++i) {
+		vector_under_test.push_back(i);
+	}
+	EXPECT_EQ(first, &vector_under_test[0]);
+	EXPECT_EQ(3, *first);
+	EXPECT_EQ(9999, vector_under_test[10000]);
+}
+
+TEST(ConcurrentVectorTest, GrowBy)
+{
+	concurrent_vector<int> vector_under_test;
+	vector_under_test.push_back(7);
+	const auto range = vector_under_test.grow_by(3);
+	EXPECT_EQ(index_range::start_count(1, 3), range);
+	for (auto i = range.start; i <= range.end; ++i) {
+		vector_under_test[i] = i * 10;
+	}
+	EXPECT_EQ(vector<int>({7, 10, 20, 30}), vector_under_test.freeze());
+}
+
+TEST(ConcurrentVectorTest, GrowByAcrossSegments)
+{
+	concurrent_vector<std::string> vector_under_test;
+	vector_under_test.grow_by(10, "a");
+	const auto range = vector_under_test.grow_by(100, "b");
+	EXPECT_EQ(index_range::start_count(10, 100), range);
+	EXPECT_EQ(110, vector_under_test.size());
+	EXPECT_EQ("a", vector_under_test[9]);
+	EXPECT_EQ("b", vector_under_test[10]);
+	EXPECT_EQ("b", vector_under_test[109]);
+}
+
+TEST(ConcurrentVectorTest, GrowByZero)
+{
+	concurrent_vector<int> vector_under_test;
+	const auto range = vector_under_test.grow_by(0);
+	EXPECT_FALSE(range.is_valid);
+	EXPECT_TRUE(vector_under_test.is_empty());
+}
+
+TEST(ConcurrentVectorTest, ForEach)
+{
+	concurrent_vector<int> vector_under_test;
+	for (auto i = 0; i < 100; ++i) {
+		vector_under_test.push_back(i);
+	}
+	auto sum = 0;
+	auto previous = -1;
+	auto ordered = true;
+	vector_under_test.for_each([&](const int& element) {
+		sum += element;
+		ordered = ordered && element == previous + 1;
+		previous = element;
+	});
+	EXPECT_EQ(4950, sum);
+	EXPECT_TRUE(ordered);
+}
+
+TEST(ConcurrentVectorTest, FreezeMovesElements)
+{
+	concurrent_vector<std::unique_ptr<int>> vector_under_test;
+	vector_under_test.push_back(std::unique_ptr<int>(new int(4)));
+	vector_under_test.push_back(std::unique_ptr<int>(new int(2)));
+	const auto frozen = vector_under_test.freeze();
+	EXPECT_EQ(2, frozen.size());
+	EXPECT_EQ(4, *frozen[0]);
+	EXPECT_EQ(2, *frozen[1]);
+	EXPECT_TRUE(vector_under_test.is_empty());
+}
+
+TEST(ConcurrentVectorTest, Clear)
+{
+	concurrent_vector<std::string> vector_under_test;
+	vector_under_test.push_back("Jake");
+	vector_under_test.clear();
+	EXPECT_TRUE(vector_under_test.is_empty());
+	vector_under_test.push_back("Mary");
+	EXPECT_EQ("Mary", vector_under_test[0]);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentProducers)
+{
+	concurrent_vector<int> vector_under_test;
+	const auto producer_count = 8;
+	const auto elements_per_producer = 5000;
+	std::vector<std::thread> producers;
+	for (auto p = 0; p < producer_count; ++p) {
+		producers.emplace_back([&vector_under_test, p, elements_per_producer]() {
+			for (auto i = 0; i < elements_per_producer; ++i) {
+				if (i % 10 == 0) {
+					const auto range = vector_under_test.grow_by(2, p * elements_per_producer + i);
+					vector_under_test[range.end] = p * elements_per_producer + i + 1;
+					++i;
+				} else {
+					vector_under_test.push_back(p * elements_per_producer + i);
+				}
+			}
+		});
+	}
+	for (auto& producer : producers) {
+		producer.join();
+	}
+	EXPECT_EQ(producer_count * elements_per_producer, vector_under_test.size());
+	const auto sorted = vector_under_test.freeze().sorted(std::less<int>());
+	for (auto i = 0; i < producer_count * elements_per_producer; ++i) {
+		EXPECT_EQ(i, sorted[i]);
+	}
+}
@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include "warnings.h"
+#include "frozen_set.h"
+#include "set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+namespace {
+	struct constant_hash {
+		std::size_t operator() (const int&) const {
+			return 42;
+		}
+	};
+}
+
+TEST(FrozenSetTest, EmptySet)
+{
+	const frozen_set<int> set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_FALSE(set_under_test.contains(1));
+}
+
+TEST(FrozenSetTest, FreezeSet)
+{
+	const set<int> codes({200, 301, 404, 500});
+	const auto frozen_codes = codes.freeze();
+	EXPECT_EQ(4, frozen_codes.size());
+	EXPECT_TRUE(frozen_codes.contains(200));
+	EXPECT_TRUE(frozen_codes.contains(404));
+	EXPECT_FALSE(frozen_codes.contains(403));
+	EXPECT_FALSE(frozen_codes.contains(0));
+}
+
+TEST(FrozenSetTest, FreezeSetCustomType)
+{
+	const set<person, person_comparator> persons({
+		person(15, "Jake"),
+		person(18, "Jannet"),
+		person(25, "Kate"),
+		person(62, "Bob")
+	});
+	const auto frozen_persons = persons.freeze<person_hash>();
+	EXPECT_EQ(4, frozen_persons.size());
+	EXPECT_TRUE(frozen_persons.contains(person(25, "Kate")));
+	EXPECT_FALSE(frozen_persons.contains(person(26, "Kate")));
+}
+
+TEST(FrozenSetTest, RemovesDuplicates)
+{
+	const frozen_set<int> numbers({1, 4, 2, 4, 1});
+	EXPECT_EQ(3, numbers.size());
+}
+
+TEST(FrozenSetTest, LargeSet)
+{
+	std::vector<std::string> keys;
+	for (auto i = 0; i < 20000; ++i) {
+		keys.push_back("key" + std::to_string(i * 3));
+	}
+	const frozen_set<std::string> set_under_test(keys);
+	EXPECT_EQ(20000, set_under_test.size());
+	for (auto i = 0; i < 60000; ++i) {
+		EXPECT_EQ(i % 3 == 0, set_under_test.contains("key" + std::to_string(i)));
+	}
+}
+
+TEST(FrozenSetTest, CollidingHashes)
+{
+	const frozen_set<int, constant_hash> numbers({1, 4, 2, 4});
+	EXPECT_EQ(3, numbers.size());
+	EXPECT_TRUE(numbers.contains(1));
+	EXPECT_TRUE(numbers.contains(2));
+	EXPECT_TRUE(numbers.contains(4));
+	EXPECT_FALSE(numbers.contains(3));
+}
+
+TEST(FrozenSetTest, ReadApi)
+{
+	const auto numbers = set<int>({1, 4, 2, 5, 8, 3}).freeze();
+	EXPECT_TRUE(numbers.all_of([](const int& number) { return number < 10; }));
+	EXPECT_TRUE(numbers.any_of([](const int& number) { return number == 5; }));
+	EXPECT_TRUE(numbers.none_of([](const int& number) { return number > 10; }));
+	EXPECT_EQ(23, numbers.reduce(0, [](const int& partial, const int& number) {
+		return partial + number;
+	}));
+
+	auto count = 0;
+	numbers.for_each([&count](const int&) { ++count; });
+	EXPECT_EQ(6, count);
+	EXPECT_EQ(vector<int>({1, 2, 3, 4, 5, 8}), numbers.keys().sorted_ascending());
+}
+
+TEST(FrozenSetTest, IteratorSkipsUnusedSlots)
+{
+	std::vector<int> keys;
+	for (auto i = 0; i < 1000; ++i) {
+		keys.push_back(i * 7);
+	}
+	const frozen_set<int> set_under_test(keys);
+	const std::vector<int> iterated(set_under_test.begin(), set_under_test.end());
+	EXPECT_EQ(1000, iterated.size());
+	EXPECT_EQ(vector<int>(keys), vector<int>(iterated).sorted_ascending());
+}
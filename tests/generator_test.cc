@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "warnings.h"
+#include "generator.h"
+
+#ifdef CPP20_COROUTINES_AVAILABLE
+using namespace fcpp;
+
+namespace {
+	generator<int> count_to(int last)
+	{
+		for (auto i = 1; i <= last; ++i) {
+			co_yield i;
+		}
+	}
+
+	generator<int> mark_started(bool& started)
+	{
+		started = true;
+		co_yield 1;
+	}
+
+	generator<int> failing_after(int last)
+	{
+		for (auto i = 1; i <= last; ++i) {
+			co_yield i;
+		}
+		throw std::runtime_error("exhausted");
+	}
+}
+
+TEST(GeneratorTest, YieldsInOrder)
+{
+	std::vector<int> values;
+	for (const auto& value : count_to(4)) {
+		values.push_back(value);
+	}
+	EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), values);
+}
+
+TEST(GeneratorTest, Empty)
+{
+	auto numbers = count_to(0);
+	EXPECT_TRUE(numbers.begin() == numbers.end());
+}
+
+TEST(GeneratorTest, IsLazy)
+{
+	auto started = false;
+	auto numbers = mark_started(started);
+	EXPECT_FALSE(started);
+	EXPECT_EQ(1, *numbers.begin());
+	EXPECT_TRUE(started);
+}
+
+TEST(GeneratorTest, ExceptionIsRethrownToConsumer)
+{
+	auto numbers = failing_after(2);
+	auto it = numbers.begin();
+	EXPECT_EQ(1, *it);
+	++it;
+	EXPECT_EQ(2, *it);
+	EXPECT_THROW(++it, std::runtime_error);
+}
+
+TEST(GeneratorTest, Move)
+{
+	auto numbers = count_to(3);
+	auto moved = std::move(numbers);
+	auto it = moved.begin();
+	EXPECT_EQ(1, *it);
+}
+
+TEST(GeneratorTest, VectorMapGen)
+{
+	const vector<int> numbers({1, 3, -5});
+	std::vector<std::string> texts;
+	for (const auto& text : map_gen<std::string>(numbers, [](const int& number) {
+		return std::to_string(number);
+	})) {
+		texts.push_back(text);
+	}
+	EXPECT_EQ(std::vector<std::string>({"1", "3", "-5"}), texts);
+}
+
+TEST(GeneratorTest, VectorMapGenStopsEarly)
+{
+	const vector<int> numbers({1, 3, -5, 8});
+	auto transformed = 0;
+	for (const auto& number : map_gen<int>(numbers, [&transformed](const int& number) {
+		++transformed;
+		return number * 2;
+	})) {
+		if (number == 6) {
+			break;
+		}
+	}
+	EXPECT_EQ(2, transformed);
+}
+
+TEST(GeneratorTest, VectorFilterGen)
+{
+	const vector<int> numbers({1, 3, -5, 2, -1, 9, -4});
+	std::vector<int> kept;
+	for (const auto& number : filter_gen(numbers, [](const int& number) {
+		return number >= 1.5;
+	})) {
+		kept.push_back(number);
+	}
+	EXPECT_EQ(std::vector<int>({3, 2, 9}), kept);
+}
+
+TEST(GeneratorTest, VectorFilterGenYieldsReferences)
+{
+	const vector<std::string> names({"Jake", "Mary", "Jo"});
+	auto names_with_j = filter_gen(names, [](const std::string& name) {
+		return name[0] == 'J';
+	});
+	auto it = names_with_j.begin();
+	EXPECT_EQ(&names[0], &*it);
+	++it;
+	EXPECT_EQ(&names[2], &*it);
+}
+
+TEST(GeneratorTest, SetFilterGen)
+{
+	const set<int> numbers({1, 3, -5, 2, -1, 9, -4});
+	std::vector<int> kept;
+	for (const auto& number : filter_gen(numbers, [](const int& number) {
+		return number < 0;
+	})) {
+		kept.push_back(number);
+	}
+	EXPECT_EQ(std::vector<int>({-5, -4, -1}), kept);
+}
+
+TEST(GeneratorTest, GeneratorsOwnTemporarySources)
+{
+	auto texts = map_gen<std::string>(vector<int>({1, 3, -5}), [](const int& number) {
+		return std::to_string(number);
+	});
+	auto kept = filter_gen(vector<std::string>({"Jake", "Mary", "Jo"}), [](const std::string& name) {
+		return name[0] == 'J';
+	});
+	auto negatives = filter_gen(set<int>({1, -3, 2, -1}), [](const int& number) {
+		return number < 0;
+	});
+
+	// the temporaries have been moved into the generators
+	std::vector<std::string> pulled_texts;
+	for (const auto& text : texts) {
+		pulled_texts.push_back(text);
+	}
+	EXPECT_EQ(std::vector<std::string>({"1", "3", "-5"}), pulled_texts);
+
+	std::vector<std::string> pulled_names;
+	for (const auto& name : kept) {
+		pulled_names.push_back(name);
+	}
+	EXPECT_EQ(std::vector<std::string>({"Jake", "Jo"}), pulled_names);
+
+	std::vector<int> pulled_numbers;
+	for (const auto& number : negatives) {
+		pulled_numbers.push_back(number);
+	}
+	EXPECT_EQ(std::vector<int>({-3, -1}), pulled_numbers);
+}
+#endif
@@ -0,0 +1,192 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "warnings.h"
+#include "incremental.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+namespace {
+	vector<int> random_numbers(size_t count)
+	{
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<int> distribution(-1000, 1000);
+		std::vector<int> numbers;
+		for (size_t i = 0; i < count; ++i) {
+			numbers.push_back(distribution(generator));
+		}
+		return vector<int>(std::move(numbers));
+	}
+
+	template <typename Algorithm>
+	size_t step_until_done(Algorithm& algorithm, const incremental_budget& budget)
+	{
+		size_t steps = 0;
+		while (!algorithm.step(budget).is_done()) {
+			++steps;
+		}
+		return steps + 1;
+	}
+}
+
+TEST(IncrementalTest, MapInSteps)
+{
+	const vector<int> numbers({1, 3, -5});
+	auto squares = map_incremental<int>(numbers, [](const int& number) {
+		return number * number;
+	});
+	EXPECT_FALSE(squares.is_done());
+	const auto progress = squares.step(incremental_budget::elements(2));
+	EXPECT_EQ(2, progress.processed);
+	EXPECT_EQ(3, progress.total);
+	EXPECT_FALSE(progress.is_done());
+	EXPECT_TRUE(squares.step(incremental_budget::elements(2)).is_done());
+	EXPECT_EQ(vector<int>({1, 9, 25}), squares.result());
+}
+
+TEST(IncrementalTest, MapMatchesOneShot)
+{
+	const auto numbers = random_numbers(10000);
+	const auto to_string = [](const int& number) {
+		return std::to_string(number);
+	};
+	auto texts = map_incremental<std::string>(numbers, to_string);
+	EXPECT_EQ(100, step_until_done(texts, incremental_budget::elements(100)));
+	EXPECT_EQ(numbers.map<std::string>(to_string), texts.result());
+}
+
+TEST(IncrementalTest, FilteredMatchesOneShot)
+{
+	const auto numbers = random_numbers(5000);
+	const auto is_positive = [](const int& number) {
+		return number > 0;
+	};
+	auto positives = filtered_incremental(numbers, is_positive);
+	step_until_done(positives, incremental_budget::elements(333));
+	EXPECT_EQ(numbers.filtered(is_positive), positives.result());
+}
+
+TEST(IncrementalTest, ReduceMatchesOneShot)
+{
+	const auto numbers = random_numbers(5000);
+	const auto sum = [](const long long& partial_sum, const int& number) {
+		return partial_sum + number;
+	};
+	auto total = reduce_incremental(numbers, 0LL, sum);
+	step_until_done(total, incremental_budget::elements(7));
+	EXPECT_EQ(numbers.reduce(0LL, sum), total.result());
+}
+
+TEST(IncrementalTest, DistinctMatchesOneShot)
+{
+	const auto numbers = random_numbers(5000);
+	auto unique_numbers = distinct_incremental(numbers);
+	step_until_done(unique_numbers, incremental_budget::elements(100));
+	EXPECT_EQ(numbers.distinct(), unique_numbers.result());
+}
+
+TEST(IncrementalTest, SortedMatchesOneShot)
+{
+	for (const size_t count : {0, 1, 31, 32, 33, 64, 100, 1000, 4097}) {
+		const auto numbers = random_numbers(count);
+		for (const size_t budget : {1, 5, 32, 1000}) {
+			auto sorting = sorted_incremental(numbers, std::less<int>());
+			step_until_done(sorting, incremental_budget::elements(budget));
+			EXPECT_EQ(numbers.sorted(std::less<int>()), sorting.result());
+		}
+	}
+}
+
+TEST(IncrementalTest, SortedIsStable)
+{
+	const vector<person> persons({
+		person(45, "Jake"), person(34, "Bob"), person(45, "Anna"), person(34, "Zoe"), person(8, "Alice")
+	});
+	auto sorting = sorted_incremental(persons, [](const person& a, const person& b) {
+		return a.age < b.age;
+	});
+	step_until_done(sorting, incremental_budget::elements(1));
+	const auto sorted_persons = sorting.result();
+	const vector<std::string> names = sorted_persons.map<std::string>([](const person& p) {
+		return p.name;
+	});
+	EXPECT_EQ(vector<std::string>({"Alice", "Bob", "Zoe", "Jake", "Anna"}), names);
+}
+
+TEST(IncrementalTest, SortedProgress)
+{
+	const auto numbers = random_numbers(128);
+	auto sorting = sorted_incremental(numbers, std::less<int>());
+	// 128 copied elements, and 2 merge passes (32 -> 64 -> 128)
+	EXPECT_EQ(3 * 128, sorting.progress().total);
+	EXPECT_EQ(0.5, sorting.step(incremental_budget::elements(192)).fraction());
+}
+
+TEST(IncrementalTest, TimeBudget)
+{
+	const auto numbers = random_numbers(200000);
+	auto sorting = sorted_incremental(numbers, std::less<int>());
+	const auto steps = step_until_done(sorting, incremental_budget::time(std::chrono::microseconds(200)));
+	EXPECT_LT(1, steps);
+	EXPECT_EQ(numbers.sorted(std::less<int>()), sorting.result());
+}
+
+TEST(IncrementalTest, RunToCompletion)
+{
+	const vector<int> numbers({3, 1, 9, -4});
+	EXPECT_EQ(vector<int>({-4, 1, 3, 9}), sorted_incremental(numbers, std::less<int>()).run_to_completion());
+}
+
+TEST(IncrementalTest, TemporarySourcesAreOwned)
+{
+	auto squares = map_incremental<int>(vector<int>({1, 3, -5}), [](const int& number) {
+		return number * number;
+	});
+	auto positives = filtered_incremental(vector<int>({1, -3, 5}), [](const int& number) {
+		return number > 0;
+	});
+	auto total = reduce_incremental(vector<int>({1, 2, 3}), 0, [](const int& partial_sum, const int& number) {
+		return partial_sum + number;
+	});
+	auto unique_numbers = distinct_incremental(vector<int>({3, 1, 3}));
+	auto sorting = sorted_incremental(random_numbers(1000), std::less<int>());
+
+	// the temporaries are destroyed before the algorithms run
+	step_until_done(squares, incremental_budget::elements(1));
+	step_until_done(positives, incremental_budget::elements(1));
+	step_until_done(total, incremental_budget::elements(1));
+	step_until_done(unique_numbers, incremental_budget::elements(1));
+	step_until_done(sorting, incremental_budget::elements(100));
+	EXPECT_EQ(vector<int>({1, 9, 25}), squares.result());
+	EXPECT_EQ(vector<int>({1, 5}), positives.result());
+	EXPECT_EQ(6, total.result());
+	EXPECT_EQ(set<int>({1, 3}), unique_numbers.result());
+	EXPECT_EQ(random_numbers(1000).sorted(std::less<int>()), sorting.result());
+}
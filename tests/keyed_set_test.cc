@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <functional>
+#include "warnings.h"
+#include "keyed_set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+namespace {
+	int projection_count = 0;
+
+	struct counting_person_hash {
+		std::size_t operator() (const person& p) const {
+			++projection_count;
+			return p.hash();
+		}
+	};
+}
+
+TEST(KeyedSetTest, EmptyConstructor)
+{
+	const keyed_set<person, person_hash> set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+}
+
+TEST(KeyedSetTest, InitializerListConstructorRemovesDuplicateKeys)
+{
+	const keyed_set<person, person_hash> set_under_test({
+		person(15, "Jake"),
+		person(18, "Jannet"),
+		person(15, "Jake")
+	});
+	EXPECT_EQ(2, set_under_test.size());
+}
+
+TEST(KeyedSetTest, FunctionalVectorConstructor)
+{
+	const keyed_set<int, std::negate<int>> set_under_test(vector<int>({1, 5, 3, 3}));
+	EXPECT_EQ(vector<int>({5, 3, 1}), set_under_test.keys());
+}
+
+TEST(KeyedSetTest, ConstructorsWithStatefulKeyFunction)
+{
+	const int modulo = 10;
+	const std::function<int(const int&)> last_digit = [modulo](const int& n) { return n % modulo; };
+
+	const keyed_set<int, std::function<int(const int&)>> from_list({23, 41, 13, 5}, last_digit);
+	EXPECT_EQ(vector<int>({41, 23, 5}), from_list.keys());
+
+	const keyed_set<int, std::function<int(const int&)>> from_vector(vector<int>({23, 41, 13, 5}), last_digit);
+	EXPECT_EQ(vector<int>({41, 23, 5}), from_vector.keys());
+
+	const keyed_set<int, std::function<int(const int&)>> from_std_vector(std::vector<int>({23, 41, 13, 5}), last_digit);
+	EXPECT_EQ(vector<int>({41, 23, 5}), from_std_vector.keys());
+}
+
+TEST(KeyedSetTest, OrderedByProjectedKey)
+{
+	const keyed_set<person, person_hash> set_under_test({
+		person(15, "Jake"),
+		person(18, "Jannet"),
+		person(25, "Kate"),
+		person(62, "Bob")
+	});
+	const set<person, person_comparator> expected({
+		person(15, "Jake"),
+		person(18, "Jannet"),
+		person(25, "Kate"),
+		person(62, "Bob")
+	});
+	EXPECT_EQ(expected.keys(), set_under_test.keys());
+}
+
+TEST(KeyedSetTest, ProjectionComputedOncePerElement)
+{
+	projection_count = 0;
+	keyed_set<person, counting_person_hash> set_under_test;
+	set_under_test.insert(person(15, "Jake"))
+		.insert(person(18, "Jannet"))
+		.insert(person(25, "Kate"))
+		.insert(person(62, "Bob"))
+		.insert(person(51, "George"));
+	EXPECT_EQ(5, projection_count);
+
+	EXPECT_TRUE(set_under_test.contains(person(25, "Kate")));
+	EXPECT_FALSE(set_under_test.contains(person(26, "Kate")));
+	EXPECT_EQ(7, projection_count);
+
+	set_under_test.filter([](const person& p) { return p.age > 16; });
+	EXPECT_EQ(4, set_under_test.size());
+	EXPECT_EQ(7, projection_count);
+}
+
+TEST(KeyedSetTest, ContainsKey)
+{
+	const keyed_set<person, person_hash> set_under_test({person(15, "Jake")});
+	EXPECT_TRUE(set_under_test.contains_key(person(15, "Jake").hash()));
+	EXPECT_FALSE(set_under_test.contains_key(person(18, "Jannet").hash()));
+}
+
+TEST(KeyedSetTest, InsertExistingKeyKeepsFirstElement)
+{
+	keyed_set<std::string, std::size_t (*)(const std::string&)> set_under_test(
+		[](const std::string& s) { return s.size(); });
+	set_under_test.insert("abc").insert("xyz").insert("de");
+	EXPECT_EQ(2, set_under_test.size());
+	EXPECT_EQ("de", set_under_test[0]);
+	EXPECT_EQ("abc", set_under_test[1]);
+}
+
+TEST(KeyedSetTest, RemoveAndRemoving)
+{
+	keyed_set<person, person_hash> set_under_test({person(15, "Jake"), person(18, "Jannet")});
+	const auto smaller = set_under_test.removing(person(15, "Jake"));
+	EXPECT_EQ(1, smaller.size());
+	EXPECT_EQ(2, set_under_test.size());
+	set_under_test.remove(person(18, "Jannet")).remove(person(99, "Nobody"));
+	EXPECT_EQ(1, set_under_test.size());
+	EXPECT_TRUE(set_under_test.contains(person(15, "Jake")));
+}
+
+TEST(KeyedSetTest, Inserting)
+{
+	const keyed_set<person, person_hash> set_under_test({person(15, "Jake")});
+	const auto augmented = set_under_test.inserting(person(18, "Jannet"));
+	EXPECT_EQ(2, augmented.size());
+	EXPECT_EQ(1, set_under_test.size());
+}
+
+TEST(KeyedSetTest, SetAlgebra)
+{
+	const keyed_set<person, person_hash> set1({
+		person(51, "George"),
+		person(81, "Jackie"),
+		person(15, "Jake"),
+	});
+	const keyed_set<person, person_hash> set2({
+		person(51, "George"),
+		person(25, "Kate"),
+	});
+
+	typedef keyed_set<person, person_hash> person_set;
+	EXPECT_EQ(person_set({person(81, "Jackie"), person(15, "Jake")}), set1.difference_with(set2));
+	EXPECT_EQ(person_set({person(51, "George")}), set1.intersect_with(set2));
+
+	const person_set expected_union({
+		person(51, "George"),
+		person(81, "Jackie"),
+		person(15, "Jake"),
+		person(25, "Kate")
+	});
+	EXPECT_EQ(expected_union, set1.union_with(set2));
+}
+
+TEST(KeyedSetTest, MinMax)
+{
+	const keyed_set<int, std::negate<int>> numbers({1, 4, 2, 5, 8, 3});
+	EXPECT_EQ(8, numbers.min().value());
+	EXPECT_EQ(1, numbers.max().value());
+	EXPECT_FALSE((keyed_set<int, std::negate<int>>().min().has_value()));
+}
+
+TEST(KeyedSetTest, Map)
+{
+	const keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+	const auto names = persons.map<std::string>([](const person& p) {
+		return p.name;
+	});
+	EXPECT_EQ(set<std::string>({"Jake", "Jannet"}), names);
+}
+
+TEST(KeyedSetTest, AllAnyNoneOf)
+{
+	const keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+	EXPECT_TRUE(persons.all_of([](const person& p) { return p.age < 20; }));
+	EXPECT_TRUE(persons.any_of([](const person& p) { return p.age == 18; }));
+	EXPECT_TRUE(persons.none_of([](const person& p) { return p.age > 20; }));
+}
+
+TEST(KeyedSetTest, Reduce)
+{
+	const keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+	const auto total_age = persons.reduce(0, [](const int& partial, const person& p) {
+		return partial + p.age;
+	});
+	EXPECT_EQ(33, total_age);
+}
+
+TEST(KeyedSetTest, Filtered)
+{
+	const keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+	const auto adults = persons.filtered([](const person& p) { return p.age >= 18; });
+	EXPECT_EQ(1, adults.size());
+	EXPECT_EQ(2, persons.size());
+	EXPECT_TRUE(adults.contains(person(18, "Jannet")));
+}
+
+TEST(KeyedSetTest, Clear)
+{
+	keyed_set<person, person_hash> persons({person(15, "Jake"), person(18, "Jannet")});
+	EXPECT_EQ(0, persons.clearing().size());
+	persons.clear();
+	EXPECT_TRUE(persons.is_empty());
+}
@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include "warnings.h"
+#include "mapped_vector.h"
+
+using namespace fcpp;
+
+TEST(MappedVectorTest, EmptyConstructor)
+{
+	const mapped_vector<int> vector_under_test;
+	EXPECT_TRUE(vector_under_test.is_empty());
+	EXPECT_EQ(0, vector_under_test.size());
+	EXPECT_FALSE(vector_under_test.is_mapped());
+}
+
+TEST(MappedVectorTest, InsertBack)
+{
+	mapped_vector<int> vector_under_test(vector<int>({ 1, 4 }));
+	vector_under_test.insert_back(2).insert_back(vector<int>({ 5, 8 }));
+	EXPECT_EQ(vector<int>({ 1, 4, 2, 5, 8 }), vector_under_test.to_vector());
+	EXPECT_FALSE(vector_under_test.is_mapped());
+}
+
+TEST(MappedVectorTest, GrowsIntoMappedStorage)
+{
+	mapped_vector<long long> vector_under_test;
+	const long long count = 1000000;
+	for (long long i = 0; i < count; ++i) {
+		vector_under_test.insert_back(i * 3);
+	}
+	EXPECT_TRUE(vector_under_test.is_mapped());
+	EXPECT_EQ(count, vector_under_test.size());
+	EXPECT_LE(count, vector_under_test.capacity());
+	for (long long i = 0; i < count; ++i) {
+		ASSERT_EQ(i * 3, vector_under_test[i]);
+	}
+}
+
+TEST(MappedVectorTest, InsertBackOwnElement)
+{
+	mapped_vector<int> vector_under_test;
+	vector_under_test.insert_back(7);
+	for (int i = 0; i < 100000; ++i) {
+		vector_under_test.insert_back(vector_under_test[0]);
+	}
+	EXPECT_EQ(100001, vector_under_test.size());
+	EXPECT_EQ(7, vector_under_test[100000]);
+}
+
+TEST(MappedVectorTest, InsertBackVectorIntoMappedStorage)
+{
+	mapped_vector<int> vector_under_test(vector<int>({ 1, 4 }));
+	const vector<int> elements(1000000, 9);
+	vector_under_test.insert_back(elements);
+	EXPECT_TRUE(vector_under_test.is_mapped());
+	EXPECT_EQ(1000002, vector_under_test.size());
+	EXPECT_EQ(4, vector_under_test[1]);
+	EXPECT_EQ(9, vector_under_test[1000001]);
+}
+
+TEST(MappedVectorTest, ReserveAndResize)
+{
+	mapped_vector<double> vector_under_test;
+	vector_under_test.reserve(1 << 20);
+	EXPECT_TRUE(vector_under_test.is_mapped());
+	EXPECT_EQ(1 << 20, vector_under_test.capacity());
+	EXPECT_TRUE(vector_under_test.is_empty());
+	vector_under_test.insert_back(1.5).resize(3);
+	EXPECT_EQ(vector<double>({ 1.5, 0.0, 0.0 }), vector_under_test.to_vector());
+	vector_under_test.resize(1 << 21);
+	EXPECT_EQ(1.5, vector_under_test[0]);
+	EXPECT_EQ(0.0, vector_under_test[(1 << 21) - 1]);
+}
+
+TEST(MappedVectorTest, RemoveBackAndClear)
+{
+	mapped_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	vector_under_test.remove_back();
+	EXPECT_EQ(vector<int>({ 1, 4 }), vector_under_test.to_vector());
+	vector_under_test.clear().remove_back();
+	EXPECT_TRUE(vector_under_test.is_empty());
+}
+
+TEST(MappedVectorTest, NonTriviallyCopyableElements)
+{
+	mapped_vector<std::string> vector_under_test(vector<std::string>({ "a", "b" }));
+	for (int i = 0; i < 100000; ++i) {
+		vector_under_test.insert_back(std::to_string(i));
+	}
+	EXPECT_FALSE(vector_under_test.is_mapped());
+	EXPECT_EQ(100002, vector_under_test.size());
+	EXPECT_EQ("a", vector_under_test[0]);
+	EXPECT_EQ("99999", vector_under_test[100001]);
+}
+
+TEST(MappedVectorTest, Iteration)
+{
+	mapped_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	int sum = 0;
+	for (const auto& element : vector_under_test) {
+		sum += element;
+	}
+	EXPECT_EQ(7, sum);
+}
+
+TEST(MappedVectorTest, AlgorithmsRunOnTheBuffer)
+{
+	mapped_vector<int> vector_under_test;
+	for (int i = 0; i < 500000; ++i) {
+		vector_under_test.insert_back(i % 10);
+	}
+	EXPECT_TRUE(vector_under_test.is_mapped());
+	EXPECT_EQ(2250000LL, vector_under_test.reduce(0LL, [](const long long& partial, const int& element) {
+		return partial + element;
+	}));
+	const auto doubled = vector_under_test.map<int>([](const int& element) {
+		return element * 2;
+	});
+	EXPECT_EQ(500000, doubled.size());
+	EXPECT_EQ(18, doubled[499999]);
+	int nines = 0;
+	vector_under_test.for_each([&nines](const int& element) {
+		nines += element == 9 ? 1 : 0;
+	});
+	EXPECT_EQ(50000, nines);
+}
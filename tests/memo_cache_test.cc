@@ -0,0 +1,219 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "warnings.h"
+#include "memo_cache.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+TEST(MemoCacheTest, EmptyConstructor)
+{
+	const memo_cache<int, std::string> cache(64, 4);
+	EXPECT_EQ(0, cache.size());
+	EXPECT_EQ(64, cache.capacity());
+	EXPECT_EQ(0, cache.hits());
+	EXPECT_EQ(0, cache.misses());
+}
+
+TEST(MemoCacheTest, CapacityRoundedUpToShards)
+{
+	const memo_cache<int, int> cache(10, 4);
+	EXPECT_EQ(12, cache.capacity());
+}
+
+TEST(MemoCacheTest, InsertAndFind)
+{
+	memo_cache<int, std::string> cache(64);
+	cache.insert(1, "one").insert(2, "two");
+	EXPECT_EQ(2, cache.size());
+	EXPECT_EQ("one", cache.find(1).value());
+	EXPECT_EQ("two", cache.find(2).value());
+	EXPECT_FALSE(cache.find(3).has_value());
+	EXPECT_EQ(2, cache.hits());
+	EXPECT_EQ(1, cache.misses());
+}
+
+TEST(MemoCacheTest, InsertKeepsExistingValue)
+{
+	memo_cache<int, std::string> cache(64);
+	cache.insert(1, "one").insert(1, "uno");
+	EXPECT_EQ(1, cache.size());
+	EXPECT_EQ("one", cache.find(1).value());
+}
+
+TEST(MemoCacheTest, EvictsLeastRecentlyUsed)
+{
+	memo_cache<int, int> cache(2, 1);
+	cache.insert(1, 10).insert(2, 20);
+	EXPECT_TRUE(cache.find(1).has_value());
+	cache.insert(3, 30);
+	EXPECT_EQ(2, cache.size());
+	EXPECT_TRUE(cache.find(1).has_value());
+	EXPECT_FALSE(cache.find(2).has_value());
+	EXPECT_TRUE(cache.find(3).has_value());
+}
+
+TEST(MemoCacheTest, GetOrCompute)
+{
+	memo_cache<std::string, int> cache(64);
+	int calls = 0;
+	const auto length = [&calls](const std::string& text) {
+		++calls;
+		return static_cast<int>(text.size());
+	};
+	EXPECT_EQ(5, cache.get_or_compute("hello", length));
+	EXPECT_EQ(5, cache.get_or_compute("hello", length));
+	EXPECT_EQ(2, cache.get_or_compute("hi", length));
+	EXPECT_EQ(2, calls);
+	EXPECT_EQ(1, cache.hits());
+	EXPECT_EQ(2, cache.misses());
+}
+
+TEST(MemoCacheTest, CustomHash)
+{
+	memo_cache<person, int, person_hash> cache(64);
+	cache.insert(person(15, "Jake"), 1);
+	EXPECT_EQ(1, cache.find(person(15, "Jake")).value());
+	EXPECT_FALSE(cache.find(person(16, "Jake")).has_value());
+}
+
+TEST(MemoCacheTest, Clear)
+{
+	memo_cache<int, int> cache(64);
+	cache.insert(1, 1).insert(2, 4);
+	EXPECT_TRUE(cache.find(1).has_value());
+	cache.clear();
+	EXPECT_EQ(0, cache.size());
+	EXPECT_FALSE(cache.find(1).has_value());
+	EXPECT_EQ(1, cache.hits());
+}
+
+TEST(MemoCacheTest, ConcurrentGetOrCompute)
+{
+	memo_cache<int, int> cache(1000);
+	std::atomic<int> calls(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.push_back(std::thread([&cache, &calls]() {
+			for (int i = 0; i < 10000; ++i) {
+				const auto key = i % 100;
+				const auto value = cache.get_or_compute(key, [&calls](const int& x) {
+					++calls;
+					return x * x;
+				});
+				EXPECT_EQ(key * key, value);
+			}
+		}));
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(100, cache.size());
+	EXPECT_LE(100, calls.load());
+	EXPECT_GE(400, calls.load());
+	EXPECT_EQ(40000, cache.hits() + cache.misses());
+}
+
+TEST(MemoCacheTest, MapMemoized)
+{
+	const vector<int> vector_under_test({1, 3, 1, 4, 3, 1});
+	int calls = 0;
+	const auto mapped_vector = map_memoized<child>(vector_under_test, [&calls](const int& age){
+		++calls;
+		return child(age);
+	});
+	EXPECT_EQ(3, calls);
+	EXPECT_EQ(6, mapped_vector.size());
+	EXPECT_EQ(1, mapped_vector[0].age);
+	EXPECT_EQ(3, mapped_vector[1].age);
+	EXPECT_EQ(1, mapped_vector[2].age);
+	EXPECT_EQ(4, mapped_vector[3].age);
+	EXPECT_EQ(3, mapped_vector[4].age);
+	EXPECT_EQ(1, mapped_vector[5].age);
+}
+
+TEST(MemoCacheTest, MapMemoizedCustomHash)
+{
+	const vector<person> vector_under_test({person(15, "Jake"), person(18, "Jannet"), person(15, "Jake")});
+	int calls = 0;
+	const auto mapped_vector = map_memoized<std::string, person_hash>(vector_under_test, [&calls](const person& p){
+		++calls;
+		return p.name;
+	});
+	EXPECT_EQ(2, calls);
+	EXPECT_EQ(vector<std::string>({"Jake", "Jannet", "Jake"}), mapped_vector);
+}
+
+TEST(MemoCacheTest, MapMemoizedWithCache)
+{
+	memo_cache<int, int> cache(100);
+	int calls = 0;
+	const auto square = [&calls](const int& x){
+		++calls;
+		return x * x;
+	};
+	const auto first = map_memoized(vector<int>({2, 3, 2}), square, cache);
+	const auto second = map_memoized(vector<int>({3, 4, 2}), square, cache);
+	EXPECT_EQ(vector<int>({4, 9, 4}), first);
+	EXPECT_EQ(vector<int>({9, 16, 4}), second);
+	EXPECT_EQ(3, calls);
+	EXPECT_EQ(3, cache.size());
+}
+
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(MemoCacheTest, MapMemoizedParallel)
+{
+	std::vector<int> values;
+	for (int i = 0; i < 10000; ++i) {
+		values.push_back(i % 10);
+	}
+	const vector<int> vector_under_test(values);
+	std::atomic<int> calls(0);
+	const auto mapped_vector = map_memoized_parallel<int>(vector_under_test, [&calls](const int& x){
+		++calls;
+		return x * 2;
+	});
+	EXPECT_EQ(10000, mapped_vector.size());
+	for (int i = 0; i < 10000; ++i) {
+		EXPECT_EQ((i % 10) * 2, mapped_vector[i]);
+	}
+	EXPECT_LE(10, calls.load());
+	EXPECT_GT(1000, calls.load());
+}
+
+TEST(MemoCacheTest, MapMemoizedParallelWithCache)
+{
+	memo_cache<int, int> cache(100);
+	const auto mapped_vector = map_memoized_parallel(vector<int>({1, 2, 1, 2, 5}), [](const int& x){
+		return x + 1;
+	}, cache);
+	EXPECT_EQ(vector<int>({2, 3, 2, 3, 6}), mapped_vector);
+	EXPECT_EQ(3, cache.size());
+}
+#endif
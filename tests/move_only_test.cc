@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include "warnings.h"
+#include "vector.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+typedef std::unique_ptr<int> int_pointer;
+
+static vector<int_pointer> make_pointers(std::initializer_list<int> values)
+{
+	vector<int_pointer> pointers;
+	for (const auto value : values) {
+		pointers.emplace_back(new int(value));
+	}
+	return pointers;
+}
+
+static vector<int> values_of(const vector<int_pointer>& pointers)
+{
+	return pointers.map<int>([](const int_pointer& pointer) {
+		return *pointer;
+	});
+}
+
+TEST(MoveOnlyTest, EmplaceBack)
+{
+	vector<int_pointer> vector_under_test;
+	vector_under_test.emplace_back(new int(1)).emplace_back(new int(4));
+	EXPECT_EQ(vector<int>({ 1, 4 }), values_of(vector_under_test));
+}
+
+TEST(MoveOnlyTest, EmplaceAt)
+{
+	auto vector_under_test = make_pointers({ 1, 4, 2 });
+	vector_under_test.emplace_at(1, new int(7)).emplace_at(4, new int(9)).emplace_at(0, new int(0));
+	EXPECT_EQ(vector<int>({ 0, 1, 7, 4, 2, 9 }), values_of(vector_under_test));
+}
+
+TEST(MoveOnlyTest, EmplaceAtNonRelocatable)
+{
+	vector<person> vector_under_test({ person(15, "Jake") });
+	vector_under_test.emplace_at(0, 18, "Jannet").emplace_back(20, "Kate");
+	EXPECT_EQ(vector<person>({ person(18, "Jannet"), person(15, "Jake"), person(20, "Kate") }), vector_under_test);
+}
+
+TEST(MoveOnlyTest, InsertByMoving)
+{
+	vector<int_pointer> vector_under_test;
+	vector_under_test.insert_back(int_pointer(new int(1)))
+		.insert_front(int_pointer(new int(0)))
+		.insert_at(1, int_pointer(new int(5)));
+	EXPECT_EQ(vector<int>({ 0, 5, 1 }), values_of(vector_under_test));
+}
+
+TEST(MoveOnlyTest, InsertVectorByMoving)
+{
+	vector<int_pointer> vector_under_test;
+	auto source = make_pointers({ 1, 4 });
+	vector_under_test.insert_back(std::move(source));
+	EXPECT_TRUE(source.is_empty());
+	vector_under_test.insert_back(make_pointers({ 2, 5 }))
+		.insert_front(make_pointers({ 8 }))
+		.insert_at(2, make_pointers({ 3, 3 }));
+	EXPECT_EQ(vector<int>({ 8, 1, 3, 3, 4, 2, 5 }), values_of(vector_under_test));
+}
+
+TEST(MoveOnlyTest, InsertVectorByMovingCopyableElements)
+{
+	vector<std::string> vector_under_test({ "a" });
+	vector<std::string> source({ "b", "c" });
+	vector_under_test.insert_back(std::move(source));
+	EXPECT_EQ(vector<std::string>({ "a", "b", "c" }), vector_under_test);
+	EXPECT_TRUE(source.is_empty());
+}
+
+TEST(MoveOnlyTest, Filtered)
+{
+	const auto filtered_vector = make_pointers({ 1, 4, 2, 5 }).filtered([](const int_pointer& pointer) {
+		return *pointer % 2 == 0;
+	});
+	EXPECT_EQ(vector<int>({ 4, 2 }), values_of(filtered_vector));
+}
+
+TEST(MoveOnlyTest, Sorted)
+{
+	const auto sorted_vector = make_pointers({ 3, 1, 9, -4 }).sorted([](const int_pointer& a, const int_pointer& b) {
+		return *a < *b;
+	});
+	EXPECT_EQ(vector<int>({ -4, 1, 3, 9 }), values_of(sorted_vector));
+}
+
+TEST(MoveOnlyTest, Reversed)
+{
+	EXPECT_EQ(vector<int>({ 2, 4, 1 }), values_of(make_pointers({ 1, 4, 2 }).reversed()));
+}
+
+TEST(MoveOnlyTest, Zip)
+{
+	const auto zipped_vector = make_pointers({ 1, 4 }).zip(vector<std::string>({ "one", "four" }));
+	EXPECT_EQ(2, zipped_vector.size());
+	EXPECT_EQ(4, *zipped_vector[1].first);
+	EXPECT_EQ("four", zipped_vector[1].second);
+}
+
+TEST(MoveOnlyTest, InsertingAndRemoving)
+{
+	const auto vector_under_test = make_pointers({ 1, 4, 2, 5 })
+		.inserting_back(int_pointer(new int(7)))
+		.inserting_front(int_pointer(new int(0)))
+		.inserting_back(make_pointers({ 8 }))
+		.removing_at(2)
+		.removing_front()
+		.removing_back()
+		.removing_range(index_range::start_count(1, 2));
+	EXPECT_EQ(vector<int>({ 1, 7 }), values_of(vector_under_test));
+}
+
+TEST(MoveOnlyTest, RvalueAlgorithmsOnCopyableElements)
+{
+	const vector<int> numbers({ 3, 1, 9, -4 });
+	EXPECT_EQ(vector<int>({ -4, 1, 3, 9 }), vector<int>(numbers).sorted_ascending());
+	EXPECT_EQ(vector<int>({ 9, 3, 1, -4 }), vector<int>(numbers).sorted_descending());
+	EXPECT_EQ(vector<int>({ 3, 8, 7, -4 }), vector<int>(numbers).replacing_range_at(1, { 8, 7 }));
+	EXPECT_EQ(vector<int>({ 3, 1, 0, 9, -4 }), vector<int>(numbers).inserting_at(2, 0));
+	EXPECT_EQ(vector<int>({ 3, 1, 9, -4 }), numbers);
+}
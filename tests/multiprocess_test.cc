@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "warnings.h"
+#include "multiprocess.h"
+
+#ifdef MULTIPROCESS_AVAILABLE
+using namespace fcpp;
+
+TEST(MultiprocessTest, MapMultiprocess)
+{
+	std::vector<int> values;
+	for (int i = 0; i < 10000; ++i) {
+		values.push_back(i);
+	}
+	const vector<int> vector_under_test(values);
+	const auto mapped_vector = map_multiprocess<long long>(vector_under_test, [](const int& x){
+		return static_cast<long long>(x) * x;
+	}, 4);
+	EXPECT_EQ(10000, mapped_vector.size());
+	for (int i = 0; i < 10000; ++i) {
+		EXPECT_EQ(static_cast<long long>(i) * i, mapped_vector[i]);
+	}
+}
+
+TEST(MultiprocessTest, MapMultiprocessMoreProcessesThanElements)
+{
+	const vector<std::string> vector_under_test({"a", "bb", "ccc"});
+	const auto mapped_vector = map_multiprocess<size_t>(vector_under_test, [](const std::string& text){
+		return text.size();
+	}, 8);
+	EXPECT_EQ(vector<size_t>({1, 2, 3}), mapped_vector);
+}
+
+TEST(MultiprocessTest, MapMultiprocessEmpty)
+{
+	const vector<int> vector_under_test;
+	const auto mapped_vector = map_multiprocess<int>(vector_under_test, [](const int& x){
+		return x;
+	});
+	EXPECT_TRUE(mapped_vector.is_empty());
+}
+
+TEST(MultiprocessTest, MapMultiprocessFailingTransform)
+{
+	const vector<int> vector_under_test({1, 2, 3, 4});
+	EXPECT_THROW(map_multiprocess<int>(vector_under_test, [](const int& x){
+		if (x == 3) {
+			throw std::runtime_error("failed");
+		}
+		return x;
+	}, 2), multiprocess_error);
+}
+
+TEST(MultiprocessTest, ReduceMultiprocess)
+{
+	std::vector<int> values;
+	for (int i = 1; i <= 10000; ++i) {
+		values.push_back(i);
+	}
+	const vector<int> vector_under_test(values);
+	const auto sum = reduce_multiprocess(vector_under_test, 0LL, [](const long long& partial, const int& x){
+		return partial + x;
+	}, std::plus<long long>(), 3);
+	EXPECT_EQ(50005000LL, sum);
+}
+
+TEST(MultiprocessTest, ReduceMultiprocessEmpty)
+{
+	const vector<int> vector_under_test;
+	const auto sum = reduce_multiprocess(vector_under_test, 0, [](const int& partial, const int& x){
+		return partial + x;
+	}, std::plus<int>());
+	EXPECT_EQ(0, sum);
+}
+#endif
+
@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "warnings.h"
+#include "pipeline.h"
+
+using namespace fcpp;
+
+TEST(PipelineTest, WithoutStages)
+{
+	const vector<int> input({1, 2, 3});
+	const pipeline<int> pipeline_under_test;
+	EXPECT_EQ(0, pipeline_under_test.stage_count());
+	EXPECT_EQ(input, pipeline_under_test.run(input));
+}
+
+TEST(PipelineTest, EmptyInput)
+{
+	const auto output = pipeline<int>()
+		.map<int>([](const int& number) {
+			return number + 1;
+		})
+		.run(vector<int>());
+	EXPECT_TRUE(output.is_empty());
+}
+
+TEST(PipelineTest, MapAndFilter)
+{
+	const vector<std::string> lines({"4", "x", "15", "", "8"});
+	const auto pipeline_under_test = pipeline<std::string>()
+		.filter([](const std::string& line) {
+			return !line.empty() && std::isdigit(line[0]);
+		})
+		.map<int>([](const std::string& line) {
+			return std::stoi(line);
+		})
+		.map<int>([](const int& number) {
+			return number * 2;
+		});
+	EXPECT_EQ(3, pipeline_under_test.stage_count());
+	EXPECT_EQ(vector<int>({8, 30, 16}), pipeline_under_test.run(lines));
+}
+
+TEST(PipelineTest, PreservesOrderAcrossBatches)
+{
+	std::vector<int> numbers;
+	for (auto i = 0; i < 100000; ++i) {
+		numbers.push_back(i);
+	}
+	const auto output = pipeline<int>(64, 2)
+		.filter([](const int& number) {
+			return number % 3 != 0;
+		})
+		.map<long long>([](const int& number) {
+			return static_cast<long long>(number) * number;
+		})
+		.run(vector<int>(numbers));
+	std::vector<long long> expected;
+	for (const auto& number : numbers) {
+		if (number % 3 != 0) {
+			expected.push_back(static_cast<long long>(number) * number);
+		}
+	}
+	EXPECT_EQ(vector<long long>(expected), output);
+}
+
+TEST(PipelineTest, RunReduce)
+{
+	const vector<int> numbers({1, 2, 3, 4});
+	const auto sum_of_squares = pipeline<int>(1)
+		.map<int>([](const int& number) {
+			return number * number;
+		})
+		.run_reduce(numbers, 0, [](const int& partial_sum, const int& number) {
+			return partial_sum + number;
+		});
+	EXPECT_EQ(30, sum_of_squares);
+}
+
+TEST(PipelineTest, Statistics)
+{
+	std::vector<int> numbers(1000, 1);
+	std::vector<pipeline_stage_statistics> statistics;
+	const auto output = pipeline<int>(100)
+		.filter([](const int& number) {
+			return number > 0;
+		})
+		.map<int>([](const int& number) {
+			return number * 3;
+		})
+		.run(vector<int>(numbers), statistics);
+	EXPECT_EQ(1000, output.size());
+	EXPECT_EQ(2, statistics.size());
+	EXPECT_EQ(10, statistics[0].batches);
+	EXPECT_EQ(1000, statistics[0].input_elements);
+	EXPECT_EQ(1000, statistics[0].output_elements);
+	EXPECT_EQ(10, statistics[1].batches);
+	EXPECT_EQ(1000, statistics[1].output_elements);
+}
+
+TEST(PipelineTest, FilteredOutBatchesAreNotPassedOn)
+{
+	std::vector<pipeline_stage_statistics> statistics;
+	const auto output = pipeline<int>(10)
+		.filter([](const int& number) {
+			return number > 5;
+		})
+		.map<int>([](const int& number) {
+			return number;
+		})
+		.run(vector<int>(100, 1), statistics);
+	EXPECT_TRUE(output.is_empty());
+	EXPECT_EQ(0, statistics[0].output_elements);
+	EXPECT_EQ(0, statistics[1].batches);
+}
+
+TEST(PipelineTest, StageExceptionIsRethrown)
+{
+	const auto pipeline_under_test = pipeline<int>(4, 1)
+		.map<int>([](const int& number) {
+			if (number == 500) {
+				throw std::runtime_error("invalid");
+			}
+			return number;
+		})
+		.map<int>([](const int& number) {
+			return number;
+		});
+	std::vector<int> numbers;
+	for (auto i = 0; i < 1000; ++i) {
+		numbers.push_back(i);
+	}
+	EXPECT_THROW(pipeline_under_test.run(vector<int>(numbers)), std::runtime_error);
+}
+
+TEST(PipelineTest, ReductionExceptionIsRethrown)
+{
+	EXPECT_THROW(pipeline<int>(1, 1)
+		.map<int>([](const int& number) {
+			return number;
+		})
+		.run_reduce(vector<int>(100, 1), 0, [](const int& sum, const int& number) -> int {
+			if (sum > 10) {
+				throw std::runtime_error("overflow");
+			}
+			return sum + number;
+		}), std::runtime_error);
+}
@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "warnings.h"
+#include "published.h"
+#include "vector.h"
+
+using namespace fcpp;
+
+namespace {
+	std::atomic<int> live_counters(0);
+
+	struct counted
+	{
+		explicit counted(int value)
+			: value(value)
+		{
+			++live_counters;
+		}
+
+		counted(const counted& other)
+			: value(other.value)
+		{
+			++live_counters;
+		}
+
+		~counted()
+		{
+			--live_counters;
+		}
+
+		int value;
+	};
+}
+
+TEST(PublishedTest, Snapshot)
+{
+	const published<vector<int>> published_under_test(vector<int>({10, 20}));
+	const auto snapshot = published_under_test.snapshot();
+	EXPECT_EQ(vector<int>({10, 20}), *snapshot);
+	EXPECT_TRUE(snapshot->find_first_index(20).has_value());
+	EXPECT_EQ(0, published_under_test.version());
+}
+
+TEST(PublishedTest, Publish)
+{
+	published<vector<int>> published_under_test(vector<int>({10, 20}));
+	published_under_test.publish(vector<int>({5}));
+	EXPECT_EQ(vector<int>({5}), published_under_test.snapshot().get());
+	EXPECT_EQ(1, published_under_test.version());
+}
+
+TEST(PublishedTest, Update)
+{
+	published<vector<int>> published_under_test(vector<int>({1, 2, 3}));
+	published_under_test.update([](vector<int>& values) {
+		values.insert_back(4);
+	}).update([](vector<int>& values) {
+		values.insert_back(5);
+	});
+	EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), published_under_test.snapshot().get());
+}
+
+TEST(PublishedTest, Read)
+{
+	const published<vector<int>> published_under_test(vector<int>({1, 2, 3}));
+	const auto size = published_under_test.read([](const vector<int>& values) {
+		return values.size();
+	});
+	EXPECT_EQ(3, size);
+}
+
+TEST(PublishedTest, SnapshotIsIsolatedFromPublications)
+{
+	published<vector<int>> published_under_test(vector<int>({1}));
+	const auto old_snapshot = published_under_test.snapshot();
+	published_under_test.publish(vector<int>({2}));
+	EXPECT_EQ(vector<int>({1}), *old_snapshot);
+	EXPECT_EQ(vector<int>({2}), *published_under_test.snapshot());
+}
+
+TEST(PublishedTest, ReclaimsOldVersions)
+{
+	{
+		published<counted> published_under_test(counted(0));
+		for (auto i = 1; i <= 100; ++i) {
+			published_under_test.publish(counted(i));
+			// the current and at most one retired version are alive
+			EXPECT_GE(2, live_counters.load());
+		}
+		EXPECT_EQ(100, published_under_test.snapshot()->value);
+	}
+	EXPECT_EQ(0, live_counters.load());
+}
+
+TEST(PublishedTest, ConcurrentReadersAndWriter)
+{
+	published<vector<int>> published_under_test(vector<int>(100, 0));
+	std::atomic<bool> done(false);
+	std::atomic<int> inconsistent_snapshots(0);
+	std::vector<std::thread> readers;
+	for (auto r = 0; r < 4; ++r) {
+		readers.emplace_back([&]() {
+			while (!done.load()) {
+				const auto snapshot = published_under_test.snapshot();
+				const auto first = (*snapshot)[0];
+				if (!snapshot->all_of([first](const int& value) { return value == first; })) {
+					++inconsistent_snapshots;
+				}
+			}
+		});
+	}
+	for (auto version = 1; version <= 200; ++version) {
+		published_under_test.publish(vector<int>(100, version));
+	}
+	done.store(true);
+	for (auto& reader : readers) {
+		reader.join();
+	}
+	EXPECT_EQ(0, inconsistent_snapshots.load());
+	EXPECT_EQ(vector<int>(100, 200), *published_under_test.snapshot());
+}
@@ -0,0 +1,206 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include "warnings.h"
+#include "vector.h"
+
+using namespace fcpp;
+
+// A handle which counts how often it is moved or copied, and is declared relocatable
+struct counted_handle
+{
+	counted_handle() noexcept
+		: id(0), resource(nullptr)
+	{
+	}
+
+	explicit counted_handle(int id)
+		: id(id), resource(new int(id))
+	{
+	}
+
+	counted_handle(const counted_handle& other)
+		: id(other.id), resource(other.resource ? new int(*other.resource) : nullptr)
+	{
+		++copies;
+	}
+
+	counted_handle(counted_handle&& other) noexcept
+		: id(other.id), resource(other.resource)
+	{
+		other.resource = nullptr;
+		++moves;
+	}
+
+	counted_handle& operator=(counted_handle other) noexcept
+	{
+		id = other.id;
+		std::swap(resource, other.resource);
+		++moves;
+		return *this;
+	}
+
+	~counted_handle()
+	{
+		delete resource;
+	}
+
+	bool operator==(const counted_handle& other) const
+	{
+		return id == other.id && (resource == nullptr) == (other.resource == nullptr) && (resource == nullptr || *resource == *other.resource);
+	}
+
+	int id;
+	int* resource;
+
+	static int copies;
+	static int moves;
+
+	static void reset_counters()
+	{
+		copies = 0;
+		moves = 0;
+	}
+};
+
+int counted_handle::copies = 0;
+int counted_handle::moves = 0;
+
+namespace fcpp {
+	template <>
+	struct is_trivially_relocatable<counted_handle> : std::true_type
+	{
+	};
+}
+
+static vector<counted_handle> make_handles(int count)
+{
+	vector<counted_handle> handles;
+	handles.reserve(count + 16);
+	for (int i = 0; i < count; ++i) {
+		handles.insert_back(counted_handle(i));
+	}
+	return handles;
+}
+
+TEST(RelocationTest, Trait)
+{
+	EXPECT_TRUE(is_trivially_relocatable<int>::value);
+	EXPECT_TRUE(is_trivially_relocatable<std::unique_ptr<int>>::value);
+	EXPECT_TRUE(is_trivially_relocatable<std::shared_ptr<int>>::value);
+	EXPECT_TRUE(is_trivially_relocatable<counted_handle>::value);
+	EXPECT_FALSE(is_trivially_relocatable<std::string>::value);
+}
+
+TEST(RelocationTest, RemoveAtDoesNotMoveElements)
+{
+	auto handles = make_handles(100);
+	counted_handle::reset_counters();
+	handles.remove_at(10);
+	EXPECT_EQ(0, counted_handle::moves);
+	EXPECT_EQ(0, counted_handle::copies);
+	EXPECT_EQ(99, handles.size());
+	EXPECT_EQ(9, handles[9].id);
+	EXPECT_EQ(11, handles[10].id);
+	EXPECT_EQ(99, *handles[98].resource);
+}
+
+TEST(RelocationTest, RemoveRangeDoesNotMoveElements)
+{
+	auto handles = make_handles(100);
+	counted_handle::reset_counters();
+	handles.remove_range(index_range::start_count(20, 30));
+	EXPECT_EQ(0, counted_handle::moves);
+	EXPECT_EQ(70, handles.size());
+	EXPECT_EQ(19, handles[19].id);
+	EXPECT_EQ(50, *handles[20].resource);
+}
+
+TEST(RelocationTest, InsertAtCopiesOnlyTheInsertedElement)
+{
+	auto handles = make_handles(100);
+	const counted_handle inserted(500);
+	counted_handle::reset_counters();
+	handles.insert_at(5, inserted);
+	EXPECT_EQ(1, counted_handle::copies);
+	EXPECT_EQ(0, counted_handle::moves);
+	EXPECT_EQ(101, handles.size());
+	EXPECT_EQ(4, handles[4].id);
+	EXPECT_EQ(500, *handles[5].resource);
+	EXPECT_EQ(5, *handles[6].resource);
+}
+
+TEST(RelocationTest, InsertOwnElement)
+{
+	auto handles = make_handles(10);
+	handles.insert_at(0, handles[9]);
+	EXPECT_EQ(11, handles.size());
+	EXPECT_EQ(9, *handles[0].resource);
+	EXPECT_EQ(9, *handles[10].resource);
+}
+
+TEST(RelocationTest, InsertRangeAndFront)
+{
+	auto handles = make_handles(10);
+	const auto inserted = make_handles(3);
+	counted_handle::reset_counters();
+	handles.insert_at(4, inserted).insert_front(inserted);
+	EXPECT_EQ(6, counted_handle::copies);
+	EXPECT_EQ(0, counted_handle::moves);
+	EXPECT_EQ(16, handles.size());
+	EXPECT_EQ(2, *handles[2].resource);
+	EXPECT_EQ(0, *handles[3].resource);
+	EXPECT_EQ(0, *handles[7].resource);
+	EXPECT_EQ(2, *handles[9].resource);
+	EXPECT_EQ(4, *handles[10].resource);
+}
+
+TEST(RelocationTest, InsertAtWithReallocation)
+{
+	vector<counted_handle> handles;
+	handles.insert_back(counted_handle(1)).insert_back(counted_handle(2));
+	for (int i = 0; i < 100; ++i) {
+		handles.insert_at(1, counted_handle(i + 10));
+	}
+	EXPECT_EQ(102, handles.size());
+	EXPECT_EQ(1, *handles[0].resource);
+	EXPECT_EQ(109, *handles[1].resource);
+	EXPECT_EQ(2, *handles[101].resource);
+}
+
+TEST(RelocationTest, UniquePointers)
+{
+	std::vector<std::unique_ptr<int>> pointers;
+	for (int i = 0; i < 5; ++i) {
+		pointers.push_back(std::unique_ptr<int>(new int(i)));
+	}
+	vector<std::unique_ptr<int>> vector_under_test(std::move(pointers));
+	vector_under_test.remove_at(1).remove_range(index_range::start_count(1, 2));
+	EXPECT_EQ(2, vector_under_test.size());
+	EXPECT_EQ(0, *vector_under_test[0]);
+	EXPECT_EQ(4, *vector_under_test[1]);
+}
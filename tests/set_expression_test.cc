@@ -0,0 +1,167 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include "warnings.h"
+#include "set_expression.h"
+#include "btree_set.h"
+#include "small_set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+typedef small_set<int, 4> small_set4;
+
+TEST(SetExpressionTest, Union)
+{
+	const set<int> a({1, 3, 5});
+	const set<int> b({2, 3, 4});
+	const set<int> result = a | b;
+	EXPECT_EQ(set<int>({1, 2, 3, 4, 5}), result);
+}
+
+TEST(SetExpressionTest, Intersection)
+{
+	const set<int> a({1, 3, 5, 7});
+	const set<int> b({3, 4, 5});
+	const set<int> result = a & b;
+	EXPECT_EQ(set<int>({3, 5}), result);
+}
+
+TEST(SetExpressionTest, Difference)
+{
+	const set<int> a({1, 3, 5, 7});
+	const set<int> b({3, 4, 5});
+	const set<int> result = a - b;
+	EXPECT_EQ(set<int>({1, 7}), result);
+}
+
+TEST(SetExpressionTest, SymmetricDifference)
+{
+	const set<int> a({1, 3, 5, 7});
+	const set<int> b({3, 4, 5});
+	const set<int> result = a ^ b;
+	EXPECT_EQ(set<int>({1, 4, 7}), result);
+}
+
+TEST(SetExpressionTest, NestedExpressionMatchesEagerOperations)
+{
+	const set<int> a({1, 2, 3, 4, 8});
+	const set<int> b({3, 4, 5, 9});
+	const set<int> c({2, 4, 5, 6, 8, 9});
+	const set<int> d({4, 9, 10});
+	const auto expression = ((a | b) & c) - d ^ (a & d);
+	const auto lhs = a.union_with(b).intersect_with(c).difference_with(d);
+	const auto rhs = a.intersect_with(d);
+	const auto expected = lhs.difference_with(rhs).union_with(rhs.difference_with(lhs));
+	EXPECT_EQ(expected, expression.evaluate());
+	EXPECT_EQ(expected.size(), expression.size());
+	for (auto key = 0; key <= 11; ++key) {
+		EXPECT_EQ(expected.contains(key), expression.contains(key));
+	}
+}
+
+TEST(SetExpressionTest, IsLazyUntilEvaluated)
+{
+	set<int> a({1, 2});
+	const set<int> b({2, 3});
+	const auto expression = a | b;
+	a = a.inserting(7);
+	EXPECT_EQ(set<int>({1, 2, 3, 7}), expression.evaluate());
+	EXPECT_TRUE(expression.contains(7));
+}
+
+TEST(SetExpressionTest, OwnsTemporaryOperands)
+{
+	const set<int> a({1, 2, 3});
+	const auto expression = a - set<int>({2, 3, 4});
+	EXPECT_EQ(set<int>({1}), expression.evaluate());
+}
+
+TEST(SetExpressionTest, Iteration)
+{
+	const set<int> a({5, 1, 9});
+	const set<int> b({4, 5, 2});
+	std::vector<int> keys;
+	for (const auto& key : a ^ b) {
+		keys.push_back(key);
+	}
+	EXPECT_EQ(std::vector<int>({1, 2, 4, 9}), keys);
+	EXPECT_EQ(vector<int>({1, 2, 4, 9}), (a ^ b).keys());
+}
+
+TEST(SetExpressionTest, ForEach)
+{
+	const set<int> a({1, 2, 3});
+	const set<int> b({2, 3, 4});
+	auto sum = 0;
+	(a & b).for_each([&sum](const int& key) {
+		sum += key;
+	});
+	EXPECT_EQ(5, sum);
+}
+
+TEST(SetExpressionTest, IsEmpty)
+{
+	const set<int> a({1, 2});
+	const set<int> b({3, 4});
+	const set<int> empty;
+	EXPECT_TRUE((a & b).is_empty());
+	EXPECT_FALSE((a | b).is_empty());
+	EXPECT_TRUE((empty | empty).is_empty());
+	EXPECT_EQ(0, (empty & a).size());
+}
+
+TEST(SetExpressionTest, MixedOperandTypes)
+{
+	const set<int> a({1, 2, 3, 4});
+	const std::set<int> b({3, 4, 5});
+	btree_set<int> c;
+	c.insert(4);
+	c.insert(5);
+	c.insert(6);
+	small_set4 d;
+	d.insert(5);
+	const set<int> result = (a | b) & c - d;
+	EXPECT_EQ(set<int>({4}), result);
+	EXPECT_TRUE(((a | b) & c).contains(5));
+}
+
+TEST(SetExpressionTest, CustomComparator)
+{
+	const set<person, person_comparator> a({person(51, "George"), person(81, "Jackie")});
+	const set<person, person_comparator> b({person(81, "Jackie"), person(15, "Jake")});
+	const set<person, person_comparator> result = a & b;
+	EXPECT_EQ(1, result.size());
+	EXPECT_TRUE(result.contains(person(81, "Jackie")));
+}
+
+TEST(SetExpressionTest, StringKeys)
+{
+	const set<std::string> a({"one", "two", "three"});
+	const set<std::string> b({"two", "four"});
+	const set<std::string> result = a - b;
+	EXPECT_EQ(set<std::string>({"one", "three"}), result);
+}
@@ -21,6 +21,8 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <string>
 #include "warnings.h"
 #include "set.h"
 #include "vector.h"
@@ -74,6 +76,34 @@ TEST(SetTest, StdInitializerListConstructor)
 	test_contents(set_under_test);
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(SetTest, FromParallel)
+{
+	test_contents(set<int>::from_parallel(vector<int>({1, 5, 3, 3})));
+	test_contents(set<int>::from_parallel(std::vector<int>({3, 1, 5, 3})));
+
+	std::vector<int> keys;
+	for (auto i = 0; i < 100000; ++i) {
+		keys.push_back((i * 7919) % 20000);
+	}
+	const auto set_under_test = set<int>::from_parallel(keys);
+	EXPECT_EQ(set<int>(keys), set_under_test);
+	EXPECT_EQ(20000, set_under_test.size());
+}
+
+TEST(SetTest, FromParallelCustomType)
+{
+	const auto persons = set<person, person_comparator>::from_parallel(vector<person>({
+		person(25, "Kate"),
+		person(15, "Jake"),
+		person(25, "Kate"),
+		person(62, "Bob")
+	}));
+	EXPECT_EQ(3, persons.size());
+	EXPECT_TRUE(persons.contains(person(15, "Jake")));
+}
+#endif
+
 TEST(SetTest, Subscripting)
 {
 	const set<int> set_under_test(std::set<int>({1, 5, 3, 3}));
@@ -313,6 +343,24 @@ TEST(SetTest, Map)
 	EXPECT_EQ(4, mapped_set[2].age);
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(SetTest, MapParallel)
+{
+	std::set<int> keys;
+	for (auto i = 0; i < 10000; ++i) {
+		keys.insert(i);
+	}
+	const set<int> numbers(keys);
+	const auto mapped_set = numbers.map_parallel<int>([](const int& number){
+		return (number * 7919) % 5000;
+	});
+	EXPECT_EQ(numbers.map<int>([](const int& number){
+		return (number * 7919) % 5000;
+	}), mapped_set);
+	EXPECT_EQ(5000, mapped_set.size());
+}
+#endif
+
 TEST(SetTest, AllOf)
 {
 	const set<int> numbers({1, 4, 2, 5, 8, 3});
@@ -334,6 +382,20 @@ TEST(SetTest, NoneOf)
 	EXPECT_FALSE(numbers.none_of([](const int &number) { return number < 6; }));
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(SetTest, AllAnyNoneOfParallel)
+{
+	const set<int> numbers({1, 4, 2, 5, 8, 3});
+	EXPECT_TRUE(numbers.all_of_parallel([](const int &number) { return number < 10; }));
+	EXPECT_FALSE(numbers.all_of_parallel([](const int &number) { return number > 2; }));
+	EXPECT_TRUE(numbers.any_of_parallel([](const int &number) { return number < 5; }));
+	EXPECT_FALSE(numbers.any_of_parallel([](const int &number) { return number > 10; }));
+	EXPECT_TRUE(numbers.none_of_parallel([](const int &number) { return number > 10; }));
+	EXPECT_FALSE(numbers.none_of_parallel([](const int &number) { return number < 6; }));
+	EXPECT_TRUE(set<int>().all_of_parallel([](const int &number) { return false; }));
+}
+#endif
+
 TEST(SetTest, Reduce)
 {
 	const set<std::string> tokens({"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "brown", "dog"});
@@ -345,6 +407,28 @@ TEST(SetTest, Reduce)
 	EXPECT_EQ("brown dog fox jumps lazy over quick the", sentence);
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(SetTest, ReduceParallel)
+{
+	const set<std::string> tokens({"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "brown", "dog"});
+	const auto join = [](const std::string& a, const std::string& b) {
+		return a.length() != 0 && b.length() != 0
+			       ? a + " " + b
+			       : a + b;
+	};
+	const auto sentence = tokens.reduce_parallel(std::string(""), join, join);
+	EXPECT_EQ("brown dog fox jumps lazy over quick the", sentence);
+
+	std::set<long> keys;
+	for (long i = 1; i <= 10000; ++i) {
+		keys.insert(i);
+	}
+	EXPECT_EQ(50005000L, set<long>(keys).reduce_parallel(0L,
+		[](const long& partial, const long& number) { return partial + number; },
+		[](const long& a, const long& b) { return a + b; }));
+}
+#endif
+
 TEST(SetTest, Filter)
 {
 	set<int> numbers({1, 3, -5, 2, -1, 9, -4});
@@ -364,6 +448,37 @@ TEST(SetTest, Filtered)
 	EXPECT_EQ(set<int>({ 1, 3, -5, 2, -1, 9, -4 }), numbers);
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(SetTest, FilterParallel)
+{
+	std::set<int> keys;
+	for (auto i = 0; i < 10000; ++i) {
+		keys.insert(i);
+	}
+	set<int> numbers(keys);
+	const auto is_even = [](const int& number){
+		return number % 2 == 0;
+	};
+	const auto filtered_numbers = numbers.filtered_parallel(is_even);
+	EXPECT_EQ(numbers.filtered(is_even), filtered_numbers);
+	EXPECT_EQ(10000, numbers.size());
+
+	numbers.filter_parallel(is_even);
+	EXPECT_EQ(filtered_numbers, numbers);
+	EXPECT_EQ(5000, numbers.size());
+}
+
+TEST(SetTest, ForEachParallel)
+{
+	const set<int> numbers({1, 4, 2, 5, 8, 3});
+	std::atomic<int> sum(0);
+	numbers.for_each_parallel([&sum](const int& number) {
+		sum += number;
+	});
+	EXPECT_EQ(23, sum);
+}
+#endif
+
 TEST(SetTest, ZipWithFunctionalSet)
 {
 	const set<int> ages({25, 45, 30, 63});
@@ -484,6 +599,40 @@ TEST(SetTest, InsertNewElement)
 	EXPECT_EQ(set<int>({1, 2, 4, 18}), numbers);
 }
 
+TEST(SetTest, InsertRange)
+{
+	set<int> numbers({1, 4, 2});
+	const std::vector<int> batch({18, 3, 4, 7, 3});
+	numbers.insert_range(batch.begin(), batch.end());
+	EXPECT_EQ(set<int>({1, 2, 3, 4, 7, 18}), numbers);
+}
+
+TEST(SetTest, InsertFunctionalVector)
+{
+	set<int> numbers({1, 4, 2});
+	numbers.insert(vector<int>({18, 3, 4, 7}));
+	EXPECT_EQ(set<int>({1, 2, 3, 4, 7, 18}), numbers);
+}
+
+TEST(SetTest, InsertStdVector)
+{
+	set<int> numbers;
+	numbers.insert(std::vector<int>({18, 3, 4, 7}));
+	EXPECT_EQ(set<int>({3, 4, 7, 18}), numbers);
+}
+
+TEST(SetTest, InsertLargeBatchCustomType)
+{
+	set<person, person_comparator> persons({person(15, "Jake")});
+	std::vector<person> batch;
+	for (auto i = 0; i < 1000; ++i) {
+		batch.push_back(person(i % 100, "Jake"));
+	}
+	persons.insert(batch);
+	EXPECT_EQ(100, persons.size());
+	EXPECT_TRUE(persons.contains(person(99, "Jake")));
+}
+
 TEST(SetTest, InsertingNewElement)
 {
 	const set<int> numbers({1, 4, 2});
@@ -536,6 +685,25 @@ TEST(SetTest, Contains)
 	EXPECT_FALSE(numbers.contains(15));
 }
 
+TEST(SetTest, ContainsAll)
+{
+	const set<int> numbers({1, 4, 2});
+	const auto found = numbers.contains_all(vector<int>({4, 15, 1, 0, 4}));
+	EXPECT_EQ(std::vector<bool>({true, false, true, false, true}), found);
+	EXPECT_TRUE(numbers.contains_all(std::vector<int>()).empty());
+}
+
+TEST(SetTest, ContainsAllSmallBatchLargeSet)
+{
+	std::vector<int> keys;
+	for (auto i = 0; i < 1000; i += 2) {
+		keys.push_back(i);
+	}
+	const set<int> numbers(keys);
+	const auto found = numbers.contains_all(std::vector<int>({998, 3, 0, 1001}));
+	EXPECT_EQ(std::vector<bool>({true, false, true, false}), found);
+}
+
 TEST(SetTest, EqualityOperator)
 {
 	const set<int> set1(std::set<int>({1, 2, 3}));
@@ -569,3 +737,4 @@ TEST(SetTest, EqualityOperatorCustomType)
 	EXPECT_TRUE(set1 == set2);
 	EXPECT_FALSE(set1 != set2);
 }
+
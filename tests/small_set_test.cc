@@ -0,0 +1,236 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include "warnings.h"
+#include "small_set.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+typedef small_set<int, 4> small_set4;
+typedef small_set<std::string, 2> string_set2;
+
+// Orders ascending or descending, so that a copied comparison is distinguishable from a default one
+struct directed_less
+{
+	bool descending = false;
+
+	bool operator()(const int& a, const int& b) const
+	{
+		return descending ? b < a : a < b;
+	}
+};
+
+TEST(SmallSetTest, EmptyConstructor)
+{
+	const small_set<int> set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_TRUE(set_under_test.is_inline());
+	EXPECT_FALSE(set_under_test.min().has_value());
+}
+
+TEST(SmallSetTest, ConstructorRemovesDuplicatesAndSorts)
+{
+	const small_set4 set_under_test({1, 5, 3, 3, 1});
+	EXPECT_EQ(3, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_inline());
+	EXPECT_EQ(1, set_under_test[0]);
+	EXPECT_EQ(3, set_under_test[1]);
+	EXPECT_EQ(5, set_under_test[2]);
+}
+
+TEST(SmallSetTest, ConstructorAboveCapacityUsesTree)
+{
+	const small_set4 set_under_test({1, 5, 3, 8, 2});
+	EXPECT_FALSE(set_under_test.is_inline());
+	EXPECT_EQ(small_set4({1, 2, 3, 5, 8}), set_under_test);
+}
+
+TEST(SmallSetTest, InsertMovesToTreeWhenFull)
+{
+	small_set4 numbers({4, 1, 3});
+	numbers.insert(2).insert(2);
+	EXPECT_TRUE(numbers.is_inline());
+	EXPECT_EQ(4, numbers.size());
+
+	numbers.insert(0);
+	EXPECT_FALSE(numbers.is_inline());
+	EXPECT_EQ(5, numbers.size());
+	EXPECT_TRUE(numbers.contains(0));
+	EXPECT_TRUE(numbers.contains(4));
+	EXPECT_EQ(vector<int>({0, 1, 2, 3, 4}), numbers.keys());
+}
+
+TEST(SmallSetTest, RemoveMovesInlineWhenSmall)
+{
+	small_set4 numbers({1, 2, 3, 4, 5});
+	numbers.remove(5).remove(4);
+	EXPECT_FALSE(numbers.is_inline());
+	numbers.remove(3);
+	EXPECT_TRUE(numbers.is_inline());
+	EXPECT_EQ(small_set4({1, 2}), numbers);
+
+	numbers.remove(1).remove(7);
+	EXPECT_EQ(small_set4({2}), numbers);
+}
+
+TEST(SmallSetTest, MatchesStdSet)
+{
+	std::set<int> expected;
+	small_set<int, 8> set_under_test;
+	for (auto i = 0; i < 2000; ++i) {
+		const auto key = (i * 37) % 23;
+		if (i % 3 == 2) {
+			expected.erase(key);
+			set_under_test.remove(key);
+		} else {
+			expected.insert(key);
+			set_under_test.insert(key);
+		}
+		EXPECT_EQ(expected.size(), set_under_test.size());
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), set_under_test.begin()));
+	}
+}
+
+TEST(SmallSetTest, ConstructorKeepsTheComparisonOfTheSet)
+{
+	directed_less descending;
+	descending.descending = true;
+	std::set<int, directed_less> keys(descending);
+	keys.insert({1, 5, 3});
+	const set<int, directed_less> fcpp_keys(keys);
+
+	small_set<int, 4, directed_less> inline_set(fcpp_keys);
+	EXPECT_TRUE(inline_set.is_inline());
+	inline_set.insert(4);
+	EXPECT_EQ(vector<int>({5, 4, 3, 1}), inline_set.keys());
+
+	small_set<int, 2, directed_less> tree_set(fcpp_keys);
+	EXPECT_FALSE(tree_set.is_inline());
+	tree_set.insert(4);
+	EXPECT_EQ(vector<int>({5, 4, 3, 1}), tree_set.keys());
+}
+
+TEST(SmallSetTest, CustomType)
+{
+	small_set<person, 2, person_comparator> persons({person(15, "Jake"), person(18, "Jannet")});
+	persons.insert(person(25, "Kate"));
+	EXPECT_FALSE(persons.is_inline());
+	EXPECT_TRUE(persons.contains(person(25, "Kate")));
+	persons.remove(person(25, "Kate")).remove(person(18, "Jannet"));
+	EXPECT_TRUE(persons.is_inline());
+	EXPECT_TRUE(persons.contains(person(15, "Jake")));
+}
+
+TEST(SmallSetTest, CopyAndMove)
+{
+	string_set2 original({"a", "b"});
+	auto copy(original);
+	copy.insert("c");
+	EXPECT_EQ(2, original.size());
+	EXPECT_EQ(3, copy.size());
+
+	auto moved(std::move(copy));
+	EXPECT_EQ(string_set2({"a", "b", "c"}), moved);
+
+	original = moved;
+	EXPECT_EQ(moved, original);
+	original = string_set2({"z"});
+	EXPECT_EQ(string_set2({"z"}), original);
+}
+
+TEST(SmallSetTest, SetAlgebra)
+{
+	const small_set<int> set1({1, 2, 3, 5, 7, 8, 10});
+	const small_set<int> set2({2, 5, 7, 10, 15, 17});
+	EXPECT_EQ(small_set<int>({1, 3, 8}), set1.difference_with(set2));
+	EXPECT_EQ(small_set<int>({1, 2, 3, 5, 7, 8, 10, 15, 17}), set1.union_with(set2));
+	EXPECT_EQ(small_set<int>({2, 5, 7, 10}), set1.intersect_with(std::set<int>({2, 5, 7, 10, 15, 17})));
+}
+
+TEST(SmallSetTest, MinMax)
+{
+	const small_set<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+	EXPECT_EQ(1, numbers.min().value());
+	EXPECT_EQ(8, numbers.max().value());
+	const small_set<int, 2> large_numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+	EXPECT_EQ(1, large_numbers.min().value());
+	EXPECT_EQ(8, large_numbers.max().value());
+}
+
+TEST(SmallSetTest, FunctionalApi)
+{
+	small_set<int> numbers({1, 3, -5, 2});
+	EXPECT_EQ(small_set<std::string>({"-5", "1", "2", "3"}), numbers.map<std::string>([](const int& number) {
+		return std::to_string(number);
+	}));
+	EXPECT_TRUE(numbers.all_of([](const int& number) { return number < 10; }));
+	EXPECT_TRUE(numbers.any_of([](const int& number) { return number == 2; }));
+	EXPECT_TRUE(numbers.none_of([](const int& number) { return number > 10; }));
+	EXPECT_EQ(1, numbers.reduce(0, [](const int& partial, const int& number) {
+		return partial + number;
+	}));
+	EXPECT_EQ(small_set<int>({2, 3}), numbers.filtered([](const int& number) { return number >= 2; }));
+	numbers.filter([](const int& number) { return number < 0; });
+	EXPECT_EQ(small_set<int>({-5}), numbers);
+}
+
+TEST(SmallSetTest, Zip)
+{
+	const small_set<int> ages({25, 45, 30, 63});
+	const small_set<std::string> names({"Jake", "Bob", "Michael", "Philipp"});
+	const auto zipped = ages.zip(names);
+	EXPECT_EQ(4, zipped.size());
+	EXPECT_EQ(std::make_pair(25, std::string("Bob")), zipped[0]);
+	EXPECT_EQ(std::make_pair(63, std::string("Philipp")), zipped[3]);
+}
+
+TEST(SmallSetTest, InsertBatch)
+{
+	small_set4 numbers({1, 4, 2});
+	numbers.insert(vector<int>({18, 3, 4, 7}));
+	EXPECT_FALSE(numbers.is_inline());
+	EXPECT_EQ(small_set4({1, 2, 3, 4, 7, 18}), numbers);
+	EXPECT_EQ(std::vector<bool>({true, false, true}), numbers.contains_all(std::vector<int>({4, 15, 1})));
+	EXPECT_TRUE(numbers.clear().is_inline());
+	EXPECT_TRUE(numbers.is_empty());
+}
+
+TEST(SmallSetTest, InsertBatchStaysInlineOrGoesToTree)
+{
+	small_set4 numbers({3});
+	numbers.insert(std::vector<int>({1, 3, 1, 2}));
+	EXPECT_TRUE(numbers.is_inline());
+	EXPECT_EQ(small_set4({1, 2, 3}), numbers);
+
+	numbers.insert(std::vector<int>({9, 0, 5, 9}));
+	EXPECT_FALSE(numbers.is_inline());
+	EXPECT_EQ(vector<int>({0, 1, 2, 3, 5, 9}), numbers.keys());
+
+	numbers.insert(std::vector<int>({4, 9, -1}));
+	EXPECT_EQ(vector<int>({-1, 0, 1, 2, 3, 4, 5, 9}), numbers.keys());
+}
@@ -83,3 +83,9 @@ struct person_comparator {
         return a < b;
     }
 };
+
+struct person_hash {
+    std::size_t operator() (const person& p) const {
+        return p.hash();
+    }
+};
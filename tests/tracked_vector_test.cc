@@ -0,0 +1,276 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "warnings.h"
+#include "tracked_vector.h"
+#include "test_types.h"
+
+using namespace fcpp;
+
+TEST(TrackedVectorTest, EmptyConstructor)
+{
+	tracked_vector<int> vector_under_test;
+	const auto sum = vector_under_test.track_sum();
+	const auto smallest = vector_under_test.track_min();
+	const auto all_positive = vector_under_test.track_all_of([](const int& x) { return x > 0; });
+	const auto any_positive = vector_under_test.track_any_of([](const int& x) { return x > 0; });
+	EXPECT_TRUE(vector_under_test.is_empty());
+	EXPECT_EQ(0, sum.value());
+	EXPECT_FALSE(smallest.value().has_value());
+	EXPECT_TRUE(all_positive.value());
+	EXPECT_FALSE(any_positive.value());
+}
+
+TEST(TrackedVectorTest, AggregatesOfInitialValues)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5 }));
+	EXPECT_EQ(12, vector_under_test.track_sum().value());
+	EXPECT_EQ(2, vector_under_test.track_count_if([](const int& x) { return x % 2 == 0; }).value());
+	EXPECT_EQ(1, vector_under_test.track_min().value().value());
+	EXPECT_EQ(5, vector_under_test.track_max().value().value());
+	EXPECT_TRUE(vector_under_test.track_all_of([](const int& x) { return x > 0; }).value());
+}
+
+TEST(TrackedVectorTest, InsertUpdatesAggregates)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	const auto sum = vector_under_test.track_sum();
+	const auto largest = vector_under_test.track_max();
+	const auto all_positive = vector_under_test.track_all_of([](const int& x) { return x > 0; });
+	vector_under_test.insert_back(7).insert_front(-3).insert_at(2, vector<int>({ 10, 11 }));
+	EXPECT_EQ(vector<int>({ -3, 1, 10, 11, 4, 2, 7 }), vector_under_test.values());
+	EXPECT_EQ(32, sum.value());
+	EXPECT_EQ(11, largest.value().value());
+	EXPECT_FALSE(all_positive.value());
+}
+
+TEST(TrackedVectorTest, RemoveUpdatesAggregates)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5, 8, 3 }));
+	const auto sum = vector_under_test.track_sum();
+	const auto smallest = vector_under_test.track_min();
+	const auto largest = vector_under_test.track_max();
+	vector_under_test.remove_front().remove_back().remove_range(index_range::start_count(2, 2));
+	EXPECT_EQ(vector<int>({ 4, 2 }), vector_under_test.values());
+	EXPECT_EQ(6, sum.value());
+	EXPECT_EQ(2, smallest.value().value());
+	EXPECT_EQ(4, largest.value().value());
+	vector_under_test.remove_at(0).remove_at(0).remove_back();
+	EXPECT_EQ(0, sum.value());
+	EXPECT_FALSE(largest.value().has_value());
+}
+
+TEST(TrackedVectorTest, ReplaceAndFillUpdateAggregates)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5 }));
+	const auto sum = vector_under_test.track_sum();
+	const auto evens = vector_under_test.track_count_if([](const int& x) { return x % 2 == 0; });
+	const auto smallest = vector_under_test.track_min();
+	vector_under_test.replace_range_at(1, { 9, 6 });
+	EXPECT_EQ(vector<int>({ 1, 9, 6, 5 }), vector_under_test.values());
+	EXPECT_EQ(21, sum.value());
+	EXPECT_EQ(1, evens.value());
+	vector_under_test.fill(8);
+	EXPECT_EQ(32, sum.value());
+	EXPECT_EQ(4, evens.value());
+	EXPECT_EQ(8, smallest.value().value());
+}
+
+TEST(TrackedVectorTest, ClearResetsAggregates)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	const auto sum = vector_under_test.track_sum();
+	const auto any_even = vector_under_test.track_any_of([](const int& x) { return x % 2 == 0; });
+	vector_under_test.clear();
+	EXPECT_EQ(0, sum.value());
+	EXPECT_FALSE(any_even.value());
+	vector_under_test.insert_back({ 3, 6 });
+	EXPECT_EQ(9, sum.value());
+	EXPECT_TRUE(any_even.value());
+}
+
+TEST(TrackedVectorTest, CustomFold)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	const auto squares = vector_under_test.track_fold(0, [](int sum, const int& x) {
+		return sum + x * x;
+	}, [](int sum, const int& x) {
+		return sum - x * x;
+	});
+	EXPECT_EQ(21, squares.value());
+	vector_under_test.remove_at(1).insert_back(3);
+	EXPECT_EQ(14, squares.value());
+}
+
+TEST(TrackedVectorTest, MaxWithCustomComparator)
+{
+	tracked_vector<person> vector_under_test(vector<person>({ person(15, "Jake"), person(18, "Jannet") }));
+	const auto oldest = vector_under_test.track_max([](const person& a, const person& b) {
+		return a.age < b.age;
+	});
+	EXPECT_EQ("Jannet", oldest.value().value().name);
+	vector_under_test.insert_back(person(30, "Kate"));
+	EXPECT_EQ("Kate", oldest.value().value().name);
+	vector_under_test.remove_back().remove_back();
+	EXPECT_EQ("Jake", oldest.value().value().name);
+}
+
+TEST(TrackedVectorTest, MinRemovesTheChangedElementAmongEquivalents)
+{
+	tracked_vector<person> vector_under_test(vector<person>({ person(30, "Alice"), person(30, "Bob"), person(40, "Carol") }));
+	const auto youngest = vector_under_test.track_min([](const person& a, const person& b) {
+		return a.age < b.age;
+	});
+	vector_under_test.remove_at(1);
+	EXPECT_EQ("Alice", youngest.value().value().name);
+	vector_under_test.replace_range_at(0, { person(50, "Dave") });
+	EXPECT_EQ("Carol", youngest.value().value().name);
+}
+
+TEST(TrackedVectorTest, DestroyedAggregateIsDropped)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2 }));
+	{
+		const auto sum = vector_under_test.track_sum();
+		EXPECT_EQ(7, sum.value());
+	}
+	const auto sum = vector_under_test.track_sum();
+	vector_under_test.insert_back(3);
+	EXPECT_EQ(10, sum.value());
+}
+
+TEST(TrackedVectorTest, AggregateOutlivesVector)
+{
+	std::unique_ptr<tracked_vector<int>> vector_under_test(new tracked_vector<int>(vector<int>({ 1, 4, 2 })));
+	const auto sum = vector_under_test->track_sum();
+	vector_under_test.reset();
+	EXPECT_EQ(7, sum.value());
+}
+
+TEST(TrackedVectorTest, FilteredViewOfInitialValues)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5, 8 }));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	EXPECT_EQ(vector<int>({ 4, 2, 8 }), evens.values());
+	EXPECT_EQ(3, evens.size());
+	EXPECT_EQ(2, evens[1]);
+}
+
+TEST(TrackedVectorTest, FilteredViewInsert)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5 }));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	vector_under_test.insert_back(6).insert_front(10).insert_at(3, vector<int>({ 7, 12, 14 }));
+	EXPECT_EQ(vector<int>({ 10, 1, 4, 7, 12, 14, 2, 5, 6 }), vector_under_test.values());
+	EXPECT_EQ(vector<int>({ 10, 4, 12, 14, 2, 6 }), evens.values());
+}
+
+TEST(TrackedVectorTest, FilteredViewRemove)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 2, 1, 4, 6, 5, 8, 10 }));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	vector_under_test.remove_range(index_range::start_count(1, 3)).remove_back();
+	EXPECT_EQ(vector<int>({ 2, 5, 8 }), vector_under_test.values());
+	EXPECT_EQ(vector<int>({ 2, 8 }), evens.values());
+	vector_under_test.remove_front().insert_at(1, 4);
+	EXPECT_EQ(vector<int>({ 4, 8 }), evens.values());
+	vector_under_test.clear();
+	EXPECT_TRUE(evens.is_empty());
+}
+
+TEST(TrackedVectorTest, FilteredViewReplace)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 1, 4, 2, 5 }));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	vector_under_test.replace_range_at(0, { 6, 3, 8, 7 });
+	EXPECT_EQ(vector<int>({ 6, 8 }), evens.values());
+	vector_under_test.insert_back(1);
+	vector_under_test.fill(2);
+	EXPECT_EQ(vector<int>({ 2, 2, 2, 2, 2 }), evens.values());
+}
+
+TEST(TrackedVectorTest, FilteredViewReplaceChangesMatchingCount)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 2, 1, 4, 3, 6, 5 }));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	vector_under_test.replace_range_at(1, { 8, 10, 12 });
+	EXPECT_EQ(vector<int>({ 2, 8, 10, 12, 6 }), evens.values());
+	vector_under_test.replace_range_at(0, { 1, 3, 5 });
+	EXPECT_EQ(vector<int>({ 12, 6 }), evens.values());
+	vector_under_test.insert_back(14);
+	EXPECT_EQ(vector<int>({ 12, 6, 14 }), evens.values());
+}
+
+TEST(TrackedVectorTest, FillLargeVectorWithViews)
+{
+	const size_t count = 200000;
+	std::vector<int> values;
+	for (size_t i = 0; i < count; ++i) {
+		values.push_back(static_cast<int>(i));
+	}
+	tracked_vector<int> vector_under_test((vector<int>(values)));
+	const auto evens = vector_under_test.track_filtered([](const int& x) { return x % 2 == 0; });
+	const auto ascending = vector_under_test.track_sorted();
+	const auto sum = vector_under_test.track_sum();
+
+	// one pass per view, a replacement per element would take quadratic time
+	vector_under_test.fill(4);
+	EXPECT_EQ(count, evens.size());
+	EXPECT_EQ(4, evens.values()[count - 1]);
+	EXPECT_EQ(count, ascending.size());
+	EXPECT_EQ(static_cast<int>(4 * count), sum.value());
+
+	vector_under_test.fill(1);
+	EXPECT_TRUE(evens.is_empty());
+}
+
+TEST(TrackedVectorTest, SortedView)
+{
+	tracked_vector<int> vector_under_test(vector<int>({ 5, 1, 4 }));
+	const auto ascending = vector_under_test.track_sorted();
+	EXPECT_EQ(vector<int>({ 1, 4, 5 }), ascending.values());
+	vector_under_test.insert_back({ 3, 9 }).insert_front(0);
+	EXPECT_EQ(vector<int>({ 0, 1, 3, 4, 5, 9 }), ascending.values());
+	vector_under_test.remove_at(1).replace_range_at(0, { 7 });
+	EXPECT_EQ(vector<int>({ 7, 1, 4, 3, 9 }), vector_under_test.values());
+	EXPECT_EQ(vector<int>({ 1, 3, 4, 7, 9 }), ascending.values());
+	EXPECT_EQ(1, *ascending.begin());
+	vector_under_test.clear();
+	EXPECT_TRUE(ascending.is_empty());
+}
+
+TEST(TrackedVectorTest, SortedViewRemovesTheChangedElementAmongEquivalents)
+{
+	tracked_vector<person> vector_under_test(vector<person>({ person(15, "Jake"), person(18, "Jannet"), person(15, "Kate") }));
+	const auto by_age = vector_under_test.track_sorted([](const person& a, const person& b) {
+		return a.age < b.age;
+	});
+	vector_under_test.remove_at(2);
+	EXPECT_EQ(2, by_age.size());
+	EXPECT_EQ("Jake", by_age.begin()->name);
+	vector_under_test.replace_range_at(0, { person(20, "Anna") });
+	EXPECT_EQ("Jannet", by_age.begin()->name);
+	EXPECT_EQ("Anna", (++by_age.begin())->name);
+}
@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2023 Ioannis Kaliakatsos
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "warnings.h"
+#include "trie_set.h"
+
+using namespace fcpp;
+
+TEST(TrieSetTest, EmptyConstructor)
+{
+	const trie_set set_under_test;
+	EXPECT_EQ(0, set_under_test.size());
+	EXPECT_TRUE(set_under_test.is_empty());
+	EXPECT_TRUE(set_under_test.begin() == set_under_test.end());
+	EXPECT_FALSE(set_under_test.contains(""));
+	EXPECT_FALSE(set_under_test.min().has_value());
+	EXPECT_FALSE(set_under_test.max().has_value());
+}
+
+TEST(TrieSetTest, InsertAndContains)
+{
+	trie_set words;
+	words.insert("test").insert("team").insert("tea").insert("te").insert("test");
+	EXPECT_EQ(4, words.size());
+	EXPECT_TRUE(words.contains("te"));
+	EXPECT_TRUE(words.contains("tea"));
+	EXPECT_TRUE(words.contains("team"));
+	EXPECT_TRUE(words.contains("test"));
+	EXPECT_FALSE(words.contains("t"));
+	EXPECT_FALSE(words.contains("tes"));
+	EXPECT_FALSE(words.contains("teams"));
+	EXPECT_FALSE(words.contains(""));
+}
+
+TEST(TrieSetTest, OrderedIteration)
+{
+	const trie_set words({"b", "abc", "ab", "", "abd", "a", "ba"});
+	EXPECT_EQ(vector<std::string>({"", "a", "ab", "abc", "abd", "b", "ba"}), words.keys());
+	EXPECT_EQ("", words.min().value());
+	EXPECT_EQ("ba", words.max().value());
+}
+
+TEST(TrieSetTest, RemoveKeepsOtherKeys)
+{
+	trie_set words({"romane", "romanus", "romulus", "rubens", "ruber", "rubicon", "rubicundus"});
+	words.remove("romanus").remove("rubicon").remove("rub").remove("rubiconus");
+	EXPECT_EQ(vector<std::string>({"romane", "romulus", "rubens", "ruber", "rubicundus"}), words.keys());
+	words.remove("romane").remove("romulus");
+	EXPECT_EQ(vector<std::string>({"rubens", "ruber", "rubicundus"}), words.keys());
+	EXPECT_FALSE(words.contains("rom"));
+}
+
+TEST(TrieSetTest, MatchesStdSet)
+{
+	std::mt19937 generator(3);
+	std::uniform_int_distribution<int> length_distribution(0, 6);
+	std::uniform_int_distribution<int> char_distribution(0, 3);
+	std::set<std::string> expected;
+	trie_set set_under_test;
+	for (auto i = 0; i < 20000; ++i) {
+		std::string key;
+		const auto length = length_distribution(generator);
+		for (auto j = 0; j < length; ++j) {
+			key.push_back(static_cast<char>('a' + char_distribution(generator)));
+		}
+		if (i % 3 == 2) {
+			expected.erase(key);
+			set_under_test.remove(key);
+		} else {
+			expected.insert(key);
+			set_under_test.insert(key);
+		}
+	}
+	EXPECT_EQ(expected.size(), set_under_test.size());
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), set_under_test.begin()));
+}
+
+TEST(TrieSetTest, WithPrefix)
+{
+	const trie_set paths({"/usr/bin", "/usr/lib", "/usr/lib64", "/var/log", "/usr"});
+	EXPECT_EQ(vector<std::string>({"/usr/bin", "/usr/lib", "/usr/lib64"}), paths.with_prefix("/usr/").keys());
+	EXPECT_EQ(vector<std::string>({"/usr", "/usr/bin", "/usr/lib", "/usr/lib64"}), paths.with_prefix("/us").keys());
+	EXPECT_EQ(vector<std::string>({"/usr/lib", "/usr/lib64"}), paths.with_prefix("/usr/lib").keys());
+	EXPECT_EQ(5, paths.with_prefix("").size());
+	EXPECT_TRUE(paths.with_prefix("/opt").is_empty());
+	EXPECT_TRUE(paths.with_prefix("/usr/bins").is_empty());
+
+	auto count = 0;
+	paths.with_prefix("/v").for_each([&count](const std::string& path) {
+		EXPECT_EQ("/var/log", path);
+		++count;
+	});
+	EXPECT_EQ(1, count);
+}
+
+TEST(TrieSetTest, LongestPrefixMatch)
+{
+	const trie_set routes({"/api", "/api/users", "/api/orders", "/static"});
+	EXPECT_EQ("/api/users", routes.longest_prefix_match("/api/users/15").value());
+	EXPECT_EQ("/api", routes.longest_prefix_match("/apis").value());
+	EXPECT_EQ("/api", routes.longest_prefix_match("/api/user").value());
+	EXPECT_FALSE(routes.longest_prefix_match("/ap").has_value());
+	EXPECT_FALSE(routes.longest_prefix_match("static").has_value());
+	EXPECT_EQ("", trie_set({""}).longest_prefix_match("abc").value());
+}
+
+TEST(TrieSetTest, SetAlgebra)
+{
+	const trie_set set1({"a", "b", "c"});
+	const trie_set set2({"b", "c", "d"});
+	EXPECT_EQ(trie_set({"a"}), set1.difference_with(set2));
+	EXPECT_EQ(trie_set({"a", "b", "c", "d"}), set1.union_with(set2));
+	EXPECT_EQ(trie_set({"b", "c"}), set1.intersect_with(std::set<std::string>({"b", "c", "d"})));
+}
+
+TEST(TrieSetTest, FunctionalApi)
+{
+	trie_set words({"apple", "avocado", "banana"});
+	EXPECT_EQ(set<size_t>({5, 6, 7}), words.map<size_t>([](const std::string& word) {
+		return word.size();
+	}));
+	EXPECT_TRUE(words.all_of([](const std::string& word) { return word.size() > 4; }));
+	EXPECT_TRUE(words.any_of([](const std::string& word) { return word == "banana"; }));
+	EXPECT_TRUE(words.none_of([](const std::string& word) { return word.empty(); }));
+	EXPECT_EQ("apple avocado banana", words.reduce<std::string>("", [](const std::string& partial, const std::string& word) {
+		return partial.length() != 0
+			? partial + " " + word
+			: word;
+	}));
+	EXPECT_EQ(trie_set({"avocado", "banana"}), words.filtered([](const std::string& word) { return word.size() > 5; }));
+	words.filter([](const std::string& word) { return word[0] == 'a'; });
+	EXPECT_EQ(trie_set({"apple", "avocado"}), words);
+}
+
+TEST(TrieSetTest, CopyMoveInsertingRemoving)
+{
+	const trie_set words({"one", "two"});
+	EXPECT_EQ(trie_set({"one", "three", "two"}), words.inserting("three"));
+	EXPECT_EQ(trie_set({"two"}), words.removing("one"));
+	EXPECT_EQ(2, words.size());
+
+	auto copy(words);
+	auto moved(std::move(copy));
+	EXPECT_EQ(words, moved);
+	EXPECT_TRUE(copy.is_empty());
+	EXPECT_TRUE(moved.clear().is_empty());
+}
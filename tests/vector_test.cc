@@ -21,6 +21,10 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
 #include "vector.h"
 #include "set.h"
 #include "index_range.h"
@@ -1352,6 +1356,15 @@ TEST(VectorTest, Distinct)
 	EXPECT_EQ(set<int>({1, 2, 3, 4, 5, 7, 8}), unique_numbers);
 }
 
+#ifdef PARALLEL_ALGORITHM_AVAILABLE
+TEST(VectorTest, DistinctParallel)
+{
+	const vector<int> numbers({1, 4, 2, 5, 8, 3, 1, 7, 1});
+	const auto& unique_numbers = numbers.distinct_parallel();
+	EXPECT_EQ(set<int>({1, 2, 3, 4, 5, 7, 8}), unique_numbers);
+}
+#endif
+
 TEST(VectorTest, DistinctCustomType)
 {
 	const vector<person> persons({